@@ -28,6 +28,7 @@
 #include <openrct2/platform/platform.h>
 #include <openrct2/rct2/T6Exporter.h>
 #include <openrct2/ride/TrackDesign.h>
+#include <openrct2/scenario/ParkMetadataRepository.h>
 #include <openrct2/scenario/Scenario.h>
 #include <openrct2/title/TitleScreen.h>
 #include <openrct2/util/Util.h>
@@ -142,6 +143,7 @@ struct LoadSaveListItem
     std::string time_formatted;
     uint8_t type;
     bool loaded;
+    ParkMetadata metadata;
 };
 
 static loadsave_callback _loadSaveCallback;
@@ -158,6 +160,9 @@ static int32_t _type;
 static int32_t maxDateWidth = 0;
 static int32_t maxTimeWidth = 0;
 
+// Height of the park details shown below the file list
+static constexpr int32_t PARK_METADATA_HEIGHT = 22;
+
 static void window_loadsave_populate_list(rct_window* w, int32_t includeNewItem, const char* directory, const char* extension);
 static void window_loadsave_select(rct_window* w, const char* path);
 static void window_loadsave_sort_list();
@@ -658,6 +663,19 @@ static void window_loadsave_compute_max_date_width()
     maxTimeWidth = gfx_get_string_width(time.c_str());
 }
 
+static bool window_loadsave_shows_park_metadata()
+{
+    switch (_type & 0x0E)
+    {
+        case LOADSAVETYPE_GAME:
+        case LOADSAVETYPE_LANDSCAPE:
+        case LOADSAVETYPE_SCENARIO:
+            return true;
+        default:
+            return false;
+    }
+}
+
 static void window_loadsave_invalidate(rct_window* w)
 {
     window_loadsave_widgets[WIDX_TITLE].right = w->width - 2;
@@ -678,6 +696,10 @@ static void window_loadsave_invalidate(rct_window* w)
 
     window_loadsave_widgets[WIDX_SCROLL].right = w->width - 4;
     window_loadsave_widgets[WIDX_SCROLL].bottom = w->height - 30;
+    if (window_loadsave_shows_park_metadata())
+    {
+        window_loadsave_widgets[WIDX_SCROLL].bottom -= PARK_METADATA_HEIGHT;
+    }
 
     window_loadsave_widgets[WIDX_BROWSE].top = w->height - 24;
     window_loadsave_widgets[WIDX_BROWSE].bottom = w->height - 6;
@@ -725,6 +747,35 @@ static void window_loadsave_paint(rct_window* w, rct_drawpixelinfo* dpi)
 
     rct_widget sort_date_widget = window_loadsave_widgets[WIDX_SORT_DATE];
     gfx_draw_string_left(dpi, STR_DATE, &id, COLOUR_GREY, w->x + sort_date_widget.left + 5, w->y + sort_date_widget.top + 1);
+
+    // Draw details of the park under the cursor
+    if (window_loadsave_shows_park_metadata() && w->selected_list_item >= 0
+        && w->selected_list_item < static_cast<int16_t>(_listItems.size()))
+    {
+        const auto& metadata = _listItems[w->selected_list_item].metadata;
+        if (metadata.Valid)
+        {
+            int32_t x = w->x + 4;
+            int32_t y = w->y + window_loadsave_widgets[WIDX_SCROLL].bottom + 3;
+            int32_t columnWidth = (w->width - 8) / 2;
+
+            set_format_arg(0, const char*, metadata.Name.c_str());
+            gfx_draw_string_left_clipped(dpi, STR_STRING, gCommonFormatArgs, COLOUR_BLACK, x, y, columnWidth - 4);
+            set_format_arg(0, uint16_t, metadata.ElapsedMonths);
+            gfx_draw_string_left(dpi, STR_WINDOW_OBJECTIVE_VALUE_DATE, gCommonFormatArgs, COLOUR_BLACK, x + columnWidth, y);
+
+            y += 10;
+            set_format_arg(0, uint16_t, metadata.NumGuests);
+            gfx_draw_string_left_clipped(
+                dpi, STR_GUESTS_IN_PARK_LABEL, gCommonFormatArgs, COLOUR_BLACK, x, y, columnWidth - 4);
+            if (metadata.ParkValue != MONEY32_UNDEFINED)
+            {
+                set_format_arg(0, money32, metadata.ParkValue);
+                gfx_draw_string_left_clipped(
+                    dpi, STR_PARK_VALUE_LABEL, gCommonFormatArgs, COLOUR_BLACK, x + columnWidth, y, columnWidth);
+            }
+        }
+    }
 }
 
 static void window_loadsave_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi, int32_t scrollIndex)
@@ -935,6 +986,27 @@ static void window_loadsave_populate_list(rct_window* w, int32_t includeNewItem,
             showExtension = true; // Show any extension after the first iteration
         }
 
+        // Read (or look up) the park details of all listed files at once, so that files are scanned in parallel
+        if (window_loadsave_shows_park_metadata())
+        {
+            std::vector<std::string> paths;
+            std::vector<size_t> itemIndices;
+            for (size_t i = 0; i < _listItems.size(); i++)
+            {
+                if (_listItems[i].type == TYPE_FILE)
+                {
+                    paths.push_back(_listItems[i].path);
+                    itemIndices.push_back(i);
+                }
+            }
+
+            auto metadata = GetParkMetadataRepository()->GetMetadata(paths);
+            for (size_t i = 0; i < metadata.size(); i++)
+            {
+                _listItems[itemIndices[i]].metadata = std::move(metadata[i]);
+            }
+        }
+
         window_loadsave_sort_list();
     }
 
@@ -387,7 +387,7 @@ static void window_network_information_paint(rct_window* w, rct_drawpixelinfo* d
     constexpr int32_t textHeight = 12;
     const int32_t graphBarWidth = std::min(1, w->width / WH);
     const int32_t totalHeight = w->height;
-    const int32_t totalHeightText = (textHeight + (padding * 2)) * 3;
+    const int32_t totalHeightText = (textHeight + (padding * 2)) * 4;
     const int32_t graphHeight = (totalHeight - totalHeightText - heightTab) / 2;
 
     rct_drawpixelinfo clippedDPI;
@@ -432,6 +432,20 @@ static void window_network_information_paint(rct_window* w, rct_drawpixelinfo* d
             y += graphHeight + padding;
         }
 
+        // Game actions sent in tick bundles, before and after compression.
+        {
+            gfx_draw_string_left(dpi, STR_NETWORK_TICK_BUNDLES, nullptr, PALETTE_INDEX_10, x, y);
+
+            format_readable_size(textBuffer, sizeof(textBuffer), _networkStats.tickBundleBytesRaw);
+            gfx_draw_string(dpi, textBuffer, PALETTE_INDEX_10, x + 100, y);
+
+            gfx_draw_string_left(dpi, STR_NETWORK_TICK_BUNDLES_COMPRESSED, nullptr, PALETTE_INDEX_10, x + 200, y);
+
+            format_readable_size(textBuffer, sizeof(textBuffer), _networkStats.tickBundleBytesCompressed);
+            gfx_draw_string(dpi, textBuffer, PALETTE_INDEX_10, x + 300, y);
+            y += textHeight + padding;
+        }
+
         // Draw legend
         {
             for (int i = 1; i < NETWORK_STATISTICS_GROUP_MAX; i++)
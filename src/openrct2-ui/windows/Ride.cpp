@@ -6004,7 +6004,8 @@ static void window_ride_graphs_update(rct_window* w)
         {
             RideMeasurement* measurement{};
             std::tie(measurement, std::ignore) = ride_get_measurement(ride);
-            x = measurement == nullptr ? 0 : measurement->current_item - (((widget->right - widget->left) / 4) * 3);
+            x = measurement == nullptr ? 0
+                                       : (int32_t)measurement->current_item - (((widget->right - widget->left) / 4) * 3);
         }
     }
 
@@ -6031,7 +6032,8 @@ static void window_ride_graphs_scrollgetheight(rct_window* w, int32_t scrollInde
         std::tie(measurement, std::ignore) = ride_get_measurement(ride);
         if (measurement != nullptr)
         {
-            *width = std::max<int32_t>(*width, measurement->num_items);
+            // Scroll widths are 16 bit, so the graph of a very long run is cut off
+            *width = std::max<int32_t>(*width, std::min<uint32_t>(measurement->num_items, INT16_MAX));
         }
     }
 }
@@ -6233,28 +6235,30 @@ static void window_ride_graphs_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi
     int32_t intensityThresholdNegative = 0;
     for (int32_t width = 0; width < dpi->width; width++, x++)
     {
-        if (x < 0 || x >= measurement->num_items - 1)
+        if (x < 0 || x >= (int32_t)measurement->num_items - 1)
             continue;
 
+        auto sample = measurement->GetSample(x);
+        auto nextSample = measurement->GetSample(x + 1);
         switch (listType)
         {
             case GRAPH_VELOCITY:
-                top = measurement->velocity[x] / 2;
-                bottom = measurement->velocity[x + 1] / 2;
+                top = sample.velocity / 2;
+                bottom = nextSample.velocity / 2;
                 break;
             case GRAPH_ALTITUDE:
-                top = measurement->altitude[x];
-                bottom = measurement->altitude[x + 1];
+                top = sample.altitude;
+                bottom = nextSample.altitude;
                 break;
             case GRAPH_VERTICAL:
-                top = measurement->vertical[x] + 39;
-                bottom = measurement->vertical[x + 1] + 39;
+                top = sample.vertical + 39;
+                bottom = nextSample.vertical + 39;
                 intensityThresholdPositive = (RIDE_G_FORCES_RED_POS_VERTICAL / 8) + 39;
                 intensityThresholdNegative = (RIDE_G_FORCES_RED_NEG_VERTICAL / 8) + 39;
                 break;
             case GRAPH_LATERAL:
-                top = measurement->lateral[x] + 52;
-                bottom = measurement->lateral[x + 1] + 52;
+                top = sample.lateral + 52;
+                bottom = nextSample.lateral + 52;
                 intensityThresholdPositive = (RIDE_G_FORCES_RED_LATERAL / 8) + 52;
                 intensityThresholdNegative = -(RIDE_G_FORCES_RED_LATERAL / 8) + 52;
                 break;
@@ -6279,7 +6283,7 @@ static void window_ride_graphs_scrollpaint(rct_window* w, rct_drawpixelinfo* dpi
             intensityThresholdNegative = widget->bottom - widget->top - intensityThresholdNegative - 13;
         }
 
-        const bool previousMeasurement = x > measurement->current_item;
+        const bool previousMeasurement = x > (int32_t)measurement->current_item;
 
         // Draw the current line in gray.
         gfx_fill_rect(dpi, x, top, x, bottom, previousMeasurement ? PALETTE_INDEX_17 : PALETTE_INDEX_21);
@@ -105,11 +105,27 @@ static std::vector<track_design_file_ref> _trackDesigns;
 static utf8 _filterString[USER_STRING_MAX_LENGTH];
 static std::vector<uint16_t> _filteredTrackIds;
 static uint16_t _loadedTrackDesignIndex;
-static std::unique_ptr<TrackDesign> _loadedTrackDesign;
-static std::vector<uint8_t> _trackDesignPreviewPixels;
+static TrackDesign* _loadedTrackDesign;
+static uint8_t* _loadedTrackDesignPreviewPixels;
+
+// Number of placed designs and their previews that are kept while the window is open
+constexpr size_t TRACK_DESIGN_PREVIEW_CACHE_SIZE = 16;
+
+struct TrackDesignPreview
+{
+    uint16_t TrackIndex = TRACK_DESIGN_INDEX_UNLOADED;
+    uint32_t LastUsed = 0;
+    std::unique_ptr<TrackDesign> Design;
+    std::vector<uint8_t> Pixels;
+};
+
+static std::vector<TrackDesignPreview> _trackDesignPreviews;
+static uint32_t _trackDesignPreviewUseCounter;
 
 static void track_list_load_designs(ride_list_item item);
-static bool track_list_load_design_for_preview(utf8* path);
+static bool track_list_load_design_for_preview(uint16_t trackIndex);
+static void track_list_prepare_neighbouring_previews(rct_window* w);
+static void track_list_clear_previews();
 
 /**
  *
@@ -159,10 +175,7 @@ rct_window* window_track_list_open(ride_list_item item)
     window_push_others_right(w);
     _currentTrackPieceDirection = 2;
 
-    _trackDesignPreviewPixels.resize(4 * TRACK_PREVIEW_IMAGE_SIZE);
-
-    _loadedTrackDesign = nullptr;
-    _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
+    track_list_clear_previews();
 
     return w;
 }
@@ -207,10 +220,9 @@ static void window_track_list_filter_list()
  */
 static void window_track_list_close(rct_window* w)
 {
-    // Dispose track design and preview
-    _loadedTrackDesign = nullptr;
-    _trackDesignPreviewPixels.clear();
-    _trackDesignPreviewPixels.shrink_to_fit();
+    // Dispose track designs and previews
+    track_list_clear_previews();
+    _trackDesignPreviews.shrink_to_fit();
 
     // Dispose track list
     for (auto& trackDesign : _trackDesigns)
@@ -320,7 +332,7 @@ static void window_track_list_mouseup(rct_window* w, rct_widgetindex widgetIndex
             break;
         case WIDX_TOGGLE_SCENERY:
             gTrackDesignSceneryToggle = !gTrackDesignSceneryToggle;
-            _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
+            track_list_clear_previews();
             w->Invalidate();
             break;
         case WIDX_BACK:
@@ -428,11 +440,16 @@ static void window_track_list_update(rct_window* w)
 
     if (w->track_list.reload_track_designs)
     {
+        track_list_clear_previews();
         track_list_load_designs(_window_track_list_item);
         w->selected_list_item = 0;
         w->Invalidate();
         w->track_list.reload_track_designs = false;
     }
+    else
+    {
+        track_list_prepare_neighbouring_previews(w);
+    }
 }
 
 /**
@@ -521,8 +538,7 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
 
     if (_loadedTrackDesignIndex != trackIndex)
     {
-        utf8* path = _trackDesigns[trackIndex].path;
-        if (track_list_load_design_for_preview(path))
+        if (track_list_load_design_for_preview(trackIndex))
         {
             _loadedTrackDesignIndex = trackIndex;
         }
@@ -542,7 +558,7 @@ static void window_track_list_paint(rct_window* w, rct_drawpixelinfo* dpi)
     y = w->y + (widget->top + widget->bottom) / 2;
 
     rct_g1_element g1temp = {};
-    g1temp.offset = _trackDesignPreviewPixels.data() + (_currentTrackPieceDirection * TRACK_PREVIEW_IMAGE_SIZE);
+    g1temp.offset = _loadedTrackDesignPreviewPixels + (_currentTrackPieceDirection * TRACK_PREVIEW_IMAGE_SIZE);
     g1temp.width = 370;
     g1temp.height = 217;
     g1temp.flags = G1_FLAG_BMP;
@@ -793,13 +809,100 @@ static void track_list_load_designs(ride_list_item item)
     window_track_list_filter_list();
 }
 
-static bool track_list_load_design_for_preview(utf8* path)
+/**
+ * Gets the placed design and preview of the given track design, placing it into the preview map if it is not cached yet.
+ * Placing a design is too slow to repeat every time a design is hovered, so the least recently used preview is only
+ * replaced once the cache is full.
+ */
+static TrackDesignPreview* track_list_get_preview(uint16_t trackIndex)
+{
+    TrackDesignPreview* preview = nullptr;
+    for (auto& cached : _trackDesignPreviews)
+    {
+        if (cached.TrackIndex == trackIndex)
+        {
+            preview = &cached;
+            break;
+        }
+    }
+
+    if (preview == nullptr)
+    {
+        if (_trackDesignPreviews.size() < TRACK_DESIGN_PREVIEW_CACHE_SIZE)
+        {
+            preview = &_trackDesignPreviews.emplace_back();
+            preview->Pixels.resize(4 * TRACK_PREVIEW_IMAGE_SIZE);
+        }
+        else
+        {
+            // Never replace the preview that is currently shown
+            for (auto& cached : _trackDesignPreviews)
+            {
+                if (cached.TrackIndex != _loadedTrackDesignIndex
+                    && (preview == nullptr || cached.LastUsed < preview->LastUsed))
+                {
+                    preview = &cached;
+                }
+            }
+        }
+
+        preview->TrackIndex = trackIndex;
+        preview->Design = track_design_open(_trackDesigns[trackIndex].path);
+        if (preview->Design != nullptr)
+        {
+            track_design_draw_preview(preview->Design.get(), preview->Pixels.data());
+        }
+    }
+
+    preview->LastUsed = ++_trackDesignPreviewUseCounter;
+    return preview;
+}
+
+static bool track_list_load_design_for_preview(uint16_t trackIndex)
 {
-    _loadedTrackDesign = track_design_open(path);
-    if (_loadedTrackDesign != nullptr)
+    auto preview = track_list_get_preview(trackIndex);
+    _loadedTrackDesign = preview->Design.get();
+    _loadedTrackDesignPreviewPixels = preview->Pixels.data();
+    return _loadedTrackDesign != nullptr;
+}
+
+/**
+ * Prepares the preview of one of the designs next to the highlighted design per update, so that moving through the list
+ * does not have to wait for designs to be placed.
+ */
+static void track_list_prepare_neighbouring_previews(rct_window* w)
+{
+    if (_loadedTrackDesignIndex == TRACK_DESIGN_INDEX_UNLOADED || w->track_list.track_list_being_updated)
+        return;
+
+    int32_t listItemIndex = w->selected_list_item;
+    if (!(gScreenFlags & SCREEN_FLAGS_TRACK_MANAGER))
     {
-        track_design_draw_preview(_loadedTrackDesign.get(), _trackDesignPreviewPixels.data());
-        return true;
+        // Because the first item in the list is "Build a custom design", lower the index by one
+        listItemIndex--;
     }
-    return false;
+
+    for (int32_t neighbourIndex : { listItemIndex + 1, listItemIndex - 1 })
+    {
+        if (neighbourIndex < 0 || neighbourIndex >= (int32_t)_filteredTrackIds.size())
+            continue;
+
+        uint16_t trackIndex = _filteredTrackIds[neighbourIndex];
+        bool isCached = std::any_of(_trackDesignPreviews.begin(), _trackDesignPreviews.end(), [trackIndex](const auto& preview) {
+            return preview.TrackIndex == trackIndex;
+        });
+        if (!isCached)
+        {
+            track_list_get_preview(trackIndex);
+            return;
+        }
+    }
+}
+
+static void track_list_clear_previews()
+{
+    _trackDesignPreviews.clear();
+    _loadedTrackDesign = nullptr;
+    _loadedTrackDesignPreviewPixels = nullptr;
+    _loadedTrackDesignIndex = TRACK_DESIGN_INDEX_UNLOADED;
 }
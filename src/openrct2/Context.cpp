@@ -54,6 +54,7 @@
 #include "platform/Crash.h"
 #include "platform/platform.h"
 #include "ride/TrackDesignRepository.h"
+#include "scenario/ParkMetadataRepository.h"
 #include "scenario/Scenario.h"
 #include "scenario/ScenarioRepository.h"
 #include "title/TitleScreen.h"
@@ -93,6 +94,7 @@ namespace OpenRCT2
         std::unique_ptr<IObjectManager> _objectManager;
         std::unique_ptr<ITrackDesignRepository> _trackDesignRepository;
         std::unique_ptr<IScenarioRepository> _scenarioRepository;
+        std::unique_ptr<IParkMetadataRepository> _parkMetadataRepository;
         std::unique_ptr<IReplayManager> _replayManager;
         std::unique_ptr<IGameStateSnapshots> _gameStateSnapshots;
 #ifdef __ENABLE_DISCORD__
@@ -149,6 +151,9 @@ namespace OpenRCT2
             // NOTE: We must shutdown all systems here before Instance is set back to null.
             //       If objects use GetContext() in their destructor things won't go well.
 
+            // Let a pending autosave finish writing before tearing anything down.
+            scenario_save_async_wait();
+
             GameActions::ClearQueue();
             network_close();
             window_close_all();
@@ -213,6 +218,11 @@ namespace OpenRCT2
             return _scenarioRepository.get();
         }
 
+        IParkMetadataRepository* GetParkMetadataRepository() override
+        {
+            return _parkMetadataRepository.get();
+        }
+
         IReplayManager* GetReplayManager() override
         {
             return _replayManager.get();
@@ -351,6 +361,7 @@ namespace OpenRCT2
             _objectManager = CreateObjectManager(*_objectRepository);
             _trackDesignRepository = CreateTrackDesignRepository(_env);
             _scenarioRepository = CreateScenarioRepository(_env);
+            _parkMetadataRepository = CreateParkMetadataRepository(_env);
             _replayManager = CreateReplayManager();
             _gameStateSnapshots = CreateGameStateSnapshots();
 #ifdef __ENABLE_DISCORD__
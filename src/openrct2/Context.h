@@ -17,6 +17,7 @@
 
 interface IObjectManager;
 interface IObjectRepository;
+interface IParkMetadataRepository;
 interface IScenarioRepository;
 interface IStream;
 interface ITrackDesignRepository;
@@ -111,6 +112,7 @@ namespace OpenRCT2
         virtual IObjectRepository& GetObjectRepository() abstract;
         virtual ITrackDesignRepository* GetTrackDesignRepository() abstract;
         virtual IScenarioRepository* GetScenarioRepository() abstract;
+        virtual IParkMetadataRepository* GetParkMetadataRepository() abstract;
         virtual IReplayManager* GetReplayManager() abstract;
         virtual IGameStateSnapshots* GetGameStateSnapshots() abstract;
         virtual int32_t GetDrawingEngineType() abstract;
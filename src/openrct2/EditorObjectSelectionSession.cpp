@@ -393,7 +393,6 @@ static void set_object_selection_error(uint8_t is_master_object, rct_string_id e
  */
 int32_t window_editor_object_selection_select_object(uint8_t bh, int32_t flags, const rct_object_entry* entry)
 {
-    int32_t numObjects = (int32_t)object_repository_get_items_count();
     const ObjectRepositoryItem* item = object_repository_find_object_by_entry(entry);
     if (item == nullptr)
     {
@@ -401,18 +400,8 @@ int32_t window_editor_object_selection_select_object(uint8_t bh, int32_t flags,
         return 0;
     }
 
-    // Get repository item index
-    int32_t index = -1;
-    const ObjectRepositoryItem* items = object_repository_get_items();
-    for (int32_t i = 0; i < numObjects; i++)
-    {
-        if (&items[i] == item)
-        {
-            index = i;
-        }
-    }
-
-    uint8_t* selectionFlags = &_objectSelectionFlags[index];
+    // The repository item ID is its index in the repository
+    uint8_t* selectionFlags = &_objectSelectionFlags[item->Id];
     if (!(flags & 1))
     {
         if (!(*selectionFlags & OBJECT_SELECTION_FLAG_SELECTED))
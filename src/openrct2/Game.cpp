@@ -784,7 +784,7 @@ void game_autosave()
         platform_file_copy(path, backupPath, true);
     }
 
-    scenario_save(path, saveFlags);
+    scenario_save_async(path, saveFlags);
 }
 
 static void game_load_or_quit_no_save_prompt_callback(int32_t result, const utf8* path)
@@ -59,6 +59,11 @@ public:
 
     virtual void Import() abstract;
     virtual bool GetDetails(scenario_index_entry * dst) abstract;
+
+    /**
+     * Gets the largest amount of temporary buffer memory, in bytes, held at once by the last load.
+     */
+    virtual size_t GetPeakLoadMemory() const abstract;
 };
 
 namespace ParkImporter
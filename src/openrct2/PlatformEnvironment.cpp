@@ -86,6 +86,8 @@ private:
             case PATHID::CACHE_OBJECTS:
             case PATHID::CACHE_TRACKS:
             case PATHID::CACHE_SCENARIOS:
+            case PATHID::CACHE_SNAPSHOT:
+            case PATHID::CACHE_PARKS:
                 return DIRBASE::CACHE;
             case PATHID::MP_DAT:
                 return DIRBASE::RCT1;
@@ -231,6 +233,8 @@ const char * PlatformEnvironment::FileNames[] =
     "objects.idx",          // CACHE_OBJECTS
     "tracks.idx",           // CACHE_TRACKS
     "scenarios.idx",        // CACHE_SCENARIOS
+    "objects.snapshot",     // CACHE_SNAPSHOT
+    "parks.idx",            // CACHE_PARKS
     "Data" PATH_SEPARATOR "mp.dat", // MP_DAT
     "groups.json",          // NETWORK_GROUPS
     "servers.cfg",          // NETWORK_SERVERS
@@ -11,6 +11,7 @@
 
 #include "Context.h"
 #include "Game.h"
+#include "GameState.h"
 #include "OpenRCT2.h"
 #include "ParkImporter.h"
 #include "PlatformEnvironment.h"
@@ -74,6 +75,15 @@ namespace OpenRCT2
         MemoryStream data;
     };
 
+    // Snapshot of the game state that playback can be restored from, the state is stored zlib compressed.
+    struct ReplayKeyframe
+    {
+        uint32_t tick = 0;
+        uint32_t commandIndex = 0; // First command not yet contained in the state.
+        uint64_t uncompressedSize = 0;
+        MemoryStream data;
+    };
+
     struct ReplayRecordData
     {
         uint32_t magic;
@@ -89,13 +99,17 @@ namespace OpenRCT2
         uint32_t tickStart;    // First tick of replay.
         uint32_t tickEnd;      // Last tick of replay.
         std::multiset<ReplayCommand> commands;
+        std::multiset<ReplayCommand>::iterator nextCommand;
         std::vector<std::pair<uint32_t, rct_sprite_checksum>> checksums;
         uint32_t checksumIndex;
+        uint32_t keyframeInterval;
+        std::vector<ReplayKeyframe> keyframes;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 3;
+        static constexpr uint16_t ReplayVersion = 4;
+        static constexpr uint16_t ReplayMinimumVersion = 3;
         static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
         static constexpr int ReplayCompressionLevel = 9;
 
@@ -156,6 +170,14 @@ namespace OpenRCT2
                 _nextChecksumTick = gCurrentTicks + 1;
             }
 
+            if ((_mode == ReplayMode::RECORDING || _mode == ReplayMode::NORMALISATION) && _currentRecording != nullptr
+                && _currentRecording->keyframeInterval != 0 && gCurrentTicks >= _nextKeyframeTick)
+            {
+                AddKeyframe();
+
+                _nextKeyframeTick = gCurrentTicks + _currentRecording->keyframeInterval;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (gCurrentTicks >= _currentRecording->tickEnd)
@@ -185,7 +207,7 @@ namespace OpenRCT2
                 ReplayCommands();
 
                 // If we run out of commands we can just stop
-                if (_currentReplay->commands.empty())
+                if (_currentReplay->nextCommand == _currentReplay->commands.end())
                 {
                     StopPlayback();
                     StopRecording();
@@ -197,7 +219,9 @@ namespace OpenRCT2
             }
         }
 
-        virtual bool StartRecording(const std::string& name, uint32_t maxTicks /*= k_MaxReplayTicks*/) override
+        virtual bool StartRecording(
+            const std::string& name, uint32_t maxTicks /*= k_MaxReplayTicks*/,
+            uint32_t keyframeInterval /*= k_ReplayKeyframeInterval*/) override
         {
             if (_mode != ReplayMode::NONE && _mode != ReplayMode::NORMALISATION)
                 return false;
@@ -212,34 +236,21 @@ namespace OpenRCT2
                 replayData->tickEnd = gCurrentTicks + maxTicks;
             else
                 replayData->tickEnd = k_MaxReplayTicks;
+            replayData->keyframeInterval = keyframeInterval;
 
             std::string replayName = String::StdFormat("%s.sv6r", name.c_str());
             std::string outPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
             replayData->filePath = Path::Combine(outPath, replayName);
 
-            auto context = GetContext();
-            auto& objManager = context->GetObjectManager();
-            auto objects = objManager.GetPackableObjects();
-
-            auto s6exporter = std::make_unique<S6Exporter>();
-            s6exporter->ExportObjectsList = objects;
-            s6exporter->Export();
-            s6exporter->SaveGame(&replayData->parkData);
-
-            replayData->spriteSpatialData.Write(gSpriteSpatialIndex, sizeof(gSpriteSpatialIndex));
+            SaveGameState(replayData->parkData, replayData->spriteSpatialData, replayData->parkParams, replayData->cheatData);
             replayData->timeRecorded = std::chrono::seconds(std::time(nullptr)).count();
 
-            DataSerialiser parkParamsDs(true, replayData->parkParams);
-            SerialiseParkParameters(parkParamsDs);
-
-            DataSerialiser cheatDataDs(true, replayData->cheatData);
-            SerialiseCheats(cheatDataDs);
-
             if (_mode != ReplayMode::NORMALISATION)
                 _mode = ReplayMode::RECORDING;
 
             _currentRecording = std::move(replayData);
             _nextChecksumTick = gCurrentTicks + 1;
+            _nextKeyframeTick = gCurrentTicks + keyframeInterval;
 
             return true;
         }
@@ -330,6 +341,7 @@ namespace OpenRCT2
                 info.Ticks = data->tickEnd - data->tickStart;
             info.NumCommands = (uint32_t)data->commands.size();
             info.NumChecksums = (uint32_t)data->checksums.size();
+            info.NumKeyframes = (uint32_t)data->keyframes.size();
 
             return true;
         }
@@ -356,6 +368,7 @@ namespace OpenRCT2
             gCurrentTicks = replayData->tickStart;
 
             _currentReplay = std::move(replayData);
+            _currentReplay->nextCommand = _currentReplay->commands.begin();
             _currentReplay->checksumIndex = 0;
             _faultyChecksumIndex = -1;
 
@@ -377,6 +390,11 @@ namespace OpenRCT2
             return _faultyChecksumIndex != -1;
         }
 
+        virtual int32_t GetMismatchingChecksumIndex() const override
+        {
+            return _faultyChecksumIndex;
+        }
+
         virtual bool StopPlayback() override
         {
             if (_mode != ReplayMode::PLAYING && _mode != ReplayMode::NORMALISATION)
@@ -400,6 +418,47 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool SeekToTick(uint32_t tick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            uint32_t targetTick = _currentReplay->tickStart + tick;
+            if (tick > _currentReplay->tickEnd - _currentReplay->tickStart)
+            {
+                log_error("Tick %u is beyond the end of the replay.", tick);
+                return false;
+            }
+
+            // Find the closest keyframe before the target, keyframes are stored in order.
+            const ReplayKeyframe* keyframe = nullptr;
+            for (const auto& candidate : _currentReplay->keyframes)
+            {
+                if (candidate.tick > targetTick)
+                    break;
+                keyframe = &candidate;
+            }
+
+            uint32_t restoreTick = keyframe != nullptr ? keyframe->tick : _currentReplay->tickStart;
+            if (gCurrentTicks > targetTick || gCurrentTicks < restoreTick)
+            {
+                if (!RestoreKeyframe(keyframe))
+                {
+                    log_error("Unable to restore keyframe at tick %u.", restoreTick);
+                    return false;
+                }
+            }
+
+            // Simulate the remaining ticks, playback might end on its own if the target is the last tick.
+            auto* gameState = GetContext()->GetGameState();
+            while (_mode == ReplayMode::PLAYING && gCurrentTicks < targetTick)
+            {
+                gameState->UpdateLogic();
+            }
+
+            return true;
+        }
+
         virtual bool NormaliseReplay(const std::string& file, const std::string& outFile) override
         {
             _mode = ReplayMode::NORMALISATION;
@@ -409,7 +468,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!StartRecording(outFile, k_MaxReplayTicks))
+            if (!StartRecording(outFile, k_MaxReplayTicks, _currentReplay->keyframeInterval))
             {
                 StopPlayback();
                 return false;
@@ -421,37 +480,62 @@ namespace OpenRCT2
         }
 
     private:
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        void SaveGameState(
+            MemoryStream& parkData, MemoryStream& spriteSpatialData, MemoryStream& parkParams, MemoryStream& cheatData)
+        {
+            auto context = GetContext();
+            auto& objManager = context->GetObjectManager();
+            auto objects = objManager.GetPackableObjects();
+
+            auto s6exporter = std::make_unique<S6Exporter>();
+            s6exporter->ExportObjectsList = objects;
+            s6exporter->Export();
+            s6exporter->SaveGame(&parkData);
+
+            spriteSpatialData.Write(gSpriteSpatialIndex, sizeof(gSpriteSpatialIndex));
+
+            DataSerialiser parkParamsDs(true, parkParams);
+            SerialiseParkParameters(parkParamsDs);
+
+            DataSerialiser cheatDataDs(true, cheatData);
+            SerialiseCheats(cheatDataDs);
+        }
+
+        bool LoadGameState(
+            MemoryStream& parkData, MemoryStream& spriteSpatialData, MemoryStream& parkParams, MemoryStream& cheatData)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateS6(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects.data(), loadResult.RequiredObjects.size());
 
                 importer->Import();
 
                 sprite_position_tween_reset();
 
-                Guard::Assert(sizeof(gSpriteSpatialIndex) >= data.spriteSpatialData.GetLength());
+                Guard::Assert(sizeof(gSpriteSpatialIndex) >= spriteSpatialData.GetLength());
 
                 // In case the sprite limit will be increased we keep the unused fields cleared.
                 std::fill_n(gSpriteSpatialIndex, std::size(gSpriteSpatialIndex), SPRITE_INDEX_NULL);
-                std::memcpy(gSpriteSpatialIndex, data.spriteSpatialData.GetData(), data.spriteSpatialData.GetLength());
+                std::memcpy(gSpriteSpatialIndex, spriteSpatialData.GetData(), spriteSpatialData.GetLength());
+                reset_vehicle_spatial_index();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                parkParams.SetPosition(0);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 // New cheats might not be serialised, make sure they are using their defaults.
                 CheatsReset();
 
-                DataSerialiser cheatDataDs(false, data.cheatData);
+                cheatData.SetPosition(0);
+                DataSerialiser cheatDataDs(false, cheatData);
                 SerialiseCheats(cheatDataDs);
 
                 game_load_init();
@@ -465,6 +549,96 @@ namespace OpenRCT2
             return true;
         }
 
+        bool LoadReplayDataMap(ReplayRecordData& data)
+        {
+            return LoadGameState(data.parkData, data.spriteSpatialData, data.parkParams, data.cheatData);
+        }
+
+        void AddKeyframe()
+        {
+            MemoryStream parkData;
+            MemoryStream spriteSpatialData;
+            MemoryStream parkParams;
+            MemoryStream cheatData;
+            SaveGameState(parkData, spriteSpatialData, parkParams, cheatData);
+
+            DataSerialiser stateDs(true);
+            stateDs << parkData << spriteSpatialData << parkParams << cheatData;
+
+            const auto& stream = stateDs.GetStream();
+            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
+            unsigned long compressLength = compressBound(streamLength);
+
+            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
+            if (compress2(
+                    compressBuf.get(), &compressLength, (const unsigned char*)stream.GetData(), streamLength,
+                    ReplayCompressionLevel)
+                != Z_OK)
+            {
+                log_error("Unable to compress keyframe at tick %u", gCurrentTicks);
+                return;
+            }
+
+            ReplayKeyframe keyframe;
+            keyframe.tick = gCurrentTicks;
+            keyframe.commandIndex = _commandId;
+            keyframe.uncompressedSize = streamLength;
+            keyframe.data.Write(compressBuf.get(), compressLength);
+
+            _currentRecording->keyframes.push_back(std::move(keyframe));
+        }
+
+        // Restores the game state of the given keyframe, or the start of the replay if there is none.
+        bool RestoreKeyframe(const ReplayKeyframe* keyframe)
+        {
+            auto& replay = *_currentReplay;
+            if (keyframe == nullptr)
+            {
+                if (!LoadReplayDataMap(replay))
+                    return false;
+
+                gCurrentTicks = replay.tickStart;
+                replay.nextCommand = replay.commands.begin();
+            }
+            else
+            {
+                auto buff = std::make_unique<unsigned char[]>(keyframe->uncompressedSize);
+                unsigned long outSize = static_cast<unsigned long>(keyframe->uncompressedSize);
+                uncompress(buff.get(), &outSize, (const unsigned char*)keyframe->data.GetData(), keyframe->data.GetLength());
+                if (outSize != keyframe->uncompressedSize)
+                    return false;
+
+                MemoryStream stateStream(buff.get(), outSize);
+                MemoryStream parkData;
+                MemoryStream spriteSpatialData;
+                MemoryStream parkParams;
+                MemoryStream cheatData;
+
+                DataSerialiser stateDs(false, stateStream);
+                stateDs << parkData << spriteSpatialData << parkParams << cheatData;
+
+                if (!LoadGameState(parkData, spriteSpatialData, parkParams, cheatData))
+                    return false;
+
+                gCurrentTicks = keyframe->tick;
+
+                // The state already contains every command that was executed before it was captured.
+                replay.nextCommand = std::find_if(replay.commands.begin(), replay.commands.end(), [keyframe](const auto& cmd) {
+                    return cmd.commandIndex >= keyframe->commandIndex;
+                });
+            }
+
+            replay.checksumIndex = 0;
+            while (replay.checksumIndex < replay.checksums.size()
+                   && replay.checksums[replay.checksumIndex].first < gCurrentTicks)
+            {
+                replay.checksumIndex++;
+            }
+            _faultyChecksumIndex = -1;
+
+            return true;
+        }
+
         bool ReadReplayFromFile(const std::string& file, MemoryStream& stream)
         {
             FILE* fp = fopen(file.c_str(), "rb");
@@ -619,7 +793,7 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            return data.version >= ReplayMinimumVersion && data.version <= ReplayVersion;
         }
 
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
@@ -692,18 +866,47 @@ namespace OpenRCT2
                 serialiser << data.checksums[i].second.raw;
             }
 
+            if (data.version < 4)
+            {
+                data.keyframeInterval = 0;
+                return true;
+            }
+
+            serialiser << data.keyframeInterval;
+
+            uint32_t countKeyframes = (uint32_t)data.keyframes.size();
+            serialiser << countKeyframes;
+
+            if (serialiser.IsLoading())
+            {
+                data.keyframes.resize(countKeyframes);
+            }
+
+            for (auto& keyframe : data.keyframes)
+            {
+                serialiser << keyframe.tick;
+                serialiser << keyframe.commandIndex;
+                serialiser << keyframe.uncompressedSize;
+                serialiser << keyframe.data;
+            }
+
             return true;
         }
 
 #ifndef DISABLE_NETWORK
         void CheckState()
         {
-            if (_nextChecksumTick != gCurrentTicks)
-                return;
+            // Skip checksums of ticks that were never simulated, e.g. after seeking.
+            auto& checksums = _currentReplay->checksums;
+            while (_currentReplay->checksumIndex < checksums.size()
+                   && checksums[_currentReplay->checksumIndex].first < gCurrentTicks)
+            {
+                _currentReplay->checksumIndex++;
+            }
 
             uint32_t checksumIndex = _currentReplay->checksumIndex;
 
-            if (checksumIndex >= _currentReplay->checksums.size())
+            if (checksumIndex >= checksums.size())
                 return;
 
             const auto& savedChecksum = _currentReplay->checksums[checksumIndex];
@@ -719,7 +922,9 @@ namespace OpenRCT2
                         "Different sprite checksum at tick %u (Replay Tick: %u) ; Saved: %s, Current: %s", gCurrentTicks,
                         replayTick, savedChecksum.second.ToString().c_str(), checksum.ToString().c_str());
 
-                    _faultyChecksumIndex = checksumIndex;
+                    // Keep the first mismatch, later ones are usually a consequence of it.
+                    if (_faultyChecksumIndex == -1)
+                        _faultyChecksumIndex = checksumIndex;
                 }
                 else
                 {
@@ -736,10 +941,11 @@ namespace OpenRCT2
         void ReplayCommands()
         {
             auto& replayQueue = _currentReplay->commands;
+            auto& nextCommand = _currentReplay->nextCommand;
 
-            while (replayQueue.begin() != replayQueue.end())
+            while (nextCommand != replayQueue.end())
             {
-                const ReplayCommand& command = (*replayQueue.begin());
+                const ReplayCommand& command = *nextCommand;
 
                 if (_mode == ReplayMode::PLAYING)
                 {
@@ -775,7 +981,8 @@ namespace OpenRCT2
                         window_scroll_to_location(mainWindow, result->Position.x, result->Position.y, result->Position.z);
                 }
 
-                replayQueue.erase(replayQueue.begin());
+                // Commands are kept so playback can seek back to an earlier keyframe.
+                nextCommand++;
             }
         }
 
@@ -787,6 +994,7 @@ namespace OpenRCT2
         uint32_t _commandId = 0;
         uint32_t _nextChecksumTick = 0;
         uint32_t _nextReplayTick = 0;
+        uint32_t _nextKeyframeTick = 0;
     };
 
     std::unique_ptr<IReplayManager> CreateReplayManager()
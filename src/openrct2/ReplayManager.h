@@ -20,6 +20,8 @@ struct GameAction;
 namespace OpenRCT2
 {
     static constexpr uint32_t k_MaxReplayTicks = 0xFFFFFFFF;
+    // Default amount of ticks between two keyframes, roughly 5 minutes at normal game speed.
+    static constexpr uint32_t k_ReplayKeyframeInterval = 40 * 60 * 5;
 
     struct ReplayRecordInfo
     {
@@ -28,6 +30,7 @@ namespace OpenRCT2
         uint64_t TimeRecorded;
         uint32_t NumCommands;
         uint32_t NumChecksums;
+        uint32_t NumKeyframes;
         std::string Name;
         std::string FilePath;
     };
@@ -45,13 +48,20 @@ namespace OpenRCT2
 
         virtual void AddGameAction(uint32_t tick, const GameAction* action) = 0;
 
-        virtual bool StartRecording(const std::string& name, uint32_t maxTicks = k_MaxReplayTicks) = 0;
+        virtual bool StartRecording(
+            const std::string& name, uint32_t maxTicks = k_MaxReplayTicks, uint32_t keyframeInterval = k_ReplayKeyframeInterval)
+            = 0;
         virtual bool StopRecording() = 0;
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo & info) const = 0;
 
         virtual bool StartPlayback(const std::string& file) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
+        // Index of the first checksum that did not match during the last playback, -1 if all matched.
+        virtual int32_t GetMismatchingChecksumIndex() const = 0;
         virtual bool StopPlayback() = 0;
+        // Jumps to the given tick relative to the start of the replay by restoring the closest keyframe
+        // and simulating the remaining ticks.
+        virtual bool SeekToTick(uint32_t tick) = 0;
 
         virtual bool NormaliseReplay(const std::string& inputFile, const std::string& outputFile) = 0;
     };
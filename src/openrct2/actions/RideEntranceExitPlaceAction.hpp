@@ -211,8 +211,7 @@ public:
         {
             ride_set_entrance_location(
                 ride, _stationNum, { _loc.x / 32, _loc.y / 32, z / 8, (uint8_t)tileElement->GetDirection() });
-            ride->stations[_stationNum].LastPeepInQueue = SPRITE_INDEX_NULL;
-            ride->stations[_stationNum].QueueLength = 0;
+            ride->QueueClear(_stationNum);
 
             map_animation_create(MAP_ANIMATION_TYPE_RIDE_ENTRANCE, { _loc, z });
         }
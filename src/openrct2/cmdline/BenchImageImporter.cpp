@@ -0,0 +1,159 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/Console.hpp"
+#    include "../core/Imaging.h"
+#    include "../drawing/ImageImporter.h"
+#    include "../platform/platform.h"
+#    include "../util/Util.h"
+
+#    include <benchmark/benchmark.h>
+#    include <cstdlib>
+#    include <memory>
+#    include <random>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2::Drawing;
+
+using ClosestColourFunc = int32_t (*)(const int32_t*, const int32_t*, const int32_t*, size_t, int32_t, int32_t, int32_t);
+
+static void BM_image_import(benchmark::State& state, const Image* image, ImageImporter::IMPORT_MODE mode)
+{
+    ImageImporter importer;
+    for (auto _ : state)
+    {
+        auto result = importer.Import(*image, 0, 0, ImageImporter::IMPORT_FLAGS::RLE, mode);
+        benchmark::DoNotOptimize(result.Buffer);
+        std::free(result.Buffer);
+    }
+    state.SetItemsProcessed(state.iterations() * image->Width * image->Height);
+}
+
+static void BM_image_closest_colour(benchmark::State& state, ClosestColourFunc fn)
+{
+    // Same size as the set of changeable entries in the standard palette
+    constexpr size_t count = 232;
+    std::mt19937 prng(0);
+    std::uniform_int_distribution<int32_t> channel(0, 255);
+    std::vector<int32_t> red(count), green(count), blue(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        red[i] = channel(prng);
+        green[i] = channel(prng);
+        blue[i] = channel(prng);
+    }
+
+    int32_t r = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(fn(red.data(), green.data(), blue.data(), count, r, 255 - r, r / 2));
+        r = (r + 1) & 0xFF;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void register_image_benchmarks(const std::string& name, const Image* image)
+{
+    benchmark::RegisterBenchmark((name + "/default").c_str(), BM_image_import, image, ImageImporter::IMPORT_MODE::DEFAULT);
+    benchmark::RegisterBenchmark((name + "/closest").c_str(), BM_image_import, image, ImageImporter::IMPORT_MODE::CLOSEST);
+    benchmark::RegisterBenchmark(
+        (name + "/dithering").c_str(), BM_image_import, image, ImageImporter::IMPORT_MODE::DITHERING);
+}
+
+static int cmdline_for_bench_image_importer(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // The benchmarks keep pointers to the images, so they must not move once registered.
+    std::vector<std::unique_ptr<Image>> images;
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (platform_file_exists(argv[i]))
+        {
+            auto image = std::make_unique<Image>();
+            try
+            {
+                *image = Imaging::ReadFromFile(argv[i], IMAGE_FORMAT::PNG_32);
+            }
+            catch (const std::exception& e)
+            {
+                Console::Error::WriteLine("Unable to read '%s': %s", argv[i], e.what());
+                return -1;
+            }
+            register_image_benchmarks(argv[i], image.get());
+            images.push_back(std::move(image));
+        }
+        else
+        {
+            argv_for_benchmark.push_back((char*)argv[i]);
+        }
+    }
+
+    benchmark::RegisterBenchmark("closest_colour/scalar", BM_image_closest_colour, imageimporter_find_closest_colour_scalar);
+    if (sse41_available())
+    {
+        benchmark::RegisterBenchmark(
+            "closest_colour/sse4_1", BM_image_closest_colour, imageimporter_find_closest_colour_sse4_1);
+    }
+
+    // Update argc with all the changes made
+    argc = (int)argv_for_benchmark.size();
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchImageImporter(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_image_importer(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchImageImporter(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchImageImporterCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<png>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchImageImporter),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchImageImporter), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,134 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../EditorObjectSelectionSession.h"
+#    include "../OpenRCT2.h"
+#    include "../core/Console.hpp"
+#    include "../object/ObjectList.h"
+#    include "../object/ObjectRepository.h"
+#    include "../platform/platform.h"
+
+#    include <benchmark/benchmark.h>
+#    include <vector>
+
+static void BM_object_selection_select_unselect_all(benchmark::State& state)
+{
+    auto numItems = object_repository_get_items_count();
+    auto items = object_repository_get_items();
+    for (auto _ : state)
+    {
+        sub_6AB211();
+
+        // Select as many objects as each type allows, like a user filling up the selection
+        for (size_t i = 0; i < numItems; i++)
+        {
+            auto objectType = object_entry_get_type(&items[i].ObjectEntry);
+            if (_numSelectedObjectsForType[objectType] < object_entry_group_counts[objectType])
+            {
+                window_editor_object_selection_select_object(0, 1, &items[i].ObjectEntry);
+            }
+        }
+        for (size_t i = 0; i < numItems; i++)
+        {
+            window_editor_object_selection_select_object(0, 0, &items[i].ObjectEntry);
+        }
+        benchmark::DoNotOptimize(_objectSelectionFlags.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+
+static void BM_object_repository_find_all(benchmark::State& state)
+{
+    auto numItems = object_repository_get_items_count();
+    auto items = object_repository_get_items();
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < numItems; i++)
+        {
+            benchmark::DoNotOptimize(object_repository_find_object_by_entry(&items[i].ObjectEntry));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numItems);
+}
+
+static int cmdline_for_bench_object_selection(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+    for (int i = 0; i < argc; i++)
+    {
+        argv_for_benchmark.push_back((char*)argv[i]);
+    }
+
+    core_init();
+    gOpenRCT2Headless = true;
+    auto context = OpenRCT2::CreateContext();
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Unable to initialise the game.");
+        return -1;
+    }
+    log_info("%zu objects in repository", object_repository_get_items_count());
+
+    benchmark::RegisterBenchmark("object_selection/select_unselect_all", BM_object_selection_select_unselect_all);
+    benchmark::RegisterBenchmark("object_repository/find_all", BM_object_repository_find_all);
+
+    // Update argc with all the changes made
+    argc = (int)argv_for_benchmark.size();
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    editor_object_flags_free();
+    return 0;
+}
+
+static exitcode_t HandleBenchObjectSelection(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_object_selection(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchObjectSelection(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchObjectSelectionCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchObjectSelection),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchObjectSelection), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,464 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/String.hpp"
+#include "../interface/Viewport.h"
+#include "../object/ObjectList.h"
+#include "../object/ObjectManager.h"
+#include "../object/ObjectRepository.h"
+#include "../paint/Paint.h"
+#include "../paint/tile_element/Paint.TileElement.h"
+#include "../platform/platform.h"
+#include "../ride/Ride.h"
+#include "../ride/RideData.h"
+#include "../ride/Track.h"
+#include "../ride/TrackData.h"
+#include "../ride/TrackPaint.h"
+#include "../world/Map.h"
+#include "../world/Sprite.h"
+#include "../world/Surface.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static utf8* _benchPaintGoldenPath = nullptr;
+static bool _benchPaintUpdate = false;
+static int32_t _benchPaintIterations = 0;
+
+// Size of the map the track elements are painted on, only the tile in the middle is used.
+static constexpr int32_t BenchPaintMapSize = 8;
+static constexpr int32_t BenchPaintDefaultIterations = 3;
+static constexpr int32_t BenchPaintNumRotations = 4;
+static constexpr int32_t BenchPaintNumDirections = 4;
+static constexpr int32_t BenchPaintNumTrackTypes = 256;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition BenchPaintOptionsDef[]
+{
+    { CMDLINE_TYPE_STRING,  &_benchPaintGoldenPath, 'g', "golden",     "compare the painted track elements against the given golden file" },
+    { CMDLINE_TYPE_SWITCH,  &_benchPaintUpdate,     'u', "update",     "write the golden file instead of comparing against it" },
+    { CMDLINE_TYPE_INTEGER, &_benchPaintIterations, 'i', "iterations", "number of times every track element is painted for the timing" },
+    OptionTableEnd
+};
+
+static exitcode_t HandleBenchPaint(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::BenchPaintCommands[]
+{
+    // Main commands
+    DefineCommand("", "[--golden <file> [--update]] [--iterations <count>]", BenchPaintOptionsDef, HandleBenchPaint),
+    CommandTableEnd
+};
+// clang-format on
+
+/**
+ * Hashes everything a track element leaves in a paint session (FNV-1a), the paint structs in the order they are drawn
+ * as well as the tunnels and support heights.
+ */
+class PaintSessionHash
+{
+private:
+    uint64_t _hash = 0xCBF29CE484222325;
+
+public:
+    uint64_t GetValue() const
+    {
+        return _hash;
+    }
+
+    void Add(uint32_t value)
+    {
+        for (int32_t i = 0; i < 4; i++)
+        {
+            _hash ^= (value >> (i * 8)) & 0xFF;
+            _hash *= 0x100000001B3;
+        }
+    }
+
+    void Add(const paint_session& session)
+    {
+        for (auto ps = session.PaintHead.next_quadrant_ps; ps != nullptr; ps = ps->next_quadrant_ps)
+        {
+            for (auto child = ps; child != nullptr; child = child->children)
+            {
+                Add(child->image_id);
+                Add(child->tertiary_colour);
+                Add(child->bounds.x | (child->bounds.y << 16));
+                Add(child->bounds.z | (child->bounds.x_end << 16));
+                Add(child->bounds.y_end | (child->bounds.z_end << 16));
+                Add(child->x | (child->y << 16));
+                Add(child->flags | (child->sprite_type << 8));
+                for (auto attached = child->attached_ps; attached != nullptr; attached = attached->next)
+                {
+                    Add(attached->image_id);
+                    Add(attached->tertiary_colour);
+                    Add(attached->x | (attached->y << 16));
+                    Add(attached->flags);
+                }
+            }
+        }
+
+        Add(session.LeftTunnelCount | (session.RightTunnelCount << 8) | (session.VerticalTunnelHeight << 16));
+        for (int32_t i = 0; i < session.LeftTunnelCount; i++)
+        {
+            Add(session.LeftTunnels[i].height | (session.LeftTunnels[i].type << 8));
+        }
+        for (int32_t i = 0; i < session.RightTunnelCount; i++)
+        {
+            Add(session.RightTunnels[i].height | (session.RightTunnels[i].type << 8));
+        }
+        for (const auto& supportSegment : session.SupportSegments)
+        {
+            Add(supportSegment.height | (supportSegment.slope << 16));
+        }
+        Add(session.Support.height | (session.Support.slope << 16));
+    }
+};
+
+struct BenchPaintRideType
+{
+    uint8_t RideType;
+    std::string ObjectName;
+    uint8_t EntryIndex;
+};
+
+struct BenchPaintResult
+{
+    size_t NumTrackElements = 0;
+    size_t NumPaintStructs = 0;
+    // Keyed by "<ride type> <track type>", holding "<ride object> <paint structs> <hash>"
+    std::map<std::string, std::string> Lines;
+};
+
+/**
+ * Picks a ride object for every ride type with track paint functions, the first one by name so the same object is
+ * picked on every machine that has it, and loads them.
+ */
+static std::vector<BenchPaintRideType> LoadBenchPaintRideObjects(IContext& context)
+{
+    auto& objectRepository = context.GetObjectRepository();
+    auto objects = objectRepository.GetObjects();
+    std::array<const ObjectRepositoryItem*, RIDE_TYPE_COUNT> rideTypeObjects{};
+    for (size_t i = 0; i < objectRepository.GetNumObjects(); i++)
+    {
+        const auto& ori = objects[i];
+        if (object_entry_get_type(&ori.ObjectEntry) != OBJECT_TYPE_RIDE)
+            continue;
+
+        for (auto rideType : ori.RideInfo.RideType)
+        {
+            if (rideType >= RIDE_TYPE_COUNT)
+                continue;
+
+            auto& selected = rideTypeObjects[rideType];
+            if (selected == nullptr || ori.ObjectEntry.GetName() < selected->ObjectEntry.GetName())
+            {
+                selected = &ori;
+            }
+        }
+    }
+
+    std::vector<rct_object_entry> entries;
+    for (size_t rideType = 0; rideType < RIDE_TYPE_COUNT; rideType++)
+    {
+        auto ori = rideTypeObjects[rideType];
+        if (ori != nullptr && RideTypeTrackPaintFunctions[rideType] != nullptr)
+        {
+            entries.push_back(ori->ObjectEntry);
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const rct_object_entry& a, const rct_object_entry& b) {
+        return a.GetName() < b.GetName();
+    });
+    entries.erase(
+        std::unique(
+            entries.begin(), entries.end(),
+            [](const rct_object_entry& a, const rct_object_entry& b) { return a.GetName() == b.GetName(); }),
+        entries.end());
+
+    auto& objectManager = context.GetObjectManager();
+    objectManager.UnloadAll();
+    objectManager.LoadObjects(entries.data(), entries.size());
+
+    std::vector<BenchPaintRideType> rideTypes;
+    for (size_t rideType = 0; rideType < RIDE_TYPE_COUNT; rideType++)
+    {
+        auto ori = rideTypeObjects[rideType];
+        if (ori == nullptr || RideTypeTrackPaintFunctions[rideType] == nullptr)
+            continue;
+
+        auto object = objectManager.GetLoadedObject(&ori->ObjectEntry);
+        if (object == nullptr)
+        {
+            Console::Error::WriteLine("Unable to load '%s' for ride type %d.", ori->Name.c_str(), (int32_t)rideType);
+            continue;
+        }
+        auto objectName = String::Trim(std::string(ori->ObjectEntry.GetName()));
+        rideTypes.push_back({ (uint8_t)rideType, objectName, objectManager.GetLoadedObjectEntryIndex(object) });
+    }
+    return rideTypes;
+}
+
+static int32_t GetBenchPaintSequenceCount(uint8_t rideType, uint8_t trackType)
+{
+    const rct_preview_track* trackBlock = ride_type_has_flag(rideType, RIDE_TYPE_FLAG_FLAT_RIDE)
+        ? FlatRideTrackBlocks[trackType]
+        : TrackBlocks[trackType];
+    int32_t sequenceCount = 0;
+    if (trackBlock != nullptr)
+    {
+        while (trackBlock[sequenceCount].index != 0xFF)
+        {
+            sequenceCount++;
+        }
+    }
+    return sequenceCount;
+}
+
+/**
+ * Paints the tile of the track element like a viewport would and arranges the paint structs for drawing, returns the
+ * number of paint structs used.
+ */
+static size_t PaintBenchTile(const CoordsXYZ& tilePos, uint8_t rotation, PaintSessionHash* hash)
+{
+    auto screenCoords = translate_3d_to_2d_with_z(rotation, { tilePos.x + 16, tilePos.y + 16, tilePos.z });
+
+    // Large enough for the tallest track pieces, there are no pixels to draw to.
+    rct_drawpixelinfo dpi{};
+    dpi.x = screenCoords.x - 256;
+    dpi.y = screenCoords.y - 512;
+    dpi.width = 512;
+    dpi.height = 1024;
+
+    gCurrentRotation = rotation;
+    auto session = paint_session_alloc(&dpi, 0);
+    session->CurrentRotation = rotation;
+    tile_element_paint_setup(session, tilePos.x, tilePos.y);
+    paint_session_arrange(session);
+
+    size_t numPaintStructs = session->NextFreePaintStruct - session->PaintStructs;
+    if (hash != nullptr)
+    {
+        hash->Add(*session);
+    }
+    paint_session_free(session);
+    return numPaintStructs;
+}
+
+/**
+ * Paints every track type of every ride type in every direction and rotation, recording what was painted if asked to.
+ */
+static void PaintBenchTrackElements(
+    const std::vector<BenchPaintRideType>& rideTypes, TrackElement* trackElement, const CoordsXYZ& tilePos,
+    BenchPaintResult& result, bool record)
+{
+    auto ride = GetOrAllocateRide(0);
+    for (const auto& rideType : rideTypes)
+    {
+        ride->type = rideType.RideType;
+        ride->subtype = rideType.EntryIndex;
+        for (int32_t trackType = 0; trackType < BenchPaintNumTrackTypes; trackType++)
+        {
+            if (track_paint_get_function(rideType.RideType, trackType) == nullptr)
+                continue;
+
+            PaintSessionHash hash;
+            size_t numPaintStructs = 0;
+            int32_t sequenceCount = GetBenchPaintSequenceCount(rideType.RideType, trackType);
+            trackElement->SetTrackType(trackType);
+            for (int32_t sequence = 0; sequence < sequenceCount; sequence++)
+            {
+                trackElement->SetSequenceIndex(sequence);
+                for (int32_t direction = 0; direction < BenchPaintNumDirections; direction++)
+                {
+                    trackElement->SetDirection(direction);
+                    for (uint8_t rotation = 0; rotation < BenchPaintNumRotations; rotation++)
+                    {
+                        numPaintStructs += PaintBenchTile(tilePos, rotation, record ? &hash : nullptr);
+                        result.NumTrackElements++;
+                    }
+                }
+            }
+            result.NumPaintStructs += numPaintStructs;
+
+            if (record)
+            {
+                auto key = String::StdFormat("%d %d", rideType.RideType, trackType);
+                result.Lines[key] = String::StdFormat(
+                    "%s %zu %016llx", rideType.ObjectName.c_str(), numPaintStructs, (unsigned long long)hash.GetValue());
+            }
+        }
+    }
+}
+
+/**
+ * Puts the track element on the tile in the middle of an empty map, owned by a ride in slot 0 that is not running so
+ * no vehicles are painted. No station object is loaded, so station pieces are painted without platforms or covers.
+ */
+static TrackElement* PrepareBenchPaintMap(IContext& context, CoordsXYZ& tilePos)
+{
+    context.GetGameState()->InitAll(BenchPaintMapSize);
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    auto ride = GetOrAllocateRide(0);
+    ride->entrance_style = 0;
+    for (auto& vehicle : ride->vehicles)
+    {
+        vehicle = SPRITE_INDEX_NULL;
+    }
+
+    tilePos = { BenchPaintMapSize * 16, BenchPaintMapSize * 16, 0 };
+    auto surfaceElement = map_get_surface_element_at(CoordsXY{ tilePos.x, tilePos.y });
+    if (surfaceElement == nullptr)
+    {
+        return nullptr;
+    }
+    // Above the surface so the supports are painted as well
+    tilePos.z = surfaceElement->GetBaseZ() + 16;
+
+    auto tileElement = tile_element_insert(TileCoordsXYZ(tilePos), 0b1111);
+    if (tileElement == nullptr)
+    {
+        return nullptr;
+    }
+    tileElement->SetType(TILE_ELEMENT_TYPE_TRACK);
+    tileElement->SetBaseZ(tilePos.z);
+    tileElement->SetClearanceZ(tilePos.z + 32);
+    auto trackElement = tileElement->AsTrack();
+    trackElement->SetRideIndex(0);
+    return trackElement;
+}
+
+static bool CompareBenchPaintGolden(const std::string& path, const BenchPaintResult& result)
+{
+    std::map<std::string, std::string> golden;
+    for (const auto& line : File::ReadAllLines(path))
+    {
+        // The key is the ride type and track type, the first two fields
+        auto keyEnd = line.find(' ', line.find(' ') + 1);
+        if (keyEnd != std::string::npos)
+        {
+            golden[line.substr(0, keyEnd)] = line.substr(keyEnd + 1);
+        }
+    }
+
+    size_t numMatching = 0;
+    bool allMatching = true;
+    for (const auto& [key, value] : result.Lines)
+    {
+        auto it = golden.find(key);
+        if (it == golden.end())
+        {
+            Console::Error::WriteLine("%s: not in golden file, painted %s", key.c_str(), value.c_str());
+            allMatching = false;
+        }
+        else if (it->second != value)
+        {
+            Console::Error::WriteLine("%s: expected %s, painted %s", key.c_str(), it->second.c_str(), value.c_str());
+            allMatching = false;
+        }
+        else
+        {
+            numMatching++;
+        }
+    }
+    for (const auto& [key, value] : golden)
+    {
+        if (result.Lines.find(key) == result.Lines.end())
+        {
+            Console::Error::WriteLine("%s: in golden file but not painted", key.c_str());
+            allMatching = false;
+        }
+    }
+
+    Console::WriteLine("%zu/%zu track types painted as in '%s'", numMatching, golden.size(), path.c_str());
+    return allMatching;
+}
+
+static exitcode_t HandleBenchPaint(CommandLineArgEnumerator* argEnumerator)
+{
+    if (_benchPaintGoldenPath != nullptr && !_benchPaintUpdate && !File::Exists(_benchPaintGoldenPath))
+    {
+        Console::Error::WriteLine("Golden file '%s' does not exist.", _benchPaintGoldenPath);
+        Console::Error::WriteLine("Run 'benchpaint --golden <file> --update' with the game data to create it.");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Failed to initialise the game.");
+        return EXITCODE_FAIL;
+    }
+
+    auto rideTypes = LoadBenchPaintRideObjects(*context);
+    CoordsXYZ tilePos;
+    auto trackElement = PrepareBenchPaintMap(*context, tilePos);
+    if (rideTypes.empty() || trackElement == nullptr)
+    {
+        Console::Error::WriteLine("Nothing to paint, no ride objects found.");
+        return EXITCODE_FAIL;
+    }
+
+    // The first pass records what was painted, the timed passes after it only paint.
+    BenchPaintResult result;
+    PaintBenchTrackElements(rideTypes, trackElement, tilePos, result, true);
+
+    int32_t iterations = _benchPaintIterations > 0 ? _benchPaintIterations : BenchPaintDefaultIterations;
+    BenchPaintResult timedResult;
+    auto startTime = std::chrono::high_resolution_clock::now();
+    for (int32_t i = 0; i < iterations; i++)
+    {
+        PaintBenchTrackElements(rideTypes, trackElement, tilePos, timedResult, false);
+    }
+    std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - startTime;
+    double seconds = duration.count();
+
+    Console::WriteLine(
+        "Painted %zu ride types, %zu track types, %zu track elements per pass", rideTypes.size(), result.Lines.size(),
+        result.NumTrackElements);
+    Console::WriteLine("No station object is loaded, so station platforms and covers are not painted or checked");
+    Console::WriteLine(
+        "%d passes: %.3f s, %.0f track elements/s, %.0f paint structs/s", iterations, seconds,
+        timedResult.NumTrackElements / seconds, timedResult.NumPaintStructs / seconds);
+
+    if (_benchPaintGoldenPath == nullptr)
+    {
+        return EXITCODE_OK;
+    }
+    if (_benchPaintUpdate)
+    {
+        std::string golden;
+        for (const auto& [key, value] : result.Lines)
+        {
+            golden += key + ' ' + value + '\n';
+        }
+        File::WriteAllBytes(_benchPaintGoldenPath, golden.data(), golden.size());
+        Console::WriteLine("Wrote %zu track types to '%s'", result.Lines.size(), _benchPaintGoldenPath);
+        return EXITCODE_OK;
+    }
+    return CompareBenchPaintGolden(_benchPaintGoldenPath, result) ? EXITCODE_OK : EXITCODE_FAIL;
+}
@@ -0,0 +1,217 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../core/Console.hpp"
+#    include "../core/File.h"
+#    include "../core/MemoryStream.h"
+#    include "../object/Object.h"
+#    include "../platform/platform.h"
+#    include "../rct12/SawyerChunkReader.h"
+#    include "../rct12/SawyerChunkWriter.h"
+#    include "../scenario/Scenario.h"
+#    include "../util/SawyerCoding.h"
+#    include "../util/Util.h"
+
+#    include <algorithm>
+#    include <benchmark/benchmark.h>
+#    include <cstring>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+struct SawyerBenchFile
+{
+    std::vector<uint8_t> Data;
+    std::vector<std::shared_ptr<SawyerChunk>> Chunks;
+    size_t DecodedLength = 0;
+};
+
+/**
+ * Reads every chunk of an SV6 / SC6 file, mirroring the layout S6Importer expects.
+ */
+static std::vector<std::shared_ptr<SawyerChunk>> read_all_chunks(const std::vector<uint8_t>& data)
+{
+    std::vector<std::shared_ptr<SawyerChunk>> chunks;
+    MemoryStream ms(data.data(), data.size());
+    SawyerChunkReader chunkReader(&ms);
+
+    auto headerChunk = chunkReader.ReadChunk();
+    rct_s6_header header{};
+    std::memcpy(&header, headerChunk->GetData(), std::min(sizeof(header), headerChunk->GetLength()));
+    chunks.push_back(headerChunk);
+
+    if (header.type == S6_TYPE_SCENARIO)
+    {
+        chunks.push_back(chunkReader.ReadChunk());
+    }
+    for (uint16_t i = 0; i < header.num_packed_objects; i++)
+    {
+        ms.ReadValue<rct_object_entry>();
+        chunks.push_back(chunkReader.ReadChunk());
+    }
+
+    // Remaining chunks up to the trailing checksum
+    while (ms.GetPosition() + sizeof(uint32_t) < ms.GetLength())
+    {
+        chunks.push_back(chunkReader.ReadChunk());
+    }
+    return chunks;
+}
+
+static void BM_sawyer_decode(benchmark::State& state, const SawyerBenchFile* file)
+{
+    for (auto _ : state)
+    {
+        auto chunks = read_all_chunks(file->Data);
+        benchmark::DoNotOptimize(chunks);
+    }
+    state.SetBytesProcessed(state.iterations() * file->DecodedLength);
+}
+
+static void BM_sawyer_encode(benchmark::State& state, const SawyerBenchFile* file)
+{
+    for (auto _ : state)
+    {
+        MemoryStream ms(file->Data.size());
+        SawyerChunkWriter chunkWriter(&ms);
+        for (const auto& chunk : file->Chunks)
+        {
+            chunkWriter.WriteChunk(chunk.get());
+        }
+        benchmark::DoNotOptimize(ms.GetData());
+    }
+    state.SetBytesProcessed(state.iterations() * file->DecodedLength);
+}
+
+static void BM_sawyer_checksum(
+    benchmark::State& state, const SawyerBenchFile* file, uint32_t (*checksumFn)(const uint8_t*, size_t))
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(checksumFn(file->Data.data(), file->Data.size()));
+    }
+    state.SetBytesProcessed(state.iterations() * file->Data.size());
+}
+
+static void BM_sawyer_rotate(
+    benchmark::State& state, const SawyerBenchFile* file, void (*rotateFn)(uint8_t*, const uint8_t*, size_t, bool))
+{
+    std::vector<uint8_t> buffer(file->Data.size());
+    for (auto _ : state)
+    {
+        rotateFn(buffer.data(), file->Data.data(), file->Data.size(), false);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * file->Data.size());
+}
+
+static void register_sawyer_benchmarks(const std::string& name, const SawyerBenchFile* file)
+{
+    benchmark::RegisterBenchmark((name + "/decode").c_str(), BM_sawyer_decode, file);
+    benchmark::RegisterBenchmark((name + "/encode").c_str(), BM_sawyer_encode, file);
+    benchmark::RegisterBenchmark(
+        (name + "/checksum/scalar").c_str(), BM_sawyer_checksum, file, sawyercoding_calculate_checksum_scalar);
+    benchmark::RegisterBenchmark(
+        (name + "/rotate/scalar").c_str(), BM_sawyer_rotate, file, sawyercoding_rotate_scalar);
+    if (sse41_available())
+    {
+        benchmark::RegisterBenchmark(
+            (name + "/checksum/sse4_1").c_str(), BM_sawyer_checksum, file, sawyercoding_calculate_checksum_sse4_1);
+        benchmark::RegisterBenchmark(
+            (name + "/rotate/sse4_1").c_str(), BM_sawyer_rotate, file, sawyercoding_rotate_sse4_1);
+    }
+}
+
+static int cmdline_for_bench_sawyer(int argc, const char** argv)
+{
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // The benchmarks keep pointers to the files, so they must not move once registered.
+    std::vector<std::unique_ptr<SawyerBenchFile>> files;
+
+    // Extract file names from argument list. If there is no such file, consider it benchmark option.
+    for (int i = 0; i < argc; i++)
+    {
+        if (platform_file_exists(argv[i]))
+        {
+            auto file = std::make_unique<SawyerBenchFile>();
+            try
+            {
+                file->Data = File::ReadAllBytes(argv[i]);
+                file->Chunks = read_all_chunks(file->Data);
+            }
+            catch (const std::exception& e)
+            {
+                Console::Error::WriteLine("Unable to read '%s': %s", argv[i], e.what());
+                return -1;
+            }
+            for (const auto& chunk : file->Chunks)
+            {
+                file->DecodedLength += chunk->GetLength();
+            }
+            register_sawyer_benchmarks(argv[i], file.get());
+            files.push_back(std::move(file));
+        }
+        else
+        {
+            argv_for_benchmark.push_back((char*)argv[i]);
+        }
+    }
+    // Update argc with all the changes made
+    argc = (int)argv_for_benchmark.size();
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
+
+static exitcode_t HandleBenchSawyer(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_sawyer(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchSawyer(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchSawyerCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "<file>... [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchSawyer),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchSawyer), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -0,0 +1,366 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "CommandLine.hpp"
+
+#ifdef USE_BENCHMARK
+
+#    include "../Context.h"
+#    include "../Game.h"
+#    include "../Intro.h"
+#    include "../OpenRCT2.h"
+#    include "../core/Console.hpp"
+#    include "../platform/platform.h"
+#    include "../ride/TrackData.h"
+#    include "../ride/Vehicle.h"
+#    include "../world/Sprite.h"
+
+#    include <benchmark/benchmark.h>
+#    include <iterator>
+#    include <memory>
+#    include <vector>
+
+struct MoveInfoBenchTrack
+{
+    int32_t Cd;
+    int32_t TypeAndDirection;
+    uint16_t Size;
+};
+
+// The context has to stay alive while the vehicle benchmarks run.
+static std::unique_ptr<OpenRCT2::IContext> _benchVehicleContext;
+
+static std::vector<MoveInfoBenchTrack> get_move_info_tracks()
+{
+    std::vector<MoveInfoBenchTrack> tracks;
+    for (int32_t cd = 0; cd < (int32_t)std::size(gTrackVehicleInfo); cd++)
+    {
+        for (int32_t typeAndDirection = 0; typeAndDirection < 1024; typeAndDirection++)
+        {
+            auto size = vehicle_get_move_info_size(cd, typeAndDirection);
+            if (size != 0)
+            {
+                tracks.push_back({ cd, typeAndDirection, size });
+            }
+        }
+    }
+    return tracks;
+}
+
+/**
+ * Looks the move info up through the nested gTrackVehicleInfo lists, the way it was done before they were flattened.
+ */
+static const rct_vehicle_info* get_move_info_nested(int32_t cd, int32_t typeAndDirection, int32_t offset)
+{
+    static constexpr const rct_vehicle_info zero = {};
+    const auto* list = gTrackVehicleInfo[cd][typeAndDirection];
+    if (offset >= list->size)
+    {
+        return &zero;
+    }
+    return &list->info[offset];
+}
+
+static void BM_move_info_lookup(
+    benchmark::State& state, const rct_vehicle_info* (*lookupFn)(int32_t cd, int32_t typeAndDirection, int32_t offset))
+{
+    auto tracks = get_move_info_tracks();
+    size_t numInfos = 0;
+    for (auto _ : state)
+    {
+        int32_t sum = 0;
+        numInfos = 0;
+        for (const auto& track : tracks)
+        {
+            for (int32_t offset = 0; offset < track.Size; offset++)
+            {
+                auto moveInfo = lookupFn(track.Cd, track.TypeAndDirection, offset);
+                sum += moveInfo->x + moveInfo->y + moveInfo->z + moveInfo->bank_rotation;
+            }
+            numInfos += track.Size;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numInfos);
+}
+
+static void BM_move_info_list(benchmark::State& state)
+{
+    auto tracks = get_move_info_tracks();
+    size_t numInfos = 0;
+    for (auto _ : state)
+    {
+        int32_t sum = 0;
+        numInfos = 0;
+        for (const auto& track : tracks)
+        {
+            auto moveInfoList = vehicle_get_move_info_list(track.Cd, track.TypeAndDirection);
+            for (int32_t offset = 0; offset < moveInfoList.Size; offset++)
+            {
+                auto moveInfo = moveInfoList.Get(offset);
+                sum += moveInfo->x + moveInfo->y + moveInfo->z + moveInfo->bank_rotation;
+            }
+            numInfos += moveInfoList.Size;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * numInfos);
+}
+
+static size_t count_vehicle_cars()
+{
+    size_t numCars = 0;
+    for (uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_VEHICLE_HEAD]; spriteIndex != SPRITE_INDEX_NULL;)
+    {
+        auto train = GET_VEHICLE(spriteIndex);
+        spriteIndex = train->next;
+        for (auto car = train; car != nullptr;)
+        {
+            numCars++;
+            car = car->next_vehicle_on_train == SPRITE_INDEX_NULL ? nullptr : GET_VEHICLE(car->next_vehicle_on_train);
+        }
+    }
+    return numCars;
+}
+
+static void BM_vehicle_update_all(benchmark::State& state)
+{
+    auto numCars = count_vehicle_cars();
+    for (auto _ : state)
+    {
+        vehicle_update_all();
+    }
+    state.SetItemsProcessed(state.iterations() * numCars);
+    state.counters["cars"] = (double)numCars;
+}
+
+// A dodgems arena of BENCH_ARENA_SIZE tiles squared with a car on each tile, surrounded by queues packed with guests.
+static constexpr int32_t BENCH_ARENA_START = 64;
+static constexpr int32_t BENCH_ARENA_SIZE = 8;
+static constexpr int32_t BENCH_QUEUE_WIDTH = 2;
+static constexpr int32_t BENCH_QUEUE_GUESTS = 4000;
+static constexpr int32_t BENCH_ARENA_Z = 112;
+
+static bool is_in_bench_arena(int32_t tileX, int32_t tileY)
+{
+    return tileX >= BENCH_ARENA_START && tileX < BENCH_ARENA_START + BENCH_ARENA_SIZE && tileY >= BENCH_ARENA_START
+        && tileY < BENCH_ARENA_START + BENCH_ARENA_SIZE;
+}
+
+static rct_sprite* create_bench_sprite(SPRITE_IDENTIFIER spriteIdentifier, int32_t x, int32_t y)
+{
+    auto sprite = create_sprite(spriteIdentifier);
+    if (sprite != nullptr)
+    {
+        sprite->generic.sprite_identifier = spriteIdentifier;
+        sprite_move(x, y, BENCH_ARENA_Z, sprite);
+    }
+    return sprite;
+}
+
+static std::vector<rct_sprite*> create_crowded_arena()
+{
+    // Without a park there is nothing in the sprite list to keep
+    if (_benchVehicleContext == nullptr)
+    {
+        reset_sprite_list();
+    }
+
+    std::vector<rct_sprite*> sprites;
+    for (int32_t tileX = BENCH_ARENA_START; tileX < BENCH_ARENA_START + BENCH_ARENA_SIZE; tileX++)
+    {
+        for (int32_t tileY = BENCH_ARENA_START; tileY < BENCH_ARENA_START + BENCH_ARENA_SIZE; tileY++)
+        {
+            auto sprite = create_bench_sprite(SPRITE_IDENTIFIER_VEHICLE, tileX * 32 + 16, tileY * 32 + 16);
+            if (sprite != nullptr)
+            {
+                sprites.push_back(sprite);
+            }
+        }
+    }
+
+    std::vector<TileCoordsXY> queueTiles;
+    constexpr int32_t queueStart = BENCH_ARENA_START - BENCH_QUEUE_WIDTH;
+    constexpr int32_t queueEnd = BENCH_ARENA_START + BENCH_ARENA_SIZE + BENCH_QUEUE_WIDTH;
+    for (int32_t tileX = queueStart; tileX < queueEnd; tileX++)
+    {
+        for (int32_t tileY = queueStart; tileY < queueEnd; tileY++)
+        {
+            if (!is_in_bench_arena(tileX, tileY))
+            {
+                queueTiles.push_back({ tileX, tileY });
+            }
+        }
+    }
+    for (int32_t i = 0; i < BENCH_QUEUE_GUESTS; i++)
+    {
+        const auto& tile = queueTiles[i % queueTiles.size()];
+        auto sprite = create_bench_sprite(SPRITE_IDENTIFIER_PEEP, tile.x * 32 + (i % 32), tile.y * 32 + (i / 32) % 32);
+        if (sprite == nullptr)
+        {
+            break;
+        }
+        sprites.push_back(sprite);
+    }
+    return sprites;
+}
+
+/**
+ * Walks the 3x3 tiles around every car of the arena the way the vehicle collision detection does, either through the
+ * quadrant lists shared by all sprites or through the vehicle only ones.
+ */
+static void BM_vehicle_collision_neighbours(benchmark::State& state, bool vehiclesOnly)
+{
+    auto sprites = create_crowded_arena();
+    std::vector<rct_sprite*> cars;
+    for (auto sprite : sprites)
+    {
+        if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+        {
+            cars.push_back(sprite);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        int32_t numNeighbours = 0;
+        for (auto car : cars)
+        {
+            for (int32_t offsetX = -32; offsetX <= 32; offsetX += 32)
+            {
+                for (int32_t offsetY = -32; offsetY <= 32; offsetY += 32)
+                {
+                    int32_t x = car->generic.x + offsetX;
+                    int32_t y = car->generic.y + offsetY;
+                    if (vehiclesOnly)
+                    {
+                        auto spriteIndex = sprite_get_first_vehicle_in_quadrant(x, y);
+                        for (; spriteIndex != SPRITE_INDEX_NULL; spriteIndex = sprite_get_next_vehicle_in_quadrant(spriteIndex))
+                        {
+                            numNeighbours++;
+                        }
+                    }
+                    else
+                    {
+                        for (auto spriteIndex = sprite_get_first_in_quadrant(x, y); spriteIndex != SPRITE_INDEX_NULL;)
+                        {
+                            auto sprite = get_sprite(spriteIndex);
+                            if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+                            {
+                                numNeighbours++;
+                            }
+                            spriteIndex = sprite->generic.next_in_quadrant;
+                        }
+                    }
+                }
+            }
+        }
+        benchmark::DoNotOptimize(numNeighbours);
+    }
+    state.SetItemsProcessed(state.iterations() * cars.size());
+
+    for (auto sprite : sprites)
+    {
+        sprite_remove(sprite);
+    }
+}
+
+static bool load_bench_park(const char* path)
+{
+    core_init();
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    _benchVehicleContext = OpenRCT2::CreateContext();
+    if (!_benchVehicleContext->Initialise() || !_benchVehicleContext->LoadParkFromFile(path))
+    {
+        Console::Error::WriteLine("Failed to load park '%s'.", path);
+        return false;
+    }
+    gIntroState = INTRO_STATE_NONE;
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    return true;
+}
+
+static int cmdline_for_bench_vehicle_motion(int argc, const char** argv)
+{
+    benchmark::RegisterBenchmark("move_info/nested", BM_move_info_lookup, get_move_info_nested);
+    benchmark::RegisterBenchmark("move_info/flat", BM_move_info_lookup, vehicle_get_move_info);
+    benchmark::RegisterBenchmark("move_info/list", BM_move_info_list);
+    benchmark::RegisterBenchmark("vehicle_collision/all_sprites", BM_vehicle_collision_neighbours, false);
+    benchmark::RegisterBenchmark("vehicle_collision/vehicles_only", BM_vehicle_collision_neighbours, true);
+
+    // Google benchmark does stuff to argv. It doesn't modify the pointees,
+    // but it wants to reorder the pointers, so present a copy of them.
+    std::vector<char*> argv_for_benchmark;
+
+    // argv[0] is expected to contain the binary name. It's only for logging purposes, don't bother.
+    argv_for_benchmark.push_back(nullptr);
+
+    // The first existing file is the park whose trains are updated, the context only holds one park at a time.
+    bool parkLoaded = false;
+    for (int i = 0; i < argc; i++)
+    {
+        if (!parkLoaded && platform_file_exists(argv[i]))
+        {
+            if (!load_bench_park(argv[i]))
+            {
+                return -1;
+            }
+            benchmark::RegisterBenchmark(argv[i], BM_vehicle_update_all);
+            parkLoaded = true;
+        }
+        else
+        {
+            argv_for_benchmark.push_back((char*)argv[i]);
+        }
+    }
+    // Update argc with all the changes made
+    argc = (int)argv_for_benchmark.size();
+    ::benchmark::Initialize(&argc, &argv_for_benchmark[0]);
+    if (::benchmark::ReportUnrecognizedArguments(argc, &argv_for_benchmark[0]))
+        return -1;
+    ::benchmark::RunSpecifiedBenchmarks();
+    _benchVehicleContext = nullptr;
+    return 0;
+}
+
+static exitcode_t HandleBenchVehicleMotion(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+    int32_t result = cmdline_for_bench_vehicle_motion(argc, argv);
+    if (result < 0)
+    {
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+#else
+static exitcode_t HandleBenchVehicleMotion(CommandLineArgEnumerator* argEnumerator)
+{
+    log_error("Sorry, Google benchmark not enabled in this build");
+    return EXITCODE_FAIL;
+}
+#endif // USE_BENCHMARK
+
+const CommandLineCommand CommandLine::BenchVehicleMotionCommands[]{
+#ifdef USE_BENCHMARK
+    DefineCommand(
+        "",
+        "[<file>] [--benchmark_list_tests={true|false}] [--benchmark_filter=<regex>] [--benchmark_min_time=<min_time>] "
+        "[--benchmark_repetitions=<num_repetitions>] [--benchmark_report_aggregates_only={true|false}] "
+        "[--benchmark_format=<console|json|csv>] [--benchmark_out=<filename>] [--benchmark_out_format=<json|console|csv>] "
+        "[--benchmark_color={auto|true|false}] [--benchmark_counters_tabular={true|false}] [--v=<verbosity>]",
+        nullptr, HandleBenchVehicleMotion),
+    CommandTableEnd
+#else
+    DefineCommand("", "*** SORRY NOT ENABLED IN THIS BUILD ***", nullptr, HandleBenchVehicleMotion), CommandTableEnd
+#endif // USE_BENCHMARK
+};
@@ -11,6 +11,9 @@
 
 #include "../common.h"
 
+#include <string>
+#include <vector>
+
 /**
  * Class for enumerating and retrieving values for a set of command line arguments.
  */
@@ -118,13 +121,32 @@ namespace CommandLine
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand BenchGfxCommands[];
     extern const CommandLineCommand BenchSpriteSortCommands[];
+    extern const CommandLineCommand BenchSawyerCommands[];
+    extern const CommandLineCommand BenchImageImporterCommands[];
+    extern const CommandLineCommand BenchObjectSelectionCommands[];
+    extern const CommandLineCommand BenchVehicleMotionCommands[];
+    extern const CommandLineCommand BenchPaintCommands[];
     extern const CommandLineCommand SimulateCommands[];
+    extern const CommandLineCommand ReplayCommands[];
+    extern const CommandLineCommand ReplayVerifyCommands[];
+    extern const CommandLineCommand RateDesignsCommands[];
 
     extern const CommandLineExample RootExamples[];
 
     void PrintHelp(bool allCommands = false);
     exitcode_t HandleCommandDefault();
 
+    /**
+     * Sets the data paths passed as options like the standard options do and frees the option values. Used by
+     * commands that start worker processes, which do not get the standard options.
+     */
+    void SetCustomDataPaths(utf8* userDataPath, utf8* openrctDataPath, utf8* rct2DataPath);
+
+    /**
+     * Gets the options that make a worker process use the same data paths as this process.
+     */
+    std::vector<std::string> GetCustomDataPathOptions();
+
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator* enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator* enumerator);
 } // namespace CommandLine
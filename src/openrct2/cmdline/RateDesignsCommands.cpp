@@ -0,0 +1,400 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Cheats.h"
+#include "../Context.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../actions/RideSetStatus.hpp"
+#include "../actions/TrackDesignAction.h"
+#include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/JobPool.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../object/ObjectManager.h"
+#include "../platform/Platform2.h"
+#include "../platform/platform.h"
+#include "../ride/Ride.h"
+#include "../ride/RideRatings.h"
+#include "../ride/TrackDesign.h"
+#include "../world/Map.h"
+#include "../world/Park.h"
+#include "../world/Surface.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _rateDesignsJobs = 0;
+static int32_t _rateDesignsMaxTicks = 0;
+static utf8* _rateDesignsOutputPath = nullptr;
+static utf8* _rateDesignsUserDataPath = nullptr;
+static utf8* _rateDesignsOpenrctDataPath = nullptr;
+static utf8* _rateDesignsRct2DataPath = nullptr;
+
+// Prefix of the line a rating worker prints its result on, everything else on stdout is ignored.
+static constexpr const char* RateDesignsResultPrefix = "rate-designs-result";
+
+// Size of the scratch park each design is placed into, large enough for any design saved by the game.
+static constexpr int32_t RateDesignsMapSize = 256;
+static constexpr int32_t RateDesignsDefaultMaxTicks = 100000;
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition RateDesignsOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_rateDesignsJobs,       'j', "jobs",   "number of designs to rate in parallel (default: number of cores)" },
+    { CMDLINE_TYPE_INTEGER, &_rateDesignsMaxTicks,   NAC, "ticks",  "maximum number of ticks to wait for a test run to finish" },
+    { CMDLINE_TYPE_STRING,  &_rateDesignsOutputPath, 'o', "output", "write the CSV to the given file instead of stdout" },
+    { CMDLINE_TYPE_STRING,  &_rateDesignsUserDataPath,    NAC, "user-data-path",    "path to the user data directory (containing config.ini)"    },
+    { CMDLINE_TYPE_STRING,  &_rateDesignsOpenrctDataPath, NAC, "openrct-data-path", "path to the OpenRCT2 data directory (containing languages)" },
+    { CMDLINE_TYPE_STRING,  &_rateDesignsRct2DataPath,    NAC, "rct2-data-path",    "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    OptionTableEnd
+};
+
+static exitcode_t HandleRateDesigns(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::RateDesignsCommands[]
+{
+    // Main commands
+    DefineCommand("", "<directory|design>", RateDesignsOptionsDef, HandleRateDesigns),
+    CommandTableEnd
+};
+// clang-format on
+
+enum class RateDesignStatus
+{
+    RATED,
+    UNTESTED,
+    ERROR,
+};
+
+struct RateDesignResult
+{
+    std::string Path;
+    RateDesignStatus Status = RateDesignStatus::ERROR;
+    ride_rating Excitement = RIDE_RATING_UNDEFINED;
+    ride_rating Intensity = RIDE_RATING_UNDEFINED;
+    ride_rating Nausea = RIDE_RATING_UNDEFINED;
+    fixed16_2dp MaxPositiveVerticalG = 0;
+    fixed16_2dp MaxNegativeVerticalG = 0;
+    fixed16_2dp MaxLateralG = 0;
+    int32_t Length = 0;
+};
+
+static const char* GetRateDesignStatusName(RateDesignStatus status)
+{
+    switch (status)
+    {
+        case RateDesignStatus::RATED:
+            return "rated";
+        case RateDesignStatus::UNTESTED:
+            return "untested";
+        default:
+            return "error";
+    }
+}
+
+/**
+ * Resets the map to an empty, flat park with everything needed to build and test the design, always the same way so
+ * that a design gets the same ratings every time it is rated.
+ */
+static bool PrepareScratchPark(IContext& context, TrackDesign& td)
+{
+    object_manager_unload_all_objects();
+    if (object_manager_load_object(&td.vehicle_object) == nullptr)
+    {
+        return false;
+    }
+    for (const auto& scenery : td.scenery_elements)
+    {
+        object_manager_load_object(&scenery.scenery_object);
+    }
+
+    context.GetGameState()->InitAll(RateDesignsMapSize);
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    gParkFlags |= PARK_FLAGS_NO_MONEY;
+    gCheatsSandboxMode = true;
+    gCheatsIgnoreResearchStatus = true;
+    gCheatsDisableAllBreakdowns = true;
+    return true;
+}
+
+/**
+ * Places the design in the middle of the scratch park, at the lowest height it fits at.
+ */
+static ride_id_t PlaceDesign(TrackDesign& td)
+{
+    CoordsXY loc = { RateDesignsMapSize * 16, RateDesignsMapSize * 16 };
+    auto surfaceElement = map_get_surface_element_at(loc);
+    if (surfaceElement == nullptr)
+    {
+        return RIDE_ID_NULL;
+    }
+
+    _currentTrackPieceDirection = 0;
+    int32_t z = surfaceElement->GetBaseZ();
+    z += place_virtual_track(&td, PTD_OPERATION_GET_PLACE_Z, true, GetOrAllocateRide(0), loc.x, loc.y, z);
+
+    for (int32_t i = 0; i < 7; i++, z += 8)
+    {
+        auto tdAction = TrackDesignAction({ loc.x, loc.y, z, 0 }, td);
+        tdAction.SetFlags(GAME_COMMAND_FLAG_NO_SPEND);
+        if (GameActions::Query(&tdAction)->Error != GA_ERROR::OK)
+        {
+            continue;
+        }
+
+        auto res = GameActions::Execute(&tdAction);
+        if (res->Error == GA_ERROR::OK)
+        {
+            return static_cast<TrackDesignActionResult*>(res.get())->rideIndex;
+        }
+        break;
+    }
+    return RIDE_ID_NULL;
+}
+
+/**
+ * Builds and tests a single design in this process and prints the result on one line for the parent process.
+ */
+static exitcode_t RateSingleDesign(const std::string& designPath)
+{
+    core_init();
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    RateDesignResult result;
+    std::unique_ptr<IContext> context(CreateContext());
+    auto td = track_design_open(designPath.c_str());
+    if (td != nullptr && context->Initialise() && PrepareScratchPark(*context, *td))
+    {
+        auto rideIndex = PlaceDesign(*td);
+        auto ride = get_ride(rideIndex);
+        if (ride != nullptr)
+        {
+            auto setStatusAction = RideSetStatusAction(rideIndex, RIDE_STATUS_TESTING);
+            if (GameActions::Execute(&setStatusAction)->Error == GA_ERROR::OK)
+            {
+                auto* gameState = context->GetGameState();
+                int32_t maxTicks = _rateDesignsMaxTicks > 0 ? _rateDesignsMaxTicks : RateDesignsDefaultMaxTicks;
+                for (int32_t i = 0; i < maxTicks && !(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED); i++)
+                {
+                    gameState->UpdateLogic();
+                }
+
+                if (ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED)
+                {
+                    // Rate straight away instead of waiting for the in-game schedule to get to the ride.
+                    ride_ratings_update_rides({ rideIndex });
+                    result.Status = RateDesignStatus::RATED;
+                }
+                else
+                {
+                    result.Status = RateDesignStatus::UNTESTED;
+                }
+                result.Excitement = ride->excitement;
+                result.Intensity = ride->intensity;
+                result.Nausea = ride->nausea;
+                result.MaxPositiveVerticalG = ride->max_positive_vertical_g;
+                result.MaxNegativeVerticalG = ride->max_negative_vertical_g;
+                result.MaxLateralG = ride->max_lateral_g;
+                result.Length = ride_get_total_length(ride) >> 16;
+            }
+        }
+    }
+
+    Console::WriteLine(
+        "%s %s %d %d %d %d %d %d %d", RateDesignsResultPrefix, GetRateDesignStatusName(result.Status), result.Excitement,
+        result.Intensity, result.Nausea, result.MaxPositiveVerticalG, result.MaxNegativeVerticalG, result.MaxLateralG,
+        result.Length);
+    return result.Status == RateDesignStatus::RATED ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+static void ParseWorkerOutput(const std::string& output, RateDesignResult& result)
+{
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        if (!String::StartsWith(line.c_str(), RateDesignsResultPrefix))
+            continue;
+
+        std::istringstream fields(line.substr(strlen(RateDesignsResultPrefix)));
+        std::string status;
+        int32_t excitement, intensity, nausea, maxPositiveVerticalG, maxNegativeVerticalG, maxLateralG;
+        fields >> status >> excitement >> intensity >> nausea >> maxPositiveVerticalG >> maxNegativeVerticalG >> maxLateralG
+            >> result.Length;
+        result.Excitement = (ride_rating)excitement;
+        result.Intensity = (ride_rating)intensity;
+        result.Nausea = (ride_rating)nausea;
+        result.MaxPositiveVerticalG = (fixed16_2dp)maxPositiveVerticalG;
+        result.MaxNegativeVerticalG = (fixed16_2dp)maxNegativeVerticalG;
+        result.MaxLateralG = (fixed16_2dp)maxLateralG;
+        if (status == "rated")
+            result.Status = RateDesignStatus::RATED;
+        else if (status == "untested")
+            result.Status = RateDesignStatus::UNTESTED;
+        else
+            result.Status = RateDesignStatus::ERROR;
+    }
+}
+
+static std::string FormatFixed2dp(int32_t value)
+{
+    return String::StdFormat("%.2f", value / 100.0);
+}
+
+static std::string FormatRating(ride_rating value)
+{
+    return value == RIDE_RATING_UNDEFINED ? std::string() : FormatFixed2dp(value);
+}
+
+static std::string EscapeCsv(const std::string& value)
+{
+    std::string escaped = "\"";
+    for (char c : value)
+    {
+        if (c == '"')
+            escaped += '"';
+        escaped += c;
+    }
+    escaped += '"';
+    return escaped;
+}
+
+static void WriteRateDesignsCsv(std::ostream& os, const std::vector<RateDesignResult>& results)
+{
+    os << "path,status,excitement,intensity,nausea,max_positive_vertical_g,max_negative_vertical_g,max_lateral_g,length\n";
+    for (const auto& result : results)
+    {
+        os << EscapeCsv(result.Path) << ',' << GetRateDesignStatusName(result.Status);
+        if (result.Status == RateDesignStatus::ERROR)
+        {
+            os << ",,,,,,,\n";
+            continue;
+        }
+        os << ',' << FormatRating(result.Excitement) << ',' << FormatRating(result.Intensity) << ','
+           << FormatRating(result.Nausea) << ',' << FormatFixed2dp(result.MaxPositiveVerticalG) << ','
+           << FormatFixed2dp(result.MaxNegativeVerticalG) << ',' << FormatFixed2dp(result.MaxLateralG) << ','
+           << result.Length << '\n';
+    }
+}
+
+static exitcode_t HandleRateDesigns(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* rawPath;
+    if (!argEnumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected a track design directory or file.");
+        return EXITCODE_FAIL;
+    }
+
+    // Workers are given the same data paths, so they load the same objects
+    CommandLine::SetCustomDataPaths(_rateDesignsUserDataPath, _rateDesignsOpenrctDataPath, _rateDesignsRct2DataPath);
+    auto workerOptions = CommandLine::GetCustomDataPathOptions();
+
+    std::string inputPath = Path::GetAbsolute(rawPath);
+    if (!Path::DirectoryExists(inputPath))
+    {
+        if (!File::Exists(inputPath))
+        {
+            Console::Error::WriteLine("'%s' does not exist.", inputPath.c_str());
+            return EXITCODE_FAIL;
+        }
+
+        // Worker mode, also usable to rate a single design.
+        return RateSingleDesign(inputPath);
+    }
+
+    std::vector<RateDesignResult> results;
+    auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(Path::Combine(inputPath, "*.td4;*.td6"), true));
+    while (scanner->Next())
+    {
+        RateDesignResult result;
+        result.Path = scanner->GetPath();
+        results.push_back(result);
+    }
+    std::sort(results.begin(), results.end(), [](const RateDesignResult& a, const RateDesignResult& b) {
+        return a.Path < b.Path;
+    });
+
+    if (results.empty())
+    {
+        Console::Error::WriteLine("No track designs found in '%s'.", inputPath.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    size_t numJobs = _rateDesignsJobs > 0 ? (size_t)_rateDesignsJobs : std::max<size_t>(1, std::thread::hardware_concurrency());
+    Console::Error::WriteLine("Rating %zu track designs using %zu jobs...", results.size(), numJobs);
+
+    // The context is a singleton, so every design is built and tested in its own worker process.
+    auto executablePath = Platform::GetCurrentExecutablePath();
+    if (_rateDesignsMaxTicks > 0)
+    {
+        workerOptions.push_back("--ticks");
+        workerOptions.push_back(std::to_string(_rateDesignsMaxTicks));
+    }
+    {
+        JobPool jobPool(numJobs);
+        for (auto& result : results)
+        {
+            auto* resultPtr = &result;
+            jobPool.AddTask(
+                [resultPtr, &executablePath, &workerOptions]() {
+                    std::vector<std::string> args{ executablePath, "rate-designs", resultPtr->Path };
+                    args.insert(args.end(), workerOptions.begin(), workerOptions.end());
+                    std::string output;
+                    Platform::Execute(args, &output);
+                    ParseWorkerOutput(output, *resultPtr);
+                },
+                [resultPtr]() {
+                    Console::Error::WriteLine(
+                        "[%-8s] %s", GetRateDesignStatusName(resultPtr->Status), resultPtr->Path.c_str());
+                });
+        }
+        jobPool.Join();
+    }
+
+    auto numRated = std::count_if(results.begin(), results.end(), [](const RateDesignResult& result) {
+        return result.Status == RateDesignStatus::RATED;
+    });
+    Console::Error::WriteLine("%zu/%zu track designs rated", (size_t)numRated, results.size());
+
+    std::ostringstream csv;
+    WriteRateDesignsCsv(csv, results);
+    auto csvText = csv.str();
+    if (_rateDesignsOutputPath != nullptr)
+    {
+        try
+        {
+            File::WriteAllBytes(_rateDesignsOutputPath, csvText.data(), csvText.size());
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to write '%s': %s", _rateDesignsOutputPath, e.what());
+            return EXITCODE_FAIL;
+        }
+    }
+    else
+    {
+        Console::Write(csvText.c_str());
+    }
+
+    return (size_t)numRated == results.size() ? EXITCODE_OK : EXITCODE_FAIL;
+}
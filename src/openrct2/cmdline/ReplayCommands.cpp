@@ -0,0 +1,447 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../Context.h"
+#include "../Game.h"
+#include "../GameState.h"
+#include "../OpenRCT2.h"
+#include "../ReplayManager.h"
+#include "../core/Console.hpp"
+#include "../core/FileScanner.h"
+#include "../core/JobPool.hpp"
+#include "../core/Json.hpp"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+#include "../drawing/Drawing.h"
+#include "../interface/Screenshot.h"
+#include "../platform/Platform2.h"
+#include "../platform/platform.h"
+#include "../world/Sprite.h"
+#include "CommandLine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace OpenRCT2;
+
+static int32_t _seekTick = -1;
+static int32_t _verifyJobs = 0;
+static utf8* _verifyJsonPath = nullptr;
+static utf8* _verifyJUnitPath = nullptr;
+static utf8* _verifyUserDataPath = nullptr;
+static utf8* _verifyOpenrctDataPath = nullptr;
+static utf8* _verifyRct2DataPath = nullptr;
+
+// Prefix of the line a verification worker prints its result on, everything else on stdout is ignored.
+static constexpr const char* ReplayVerifyResultPrefix = "replay-verify-result";
+
+// clang-format off
+static constexpr const CommandLineOptionDefinition ReplayOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_seekTick, NAC, "seek", "tick relative to the start of the replay to jump to" },
+    OptionTableEnd
+};
+
+static constexpr const CommandLineOptionDefinition ReplayVerifyOptionsDef[]
+{
+    { CMDLINE_TYPE_INTEGER, &_verifyJobs,      'j', "jobs",  "number of replays to run in parallel (default: number of cores)" },
+    { CMDLINE_TYPE_STRING,  &_verifyJsonPath,  NAC, "json",  "write the results as JSON to the given file" },
+    { CMDLINE_TYPE_STRING,  &_verifyJUnitPath, NAC, "junit", "write the results as JUnit XML to the given file" },
+    { CMDLINE_TYPE_STRING,  &_verifyUserDataPath,    NAC, "user-data-path",    "path to the user data directory (containing config.ini)"    },
+    { CMDLINE_TYPE_STRING,  &_verifyOpenrctDataPath, NAC, "openrct-data-path", "path to the OpenRCT2 data directory (containing languages)" },
+    { CMDLINE_TYPE_STRING,  &_verifyRct2DataPath,    NAC, "rct2-data-path",    "path to the RollerCoaster Tycoon 2 data directory (containing data/g1.dat)" },
+    OptionTableEnd
+};
+
+static exitcode_t HandleReplay(CommandLineArgEnumerator *argEnumerator);
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator *argEnumerator);
+
+const CommandLineCommand CommandLine::ReplayCommands[]
+{
+    // Main commands
+    DefineCommand("", "<replay> <output_image> [<width> <height>]", ReplayOptionsDef, HandleReplay),
+    CommandTableEnd
+};
+
+const CommandLineCommand CommandLine::ReplayVerifyCommands[]
+{
+    // Main commands
+    DefineCommand("", "<directory|replay>", ReplayVerifyOptionsDef, HandleReplayVerify),
+    CommandTableEnd
+};
+// clang-format on
+
+enum class ReplayVerifyStatus
+{
+    PASSED,
+    MISMATCH,
+    ERROR,
+};
+
+struct ReplayVerifyResult
+{
+    std::string Path;
+    ReplayVerifyStatus Status = ReplayVerifyStatus::ERROR;
+    uint32_t Ticks = 0;
+    double Seconds = 0;
+    int32_t MismatchIndex = -1;
+};
+
+static const char* GetReplayVerifyStatusName(ReplayVerifyStatus status)
+{
+    switch (status)
+    {
+        case ReplayVerifyStatus::PASSED:
+            return "passed";
+        case ReplayVerifyStatus::MISMATCH:
+            return "mismatch";
+        default:
+            return "error";
+    }
+}
+
+static double GetTicksPerSecond(const ReplayVerifyResult& result)
+{
+    return result.Seconds > 0 ? result.Ticks / result.Seconds : 0;
+}
+
+static exitcode_t HandleReplay(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = (const char**)argEnumerator->GetArguments() + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    // Don't include options in the count (they have been handled by CommandLine::ParseOptions already)
+    for (int32_t i = 0; i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            argc = i;
+            break;
+        }
+    }
+
+    if (argc != 2 && argc != 4)
+    {
+        Console::Error::WriteLine("Usage: openrct2 replay <replay> <output_image> [<width> <height>] [--seek <tick>]");
+        return EXITCODE_FAIL;
+    }
+
+    core_init();
+
+    const char* replayPath = argv[0];
+    const char* outputPath = argv[1];
+    int32_t width = argc == 4 ? std::atoi(argv[2]) : 0;
+    int32_t height = argc == 4 ? std::atoi(argv[3]) : 0;
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    drawing_engine_init();
+
+    auto* replayManager = context->GetReplayManager();
+    if (!replayManager->StartPlayback(replayPath))
+    {
+        Console::Error::WriteLine("Unable to start replay '%s'.", replayPath);
+        drawing_engine_dispose();
+        return EXITCODE_FAIL;
+    }
+
+    if (_seekTick >= 0)
+    {
+        Console::WriteLine("Seeking to tick %d...", _seekTick);
+        if (!replayManager->SeekToTick((uint32_t)_seekTick))
+        {
+            Console::Error::WriteLine("Unable to seek to tick %d.", _seekTick);
+            drawing_engine_dispose();
+            return EXITCODE_FAIL;
+        }
+    }
+    Console::WriteLine("Tick %u: %s", gCurrentTicks, sprite_checksum().ToString().c_str());
+
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+    bool result = screenshot_dump_park(outputPath, width, height);
+    drawing_engine_dispose();
+    if (!result)
+    {
+        Console::Error::WriteLine("Unable to write screenshot to '%s'.", outputPath);
+        return EXITCODE_FAIL;
+    }
+    return EXITCODE_OK;
+}
+
+/**
+ * Plays a single replay in this process and prints the result on one line for the parent process.
+ */
+static exitcode_t VerifySingleReplay(const std::string& replayPath)
+{
+    core_init();
+
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    ReplayVerifyResult result;
+    std::unique_ptr<IContext> context(CreateContext());
+    if (context->Initialise())
+    {
+        auto* gameState = context->GetGameState();
+        auto* replayManager = context->GetReplayManager();
+        if (replayManager->StartPlayback(replayPath))
+        {
+            auto startTick = gCurrentTicks;
+            auto startTime = std::chrono::high_resolution_clock::now();
+            while (replayManager->IsReplaying())
+            {
+                gameState->UpdateLogic();
+                if (replayManager->IsPlaybackStateMismatching())
+                {
+                    // Everything past the first mismatch is meaningless.
+                    replayManager->StopPlayback();
+                    break;
+                }
+            }
+            auto endTime = std::chrono::high_resolution_clock::now();
+
+            result.Ticks = gCurrentTicks - startTick;
+            result.Seconds = std::chrono::duration<double>(endTime - startTime).count();
+            result.MismatchIndex = replayManager->GetMismatchingChecksumIndex();
+            result.Status = result.MismatchIndex == -1 ? ReplayVerifyStatus::PASSED : ReplayVerifyStatus::MISMATCH;
+        }
+    }
+
+    Console::WriteLine(
+        "%s %s %u %f %d", ReplayVerifyResultPrefix, GetReplayVerifyStatusName(result.Status), result.Ticks, result.Seconds,
+        result.MismatchIndex);
+    return result.Status == ReplayVerifyStatus::PASSED ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+static void ParseWorkerOutput(const std::string& output, ReplayVerifyResult& result)
+{
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line))
+    {
+        if (!String::StartsWith(line.c_str(), ReplayVerifyResultPrefix))
+            continue;
+
+        std::istringstream fields(line.substr(strlen(ReplayVerifyResultPrefix)));
+        std::string status;
+        fields >> status >> result.Ticks >> result.Seconds >> result.MismatchIndex;
+        if (status == "passed")
+            result.Status = ReplayVerifyStatus::PASSED;
+        else if (status == "mismatch")
+            result.Status = ReplayVerifyStatus::MISMATCH;
+        else
+            result.Status = ReplayVerifyStatus::ERROR;
+    }
+}
+
+static void WriteReplayVerifyJson(const std::string& path, const std::vector<ReplayVerifyResult>& results, double seconds)
+{
+    json_t* jsonReplays = json_array();
+    uint32_t numFailed = 0;
+    for (const auto& result : results)
+    {
+        json_t* jsonReplay = json_object();
+        json_object_set_new(jsonReplay, "path", json_string(result.Path.c_str()));
+        json_object_set_new(jsonReplay, "status", json_string(GetReplayVerifyStatusName(result.Status)));
+        json_object_set_new(jsonReplay, "ticks", json_integer(result.Ticks));
+        json_object_set_new(jsonReplay, "seconds", json_real(result.Seconds));
+        json_object_set_new(jsonReplay, "ticksPerSecond", json_real(GetTicksPerSecond(result)));
+        json_object_set_new(jsonReplay, "mismatchIndex", json_integer(result.MismatchIndex));
+        json_array_append_new(jsonReplays, jsonReplay);
+
+        if (result.Status != ReplayVerifyStatus::PASSED)
+            numFailed++;
+    }
+
+    json_t* jsonRoot = json_object();
+    json_object_set_new(jsonRoot, "total", json_integer(results.size()));
+    json_object_set_new(jsonRoot, "failed", json_integer(numFailed));
+    json_object_set_new(jsonRoot, "seconds", json_real(seconds));
+    json_object_set_new(jsonRoot, "replays", jsonReplays);
+
+    Json::WriteToFile(path.c_str(), jsonRoot, JSON_INDENT(4) | JSON_PRESERVE_ORDER);
+    json_decref(jsonRoot);
+}
+
+static std::string EscapeXml(const std::string& value)
+{
+    std::string escaped;
+    for (char c : value)
+    {
+        switch (c)
+        {
+            case '&':
+                escaped += "&amp;";
+                break;
+            case '<':
+                escaped += "&lt;";
+                break;
+            case '>':
+                escaped += "&gt;";
+                break;
+            case '"':
+                escaped += "&quot;";
+                break;
+            default:
+                escaped += c;
+                break;
+        }
+    }
+    return escaped;
+}
+
+static void WriteReplayVerifyJUnit(const std::string& path, const std::vector<ReplayVerifyResult>& results, double seconds)
+{
+    auto numFailures = std::count_if(results.begin(), results.end(), [](const ReplayVerifyResult& result) {
+        return result.Status == ReplayVerifyStatus::MISMATCH;
+    });
+    auto numErrors = std::count_if(results.begin(), results.end(), [](const ReplayVerifyResult& result) {
+        return result.Status == ReplayVerifyStatus::ERROR;
+    });
+
+    std::ofstream fs(path);
+    fs << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    fs << String::StdFormat(
+        "<testsuite name=\"replay-verify\" tests=\"%zu\" failures=\"%d\" errors=\"%d\" time=\"%f\">\n",
+        results.size(), (int32_t)numFailures, (int32_t)numErrors, seconds);
+    for (const auto& result : results)
+    {
+        auto name = EscapeXml(Path::GetFileNameWithoutExtension(result.Path));
+        fs << String::StdFormat(
+            "  <testcase classname=\"replay\" name=\"%s\" time=\"%f\">\n", name.c_str(), result.Seconds);
+        if (result.Status == ReplayVerifyStatus::MISMATCH)
+        {
+            fs << String::StdFormat(
+                "    <failure message=\"Checksum mismatch at index %d\"/>\n", result.MismatchIndex);
+        }
+        else if (result.Status == ReplayVerifyStatus::ERROR)
+        {
+            fs << "    <error message=\"Unable to play replay\"/>\n";
+        }
+        fs << String::StdFormat(
+            "    <system-out>%s: %u ticks, %.0f ticks/s</system-out>\n", EscapeXml(result.Path).c_str(), result.Ticks,
+            GetTicksPerSecond(result));
+        fs << "  </testcase>\n";
+    }
+    fs << "</testsuite>\n";
+}
+
+static exitcode_t HandleReplayVerify(CommandLineArgEnumerator* argEnumerator)
+{
+    const char* rawPath;
+    if (!argEnumerator->TryPopString(&rawPath))
+    {
+        Console::Error::WriteLine("Expected a replay directory or file.");
+        return EXITCODE_FAIL;
+    }
+
+    // Workers are given the same data paths, so they load the same objects
+    CommandLine::SetCustomDataPaths(_verifyUserDataPath, _verifyOpenrctDataPath, _verifyRct2DataPath);
+    auto dataPathOptions = CommandLine::GetCustomDataPathOptions();
+
+    std::string inputPath = Path::GetAbsolute(rawPath);
+    if (!Path::DirectoryExists(inputPath))
+    {
+        // Worker mode, also usable to verify a single replay.
+        return VerifySingleReplay(inputPath);
+    }
+
+    std::vector<ReplayVerifyResult> results;
+    auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(Path::Combine(inputPath, "*.sv6r"), true));
+    while (scanner->Next())
+    {
+        ReplayVerifyResult result;
+        result.Path = scanner->GetPath();
+        results.push_back(result);
+    }
+    std::sort(results.begin(), results.end(), [](const ReplayVerifyResult& a, const ReplayVerifyResult& b) {
+        return a.Path < b.Path;
+    });
+
+    if (results.empty())
+    {
+        Console::Error::WriteLine("No replays found in '%s'.", inputPath.c_str());
+        return EXITCODE_FAIL;
+    }
+
+    size_t numJobs = _verifyJobs > 0 ? (size_t)_verifyJobs : std::max<size_t>(1, std::thread::hardware_concurrency());
+    Console::WriteLine("Verifying %zu replays using %zu jobs...", results.size(), numJobs);
+
+    // The context is a singleton, so every replay runs in its own worker process.
+    auto executablePath = Platform::GetCurrentExecutablePath();
+    auto startTime = std::chrono::high_resolution_clock::now();
+    {
+        JobPool jobPool(numJobs);
+        for (auto& result : results)
+        {
+            auto* resultPtr = &result;
+            jobPool.AddTask(
+                [resultPtr, &executablePath, &dataPathOptions]() {
+                    std::vector<std::string> args{ executablePath, "replay-verify", resultPtr->Path };
+                    args.insert(args.end(), dataPathOptions.begin(), dataPathOptions.end());
+
+                    std::string output;
+                    Platform::Execute(args, &output);
+                    ParseWorkerOutput(output, *resultPtr);
+                },
+                [resultPtr]() {
+                    Console::WriteLine(
+                        "[%-8s] %s (%u ticks, %.0f ticks/s)", GetReplayVerifyStatusName(resultPtr->Status),
+                        resultPtr->Path.c_str(), resultPtr->Ticks, GetTicksPerSecond(*resultPtr));
+                });
+        }
+        jobPool.Join();
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(endTime - startTime).count();
+
+    uint64_t totalTicks = 0;
+    size_t numFailed = 0;
+    for (const auto& result : results)
+    {
+        totalTicks += result.Ticks;
+        if (result.Status != ReplayVerifyStatus::PASSED)
+        {
+            numFailed++;
+            if (result.Status == ReplayVerifyStatus::MISMATCH)
+                Console::WriteLine("Mismatch: %s at checksum index %d", result.Path.c_str(), result.MismatchIndex);
+            else
+                Console::WriteLine("Error: %s", result.Path.c_str());
+        }
+    }
+    Console::WriteLine(
+        "%zu/%zu replays passed, %llu ticks in %.2f seconds", results.size() - numFailed, results.size(),
+        (unsigned long long)totalTicks, seconds);
+
+    if (_verifyJsonPath != nullptr)
+    {
+        WriteReplayVerifyJson(_verifyJsonPath, results, seconds);
+    }
+    if (_verifyJUnitPath != nullptr)
+    {
+        WriteReplayVerifyJUnit(_verifyJUnitPath, results, seconds);
+    }
+
+    return numFailed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
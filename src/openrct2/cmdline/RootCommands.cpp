@@ -140,7 +140,15 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
     DefineSubCommand("benchgfx",        CommandLine::BenchGfxCommands         ),
     DefineSubCommand("benchspritesort", CommandLine::BenchSpriteSortCommands  ),
+    DefineSubCommand("benchsawyer",     CommandLine::BenchSawyerCommands      ),
+    DefineSubCommand("benchimage",      CommandLine::BenchImageImporterCommands),
+    DefineSubCommand("benchobjselect",  CommandLine::BenchObjectSelectionCommands),
+    DefineSubCommand("benchvehicles",   CommandLine::BenchVehicleMotionCommands),
+    DefineSubCommand("benchpaint",      CommandLine::BenchPaintCommands       ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
+    DefineSubCommand("replay",          CommandLine::ReplayCommands           ),
+    DefineSubCommand("replay-verify",   CommandLine::ReplayVerifyCommands     ),
+    DefineSubCommand("rate-designs",    CommandLine::RateDesignsCommands      ),
     CommandTableEnd
 };
 
@@ -196,21 +204,7 @@ exitcode_t CommandLine::HandleCommandDefault()
     gOpenRCT2NoGraphics = _headless;
     gOpenRCT2SilentBreakpad = _silentBreakpad || _headless;
 
-    if (_userDataPath != nullptr)
-    {
-        utf8 absolutePath[MAX_PATH]{};
-        Path::GetAbsolute(absolutePath, std::size(absolutePath), _userDataPath);
-        String::Set(gCustomUserDataPath, std::size(gCustomUserDataPath), absolutePath);
-        Memory::Free(_userDataPath);
-    }
-
-    if (_openrctDataPath != nullptr)
-    {
-        utf8 absolutePath[MAX_PATH]{};
-        Path::GetAbsolute(absolutePath, std::size(absolutePath), _openrctDataPath);
-        String::Set(gCustomOpenrctDataPath, std::size(gCustomOpenrctDataPath), absolutePath);
-        Memory::Free(_openrctDataPath);
-    }
+    CommandLine::SetCustomDataPaths(_userDataPath, _openrctDataPath, _rct2DataPath);
 
     if (_rct1DataPath != nullptr)
     {
@@ -218,12 +212,6 @@ exitcode_t CommandLine::HandleCommandDefault()
         Memory::Free(_rct1DataPath);
     }
 
-    if (_rct2DataPath != nullptr)
-    {
-        String::Set(gCustomRCT2DataPath, std::size(gCustomRCT2DataPath), _rct2DataPath);
-        Memory::Free(_rct2DataPath);
-    }
-
     if (_password != nullptr)
     {
         String::Set(gCustomPassword, std::size(gCustomPassword), _password);
@@ -433,6 +421,49 @@ static exitcode_t HandleCommandRegisterShell([[maybe_unused]] CommandLineArgEnum
 }
 #endif // defined(_WIN32) && !defined(__MINGW32__)
 
+void CommandLine::SetCustomDataPaths(utf8* userDataPath, utf8* openrctDataPath, utf8* rct2DataPath)
+{
+    if (userDataPath != nullptr)
+    {
+        utf8 absolutePath[MAX_PATH]{};
+        Path::GetAbsolute(absolutePath, std::size(absolutePath), userDataPath);
+        String::Set(gCustomUserDataPath, std::size(gCustomUserDataPath), absolutePath);
+        Memory::Free(userDataPath);
+    }
+
+    if (openrctDataPath != nullptr)
+    {
+        utf8 absolutePath[MAX_PATH]{};
+        Path::GetAbsolute(absolutePath, std::size(absolutePath), openrctDataPath);
+        String::Set(gCustomOpenrctDataPath, std::size(gCustomOpenrctDataPath), absolutePath);
+        Memory::Free(openrctDataPath);
+    }
+
+    if (rct2DataPath != nullptr)
+    {
+        String::Set(gCustomRCT2DataPath, std::size(gCustomRCT2DataPath), rct2DataPath);
+        Memory::Free(rct2DataPath);
+    }
+}
+
+std::vector<std::string> CommandLine::GetCustomDataPathOptions()
+{
+    std::vector<std::string> options;
+    if (!String::IsNullOrEmpty(gCustomUserDataPath))
+    {
+        options.insert(options.end(), { "--user-data-path", gCustomUserDataPath });
+    }
+    if (!String::IsNullOrEmpty(gCustomOpenrctDataPath))
+    {
+        options.insert(options.end(), { "--openrct-data-path", gCustomOpenrctDataPath });
+    }
+    if (!String::IsNullOrEmpty(gCustomRCT2DataPath))
+    {
+        options.insert(options.end(), { "--rct2-data-path", gCustomRCT2DataPath });
+    }
+    return options;
+}
+
 static void PrintAbout()
 {
     PrintVersion();
@@ -174,6 +174,7 @@ namespace Config
             model->auto_staff_placement = reader->GetBoolean("auto_staff", true);
             model->handymen_mow_default = reader->GetBoolean("handymen_mow_default", false);
             model->default_inspection_interval = reader->GetInt32("default_inspection_interval", 2);
+            model->ride_measurement_max_samples = reader->GetInt32("ride_measurement_max_samples", 1048576);
             model->last_run_version = reader->GetCString("last_run_version", nullptr);
             model->invert_viewport_drag = reader->GetBoolean("invert_viewport_drag", false);
             model->load_save_sort = reader->GetInt32("load_save_sort", SORT_NAME_ASCENDING);
@@ -250,6 +251,7 @@ namespace Config
         writer->WriteBoolean("auto_staff", model->auto_staff_placement);
         writer->WriteBoolean("handymen_mow_default", model->handymen_mow_default);
         writer->WriteInt32("default_inspection_interval", model->default_inspection_interval);
+        writer->WriteInt32("ride_measurement_max_samples", model->ride_measurement_max_samples);
         writer->WriteString("last_run_version", model->last_run_version);
         writer->WriteBoolean("invert_viewport_drag", model->invert_viewport_drag);
         writer->WriteInt32("load_save_sort", model->load_save_sort);
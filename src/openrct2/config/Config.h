@@ -78,6 +78,7 @@ struct GeneralConfiguration
     bool handymen_mow_default;
     bool auto_open_shops;
     int32_t default_inspection_interval;
+    int32_t ride_measurement_max_samples;
     int32_t window_limit;
     int32_t scenario_select_mode;
     bool scenario_unlocking_enabled;
@@ -12,6 +12,7 @@
 #    include <windows.h>
 #else
 #    include <sys/stat.h>
+#    include <utime.h>
 #endif
 
 #include "../platform/platform.h"
@@ -147,6 +148,26 @@ namespace File
 #endif
         return lastModified;
     }
+
+    bool SetLastModifiedToNow(const std::string& path)
+    {
+#ifdef _WIN32
+        bool result = false;
+        auto pathW = String::ToWideChar(path.c_str());
+        auto hFile = CreateFileW(
+            pathW.c_str(), FILE_WRITE_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+        if (hFile != INVALID_HANDLE_VALUE)
+        {
+            FILETIME ftNow;
+            GetSystemTimeAsFileTime(&ftNow);
+            result = SetFileTime(hFile, nullptr, nullptr, &ftNow) != FALSE;
+            CloseHandle(hFile);
+        }
+        return result;
+#else
+        return utime(path.c_str(), nullptr) == 0;
+#endif
+    }
 } // namespace File
 
 bool writeentirefile(const utf8* path, const void* buffer, size_t length)
@@ -15,37 +15,33 @@
 #include "FileScanner.h"
 #include "FileStream.hpp"
 #include "JobPool.hpp"
+#include "MemoryStream.h"
 #include "Path.hpp"
 
 #include <chrono>
-#include <list>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
 {
-private:
-    struct DirectoryStats
+public:
+    struct ScannedFile
     {
-        uint32_t TotalFiles = 0;
-        uint64_t TotalFileSize = 0;
-        uint32_t FileDateModifiedChecksum = 0;
-        uint32_t PathChecksum = 0;
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
     };
 
     struct ScanResult
     {
-        DirectoryStats const Stats;
-        std::vector<std::string> const Files;
-
-        ScanResult(DirectoryStats stats, std::vector<std::string> files)
-            : Stats(stats)
-            , Files(files)
-        {
-        }
+        std::vector<ScannedFile> Files;
+        // Hash of every file's path, size and modification time, the language and the index versions
+        uint64_t Fingerprint = 0;
     };
 
+private:
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -53,12 +49,23 @@ private:
         uint8_t VersionA = 0;
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
-        DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumFiles = 0;
+    };
+
+    /**
+     * An indexed file as stored in the index file. Files that did not produce an item are kept as well
+     * so that they are not loaded again on every start.
+     */
+    struct FileIndexEntry
+    {
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        bool HasItem = false;
+        TItem Item{};
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -94,56 +101,38 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries the directories and loads the index. Items of files that have not changed since the index
+     * was written are taken from the index, only new or modified files are loaded again.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
-        auto scanResult = Scan();
-        auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
-        {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
-        }
-        else
-        {
-            // Index was not loaded
-            items = Build(language, scanResult);
-        }
-        return items;
+        return LoadOrBuild(language, Scan(language));
     }
 
-    std::vector<TItem> Rebuild(int32_t language) const
+    std::vector<TItem> LoadOrBuild(int32_t language, const ScanResult& scan) const
     {
-        auto scanResult = Scan();
-        auto items = Build(language, scanResult);
-        return items;
+        size_t numIndexedFiles = 0;
+        auto cachedEntries = ReadIndexFile(language, scan.Files, numIndexedFiles);
+        return Build(language, scan.Files, std::move(cachedEntries), numIndexedFiles);
     }
 
-protected:
-    /**
-     * Loads the given file and creates the item representing the data to store in the index.
-     * TODO Use std::optional when C++17 is available.
-     */
-    virtual std::tuple<bool, TItem> Create(int32_t language, const std::string& path) const abstract;
+    std::vector<TItem> Rebuild(int32_t language) const
+    {
+        return Rebuild(language, Scan(language));
+    }
 
-    /**
-     * Serialises an index item to the given stream.
-     */
-    virtual void Serialise(IStream* stream, const TItem& item) const abstract;
+    std::vector<TItem> Rebuild(int32_t language, const ScanResult& scan) const
+    {
+        return Build(language, scan.Files, {}, 0);
+    }
 
     /**
-     * Deserialises an index item from the given stream.
+     * Queries the directories for files to index. The fingerprint of the result can be used to tell whether
+     * anything derived from the index is still up to date without reading the index.
      */
-    virtual TItem Deserialise(IStream* stream) const abstract;
-
-private:
-    ScanResult Scan() const
+    ScanResult Scan(int32_t language) const
     {
-        DirectoryStats stats{};
-        std::vector<std::string> files;
+        ScanResult result;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -154,66 +143,124 @@ private:
             while (scanner->Next())
             {
                 auto fileInfo = scanner->GetFileInfo();
-                auto path = std::string(scanner->GetPath());
-
-                files.push_back(path);
 
-                stats.TotalFiles++;
-                stats.TotalFileSize += fileInfo->Size;
-                stats.FileDateModifiedChecksum ^= (uint32_t)(fileInfo->LastModified >> 32)
-                    ^ (uint32_t)(fileInfo->LastModified & 0xFFFFFFFF);
-                stats.FileDateModifiedChecksum = ror32(stats.FileDateModifiedChecksum, 5);
-                stats.PathChecksum += GetPathChecksum(path);
+                ScannedFile file;
+                file.Path = scanner->GetPath();
+                file.Size = fileInfo->Size;
+                file.LastModified = fileInfo->LastModified;
+                result.Files.push_back(std::move(file));
             }
             delete scanner;
         }
-        return ScanResult(stats, files);
+
+        // FNV-1a
+        uint64_t hash = 0xCBF29CE484222325;
+        auto addToHash = [&hash](const void* data, size_t length) {
+            for (size_t i = 0; i < length; i++)
+            {
+                hash = (hash ^ static_cast<const uint8_t*>(data)[i]) * 0x100000001B3;
+            }
+        };
+        uint32_t versions[] = { _magicNumber, FILE_INDEX_VERSION, _version, (uint32_t)language };
+        addToHash(versions, sizeof(versions));
+        for (const auto& file : result.Files)
+        {
+            addToHash(file.Path.c_str(), file.Path.size() + 1);
+            addToHash(&file.Size, sizeof(file.Size));
+            addToHash(&file.LastModified, sizeof(file.LastModified));
+        }
+        result.Fingerprint = hash;
+        return result;
     }
 
+protected:
+    /**
+     * Loads the given file and creates the item representing the data to store in the index.
+     * TODO Use std::optional when C++17 is available.
+     */
+    virtual std::tuple<bool, TItem> Create(int32_t language, const std::string& path) const abstract;
+
+    /**
+     * Serialises an index item to the given stream.
+     */
+    virtual void Serialise(IStream* stream, const TItem& item) const abstract;
+
+    /**
+     * Deserialises an index item from the given stream.
+     */
+    virtual TItem Deserialise(IStream* stream) const abstract;
+
+private:
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, const std::vector<ScannedFile>& files, const std::vector<size_t>& toIndex, size_t rangeStart,
+        size_t rangeEnd, std::vector<FileIndexEntry>& entries, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            auto fileIndex = toIndex[i];
+            const auto& file = files[fileIndex];
 
             if (_log_levels[DIAGNOSTIC_LEVEL_VERBOSE])
             {
                 std::lock_guard<std::mutex> lock(printLock);
-                log_verbose("FileIndex:Indexing '%s'", filePath.c_str());
+                log_verbose("FileIndex:Indexing '%s'", file.Path.c_str());
             }
 
-            auto item = Create(language, filePath);
-            if (std::get<0>(item))
-            {
-                items.push_back(std::get<1>(item));
-            }
+            auto& entry = entries[fileIndex];
+            entry.Size = file.Size;
+            entry.LastModified = file.LastModified;
+            std::tie(entry.HasItem, entry.Item) = Create(language, file.Path);
 
             processed++;
         }
     }
 
-    std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
+    std::vector<TItem> Build(
+        int32_t language, const std::vector<ScannedFile>& files,
+        std::unordered_map<std::string, FileIndexEntry> cachedEntries, size_t numIndexedFiles) const
     {
-        std::vector<TItem> allItems;
-        Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
-
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        const size_t totalCount = scanResult.Files.size();
-        if (totalCount > 0)
+        // Take unchanged files from the cache, every other file needs to be indexed
+        std::vector<FileIndexEntry> entries(files.size());
+        std::vector<size_t> toIndex;
+        size_t numReused = 0;
+        for (size_t i = 0; i < files.size(); i++)
+        {
+            const auto& file = files[i];
+            auto it = cachedEntries.find(file.Path);
+            if (it != cachedEntries.end() && it->second.Size == file.Size && it->second.LastModified == file.LastModified)
+            {
+                entries[i] = std::move(it->second);
+                numReused++;
+            }
+            else
+            {
+                toIndex.push_back(i);
+            }
+        }
+
+        // The index file needs rewriting if any file was added, changed or removed
+        bool indexChanged = !toIndex.empty() || numReused != numIndexedFiles;
+        if (!toIndex.empty())
         {
+            if (numReused == 0)
+            {
+                Console::WriteLine("Building %s (%zu items)", _name.c_str(), files.size());
+            }
+            else
+            {
+                Console::WriteLine("Updating %s (%zu of %zu items)", _name.c_str(), toIndex.size(), files.size());
+            }
+
             JobPool jobPool;
             std::mutex printLock; // For verbose prints.
 
-            std::list<std::vector<TItem>> containers;
-
             size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
 
             std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
 
+            const size_t totalCount = toIndex.size();
             auto reportProgress = [&]() {
                 const size_t completed = processed;
                 Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
@@ -226,59 +273,105 @@ private:
                     stepSize = totalCount - rangeStart;
                 }
 
-                auto& items = containers.emplace_back();
-
                 jobPool.AddTask(std::bind(
-                    &FileIndex<TItem>::BuildRange, this, language, std::cref(scanResult), rangeStart, rangeStart + stepSize,
-                    std::ref(items), std::ref(processed), std::ref(printLock)));
+                    &FileIndex<TItem>::BuildRange, this, language, std::cref(files), std::cref(toIndex), rangeStart,
+                    rangeStart + stepSize, std::ref(entries), std::ref(processed), std::ref(printLock)));
 
                 reportProgress();
             }
 
             jobPool.Join(reportProgress);
+        }
 
-            for (auto&& itr : containers)
+        if (indexChanged)
+        {
+            WriteIndexFile(language, files, entries);
+        }
+
+        std::vector<TItem> allItems;
+        allItems.reserve(entries.size());
+        for (auto& entry : entries)
+        {
+            if (entry.HasItem)
             {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
+                allItems.push_back(std::move(entry.Item));
             }
         }
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
-
-        auto endTime = std::chrono::high_resolution_clock::now();
-        auto duration = (std::chrono::duration<float>)(endTime - startTime);
-        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
-
+        if (!toIndex.empty())
+        {
+            auto endTime = std::chrono::high_resolution_clock::now();
+            auto duration = (std::chrono::duration<float>)(endTime - startTime);
+            Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+        }
         return allItems;
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    /**
+     * Reads the entries of the index file that match a scanned file by path, size and modification time.
+     * The index is read into memory in one go, entries of changed or removed files are skipped over
+     * without deserialising their item.
+     */
+    std::unordered_map<std::string, FileIndexEntry> ReadIndexFile(
+        int32_t language, const std::vector<ScannedFile>& files, size_t& numIndexedFiles) const
     {
-        bool loadedItems = false;
-        std::vector<TItem> items;
+        std::unordered_map<std::string, FileIndexEntry> entries;
+        numIndexedFiles = 0;
         if (File::Exists(_indexPath))
         {
             try
             {
                 log_verbose("FileIndex:Loading index: '%s'", _indexPath.c_str());
-                auto fs = FileStream(_indexPath, FILE_MODE_OPEN);
+                auto data = File::ReadAllBytes(_indexPath);
+                auto ms = MemoryStream(data.data(), data.size());
 
-                // Read header, check if we need to re-scan
-                auto header = fs.ReadValue<FileIndexHeader>();
+                // Read header, check if we can reuse any of the entries
+                auto header = ms.ReadValue<FileIndexHeader>();
                 if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
+                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language)
                 {
-                    items.reserve(header.NumItems);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
+                    std::unordered_map<std::string, const ScannedFile*> scannedFiles;
+                    scannedFiles.reserve(files.size());
+                    for (const auto& file : files)
                     {
-                        auto item = Deserialise(&fs);
-                        items.push_back(item);
+                        scannedFiles.emplace(file.Path, &file);
+                    }
+
+                    numIndexedFiles = header.NumFiles;
+                    entries.reserve(header.NumFiles);
+                    for (uint32_t i = 0; i < header.NumFiles; i++)
+                    {
+                        auto path = ms.ReadStdString();
+                        FileIndexEntry entry;
+                        entry.Size = ms.ReadValue<uint64_t>();
+                        entry.LastModified = ms.ReadValue<uint64_t>();
+                        entry.HasItem = ms.ReadValue<uint8_t>() != 0;
+                        auto itemLength = ms.ReadValue<uint32_t>();
+
+                        auto it = scannedFiles.find(path);
+                        if (it == scannedFiles.end() || it->second->Size != entry.Size
+                            || it->second->LastModified != entry.LastModified)
+                        {
+                            ms.Seek(itemLength, STREAM_SEEK_CURRENT);
+                            continue;
+                        }
+
+                        auto itemPosition = ms.GetPosition();
+                        if (entry.HasItem)
+                        {
+                            entry.Item = Deserialise(&ms);
+                        }
+
+                        // An item that does not span exactly its stored length is corrupt, skip it so the file is
+                        // indexed again
+                        if (ms.GetPosition() - itemPosition != itemLength)
+                        {
+                            log_verbose("FileIndex:Item length mismatch for '%s', reindexing", path.c_str());
+                            ms.SetPosition(itemPosition + itemLength);
+                            continue;
+                        }
+                        entries.emplace(std::move(path), std::move(entry));
                     }
-                    loadedItems = true;
                 }
                 else
                 {
@@ -289,18 +382,19 @@ private:
             {
                 Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
                 Console::Error::WriteLine("%s", e.what());
+                entries.clear();
+                numIndexedFiles = 0;
             }
         }
-        return std::make_tuple(loadedItems, items);
+        return entries;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(
+        int32_t language, const std::vector<ScannedFile>& files, const std::vector<FileIndexEntry>& entries) const
     {
         try
         {
             log_verbose("FileIndex:Writing index: '%s'", _indexPath.c_str());
-            Path::CreateDirectory(Path::GetDirectory(_indexPath));
-            auto fs = FileStream(_indexPath, FILE_MODE_WRITE);
 
             // Write header
             FileIndexHeader header;
@@ -308,15 +402,35 @@ private:
             header.VersionA = FILE_INDEX_VERSION;
             header.VersionB = _version;
             header.LanguageId = language;
-            header.Stats = stats;
-            header.NumItems = (uint32_t)items.size();
-            fs.WriteValue(header);
+            header.NumFiles = (uint32_t)files.size();
+
+            auto ms = MemoryStream();
+            ms.WriteValue(header);
 
-            // Write items
-            for (const auto& item : items)
+            // Write entries
+            for (size_t i = 0; i < files.size(); i++)
             {
-                Serialise(&fs, item);
+                const auto& entry = entries[i];
+                ms.WriteString(files[i].Path);
+                ms.WriteValue<uint64_t>(entry.Size);
+                ms.WriteValue<uint64_t>(entry.LastModified);
+                ms.WriteValue<uint8_t>(entry.HasItem ? 1 : 0);
+
+                // Item length, so that entries of changed files can be skipped when reading
+                auto itemLengthPosition = ms.GetPosition();
+                ms.WriteValue<uint32_t>(0);
+                if (entry.HasItem)
+                {
+                    Serialise(&ms, entry.Item);
+                }
+                auto endPosition = ms.GetPosition();
+                ms.SetPosition(itemLengthPosition);
+                ms.WriteValue<uint32_t>((uint32_t)(endPosition - itemLengthPosition - sizeof(uint32_t)));
+                ms.SetPosition(endPosition);
             }
+
+            Path::CreateDirectory(Path::GetDirectory(_indexPath));
+            File::WriteAllBytes(_indexPath, ms.GetData(), ms.GetLength());
         }
         catch (const std::exception& e)
         {
@@ -324,19 +438,4 @@ private:
             Console::Error::WriteLine("%s", e.what());
         }
     }
-
-    static uint32_t GetPathChecksum(const std::string& path)
-    {
-        uint32_t hash = 0xD8430DED;
-        for (const utf8* ch = path.c_str(); *ch != '\0'; ch++)
-        {
-            hash += (*ch);
-            hash += (hash << 10);
-            hash ^= (hash >> 6);
-        }
-        hash += (hash << 3);
-        hash ^= (hash >> 11);
-        hash += (hash << 15);
-        return hash;
-    }
 };
@@ -0,0 +1,122 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef _WIN32
+#    define WIN32_LEAN_AND_MEAN
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "IStream.hpp"
+#include "MemoryMappedFile.h"
+#include "String.hpp"
+
+#ifdef _WIN32
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path)
+{
+    auto pathW = String::ToWideChar(path);
+    _fileHandle = CreateFileW(
+        pathW.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (_fileHandle == INVALID_HANDLE_VALUE)
+    {
+        _fileHandle = nullptr;
+        throw IOException("Unable to open '" + path + "'");
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(_fileHandle, &fileSize))
+    {
+        CloseHandle(_fileHandle);
+        throw IOException("Unable to get size of '" + path + "'");
+    }
+    _length = (size_t)fileSize.QuadPart;
+    if (_length == 0)
+    {
+        return;
+    }
+
+    _mappingHandle = CreateFileMappingW(_fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (_mappingHandle != nullptr)
+    {
+        _data = MapViewOfFile(_mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+    }
+    if (_data == nullptr)
+    {
+        if (_mappingHandle != nullptr)
+        {
+            CloseHandle(_mappingHandle);
+        }
+        CloseHandle(_fileHandle);
+        throw IOException("Unable to map '" + path + "'");
+    }
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mappingHandle != nullptr)
+    {
+        CloseHandle(_mappingHandle);
+    }
+    if (_fileHandle != nullptr)
+    {
+        CloseHandle(_fileHandle);
+    }
+}
+
+#else
+
+MemoryMappedFile::MemoryMappedFile(const std::string& path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw IOException("Unable to open '" + path + "'");
+    }
+
+    struct stat statInfo;
+    if (fstat(fd, &statInfo) != 0)
+    {
+        close(fd);
+        throw IOException("Unable to get size of '" + path + "'");
+    }
+    _length = (size_t)statInfo.st_size;
+    if (_length == 0)
+    {
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, _length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed.
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw IOException("Unable to map '" + path + "'");
+    }
+    _data = data;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (_data != nullptr)
+    {
+        munmap(_data, _length);
+    }
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <string>
+
+/**
+ * Maps a whole file into memory. The mapping is copy-on-write: pages are shared with the page cache and other
+ * processes until they are written to, writes are never stored back to the file.
+ */
+class MemoryMappedFile final
+{
+private:
+    void* _data = nullptr;
+    size_t _length = 0;
+#ifdef _WIN32
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#endif
+
+public:
+    explicit MemoryMappedFile(const std::string& path);
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    ~MemoryMappedFile();
+
+    uint8_t* GetData() const
+    {
+        return static_cast<uint8_t*>(_data);
+    }
+
+    size_t GetLength() const
+    {
+        return _length;
+    }
+};
@@ -69,6 +69,7 @@ MemoryStream& MemoryStream::operator=(MemoryStream&& mv) noexcept
 {
     _access = mv._access;
     _dataCapacity = mv._dataCapacity;
+    _dataSize = mv._dataSize;
     _data = mv._data;
     _position = mv._position;
 
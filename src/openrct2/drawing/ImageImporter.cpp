@@ -10,7 +10,12 @@
 #include "ImageImporter.h"
 
 #include "../core/Imaging.h"
+#include "../util/Util.h"
 
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdlib>
 #include <cstring>
 #include <stdexcept>
 #include <string>
@@ -20,6 +25,204 @@ using ImportResult = ImageImporter::ImportResult;
 
 constexpr int32_t PALETTE_TRANSPARENT = -1;
 
+/**
+ * Precomputed tables for mapping colours to indices of the standard palette.
+ *
+ * Exact matches are found with a small open addressing hash table. Closest matches for in-range colours only
+ * consider the palette entries that can be nearest to some colour inside the colour's cell of a 16x16x16 grid;
+ * colours pushed out of range by dithering search all changeable entries.
+ */
+struct ImageImporter::PaletteLookup
+{
+    static constexpr uint32_t EXACT_TABLE_SIZE = 1024;
+    static constexpr int32_t CELL_BITS = 4;
+    static constexpr int32_t CELLS_PER_AXIS = 256 >> CELL_BITS;
+    static constexpr int32_t CELL_SIZE = 1 << CELL_BITS;
+
+    struct Candidates
+    {
+        // Structure of arrays, padded to a multiple of 4 by repeating the last entry
+        std::vector<int32_t> Red;
+        std::vector<int32_t> Green;
+        std::vector<int32_t> Blue;
+        std::vector<uint8_t> Index;
+
+        void Add(int32_t r, int32_t g, int32_t b, uint8_t index)
+        {
+            Red.push_back(r);
+            Green.push_back(g);
+            Blue.push_back(b);
+            Index.push_back(index);
+        }
+
+        void Pad()
+        {
+            while (!Index.empty() && (Index.size() % 4) != 0)
+            {
+                Add(Red.back(), Green.back(), Blue.back(), Index.back());
+            }
+        }
+
+        int32_t FindClosest(int32_t r, int32_t g, int32_t b) const
+        {
+            static const auto fn = sse41_available() ? imageimporter_find_closest_colour_sse4_1
+                                                     : imageimporter_find_closest_colour_scalar;
+            if (Index.empty())
+            {
+                return PALETTE_TRANSPARENT;
+            }
+            auto position = fn(Red.data(), Green.data(), Blue.data(), Index.size(), r, g, b);
+            return Index[position];
+        }
+    };
+
+    // Key is 0x01RRGGBB, zero marks an empty slot
+    std::array<uint32_t, EXACT_TABLE_SIZE> ExactKeys{};
+    std::array<uint8_t, EXACT_TABLE_SIZE> ExactIndex{};
+
+    Candidates AllChangable;
+    std::vector<Candidates> Cells;
+
+    static uint32_t GetExactSlot(uint32_t key)
+    {
+        return (key * 2654435761u) >> 22;
+    }
+
+    static uint32_t GetSquaredDistance(int32_t dr, int32_t dg, int32_t db)
+    {
+        return (uint32_t)(dr * dr + dg * dg + db * db);
+    }
+
+    explicit PaletteLookup(const PaletteBGRA* palette)
+    {
+        // Insert in ascending order so the first matching index wins, as with a linear scan
+        for (int32_t i = 0; i < 256; i++)
+        {
+            auto key = 0x01000000u | (palette[i].Red << 16) | (palette[i].Green << 8) | palette[i].Blue;
+            auto slot = GetExactSlot(key);
+            while (ExactKeys[slot] != 0 && ExactKeys[slot] != key)
+            {
+                slot = (slot + 1) % EXACT_TABLE_SIZE;
+            }
+            if (ExactKeys[slot] == 0)
+            {
+                ExactKeys[slot] = key;
+                ExactIndex[slot] = (uint8_t)i;
+            }
+
+            if (IsChangablePixel(i))
+            {
+                AllChangable.Add(palette[i].Red, palette[i].Green, palette[i].Blue, (uint8_t)i);
+            }
+        }
+
+        Cells.resize(CELLS_PER_AXIS * CELLS_PER_AXIS * CELLS_PER_AXIS);
+        for (int32_t cr = 0; cr < CELLS_PER_AXIS; cr++)
+        {
+            for (int32_t cg = 0; cg < CELLS_PER_AXIS; cg++)
+            {
+                for (int32_t cb = 0; cb < CELLS_PER_AXIS; cb++)
+                {
+                    BuildCell(GetCell(cr, cg, cb), cr * CELL_SIZE, cg * CELL_SIZE, cb * CELL_SIZE);
+                }
+            }
+        }
+        AllChangable.Pad();
+    }
+
+    Candidates& GetCell(int32_t cr, int32_t cg, int32_t cb)
+    {
+        return Cells[(cr * CELLS_PER_AXIS + cg) * CELLS_PER_AXIS + cb];
+    }
+
+    const Candidates& GetCell(int32_t cr, int32_t cg, int32_t cb) const
+    {
+        return Cells[(cr * CELLS_PER_AXIS + cg) * CELLS_PER_AXIS + cb];
+    }
+
+    void BuildCell(Candidates& cell, int32_t r0, int32_t g0, int32_t b0) const
+    {
+        auto nearestDelta = [](int32_t value, int32_t lo) {
+            auto hi = lo + CELL_SIZE - 1;
+            return value < lo ? lo - value : (value > hi ? value - hi : 0);
+        };
+        auto furthestDelta = [](int32_t value, int32_t lo) {
+            auto hi = lo + CELL_SIZE - 1;
+            return std::max(std::abs(value - lo), std::abs(value - hi));
+        };
+
+        // No colour in the cell is further than this from its closest entry
+        auto bound = UINT32_MAX;
+        for (size_t i = 0; i < AllChangable.Index.size(); i++)
+        {
+            auto furthest = GetSquaredDistance(
+                furthestDelta(AllChangable.Red[i], r0), furthestDelta(AllChangable.Green[i], g0),
+                furthestDelta(AllChangable.Blue[i], b0));
+            bound = std::min(bound, furthest);
+        }
+
+        // Keep every entry that could be, or tie with, the closest one for some colour in the cell
+        for (size_t i = 0; i < AllChangable.Index.size(); i++)
+        {
+            auto nearest = GetSquaredDistance(
+                nearestDelta(AllChangable.Red[i], r0), nearestDelta(AllChangable.Green[i], g0),
+                nearestDelta(AllChangable.Blue[i], b0));
+            if (nearest <= bound)
+            {
+                cell.Add(AllChangable.Red[i], AllChangable.Green[i], AllChangable.Blue[i], AllChangable.Index[i]);
+            }
+        }
+        cell.Pad();
+    }
+
+    int32_t FindExact(int32_t r, int32_t g, int32_t b) const
+    {
+        if ((uint32_t)r > 255 || (uint32_t)g > 255 || (uint32_t)b > 255)
+        {
+            return PALETTE_TRANSPARENT;
+        }
+
+        auto key = 0x01000000u | (r << 16) | (g << 8) | b;
+        for (auto slot = GetExactSlot(key); ExactKeys[slot] != 0; slot = (slot + 1) % EXACT_TABLE_SIZE)
+        {
+            if (ExactKeys[slot] == key)
+            {
+                return ExactIndex[slot];
+            }
+        }
+        return PALETTE_TRANSPARENT;
+    }
+
+    int32_t FindClosest(int32_t r, int32_t g, int32_t b) const
+    {
+        if ((uint32_t)r > 255 || (uint32_t)g > 255 || (uint32_t)b > 255)
+        {
+            return AllChangable.FindClosest(r, g, b);
+        }
+        return GetCell(r >> CELL_BITS, g >> CELL_BITS, b >> CELL_BITS).FindClosest(r, g, b);
+    }
+};
+
+int32_t imageimporter_find_closest_colour_scalar(
+    const int32_t* red, const int32_t* green, const int32_t* blue, size_t count, int32_t r, int32_t g, int32_t b)
+{
+    int32_t bestPosition = 0;
+    int32_t smallestError = INT32_MAX;
+    for (size_t i = 0; i < count; i++)
+    {
+        int32_t dr = red[i] - r;
+        int32_t dg = green[i] - g;
+        int32_t db = blue[i] - b;
+        int32_t error = dr * dr + dg * dg + db * db;
+        if (error < smallestError)
+        {
+            bestPosition = (int32_t)i;
+            smallestError = error;
+        }
+    }
+    return bestPosition;
+}
+
 ImportResult ImageImporter::Import(
     const Image& image, int32_t offsetX, int32_t offsetY, IMPORT_FLAGS flags, IMPORT_MODE mode) const
 {
@@ -226,17 +429,17 @@ int32_t ImageImporter::CalculatePaletteIndex(
     IMPORT_MODE mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height)
 {
     auto palette = StandardPalette;
-    auto paletteIndex = GetPaletteIndex(palette, rgbaSrc);
+    auto paletteIndex = GetPaletteIndex(rgbaSrc);
     if (mode == IMPORT_MODE::CLOSEST || mode == IMPORT_MODE::DITHERING)
     {
         if (paletteIndex == PALETTE_TRANSPARENT && !IsTransparentPixel(rgbaSrc))
         {
-            paletteIndex = GetClosestPaletteIndex(palette, rgbaSrc);
+            paletteIndex = GetClosestPaletteIndex(rgbaSrc);
         }
     }
     if (mode == IMPORT_MODE::DITHERING)
     {
-        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc)))
+        if (!IsTransparentPixel(rgbaSrc) && IsChangablePixel(GetPaletteIndex(rgbaSrc)))
         {
             auto dr = rgbaSrc[0] - (int16_t)(palette[paletteIndex].Red);
             auto dg = rgbaSrc[1] - (int16_t)(palette[paletteIndex].Green);
@@ -244,7 +447,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
 
             if (x + 1 < width)
             {
-                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4)))
+                if (!IsTransparentPixel(rgbaSrc + 4) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4)))
                 {
                     // Right
                     rgbaSrc[4] += dr * 7 / 16;
@@ -258,7 +461,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 if (x > 0)
                 {
                     if (!IsTransparentPixel(rgbaSrc + 4 * (width - 1))
-                        && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width - 1))))
+                        && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width - 1))))
                     {
                         // Bottom left
                         rgbaSrc[4 * (width - 1)] += dr * 3 / 16;
@@ -268,7 +471,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 }
 
                 // Bottom
-                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * width)))
+                if (!IsTransparentPixel(rgbaSrc + 4 * width) && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * width)))
                 {
                     rgbaSrc[4 * width] += dr * 5 / 16;
                     rgbaSrc[4 * width + 1] += dg * 5 / 16;
@@ -278,7 +481,7 @@ int32_t ImageImporter::CalculatePaletteIndex(
                 if (x + 1 < width)
                 {
                     if (!IsTransparentPixel(rgbaSrc + 4 * (width + 1))
-                        && IsChangablePixel(GetPaletteIndex(palette, rgbaSrc + 4 * (width + 1))))
+                        && IsChangablePixel(GetPaletteIndex(rgbaSrc + 4 * (width + 1))))
                     {
                         // Bottom right
                         rgbaSrc[4 * (width + 1)] += dr * 1 / 16;
@@ -292,18 +495,17 @@ int32_t ImageImporter::CalculatePaletteIndex(
     return paletteIndex;
 }
 
-int32_t ImageImporter::GetPaletteIndex(const PaletteBGRA* palette, int16_t* colour)
+const ImageImporter::PaletteLookup& ImageImporter::GetPaletteLookup()
+{
+    static const PaletteLookup lookup(StandardPalette);
+    return lookup;
+}
+
+int32_t ImageImporter::GetPaletteIndex(const int16_t* colour)
 {
     if (!IsTransparentPixel(colour))
     {
-        for (int32_t i = 0; i < 256; i++)
-        {
-            if ((int16_t)(palette[i].Red) == colour[0] && (int16_t)(palette[i].Green) == colour[1]
-                && (int16_t)(palette[i].Blue) == colour[2])
-            {
-                return i;
-            }
-        }
+        return GetPaletteLookup().FindExact(colour[0], colour[1], colour[2]);
     }
     return PALETTE_TRANSPARENT;
 }
@@ -333,26 +535,9 @@ bool ImageImporter::IsChangablePixel(int32_t paletteIndex)
     return true;
 }
 
-int32_t ImageImporter::GetClosestPaletteIndex(const PaletteBGRA* palette, const int16_t* colour)
+int32_t ImageImporter::GetClosestPaletteIndex(const int16_t* colour)
 {
-    auto smallestError = (uint32_t)-1;
-    auto bestMatch = PALETTE_TRANSPARENT;
-    for (int32_t x = 0; x < 256; x++)
-    {
-        if (IsChangablePixel(x))
-        {
-            uint32_t error = ((int16_t)(palette[x].Red) - colour[0]) * ((int16_t)(palette[x].Red) - colour[0])
-                + ((int16_t)(palette[x].Green) - colour[1]) * ((int16_t)(palette[x].Green) - colour[1])
-                + ((int16_t)(palette[x].Blue) - colour[2]) * ((int16_t)(palette[x].Blue) - colour[2]);
-
-            if (smallestError == (uint32_t)-1 || smallestError > error)
-            {
-                bestMatch = x;
-                smallestError = error;
-            }
-        }
-    }
-    return bestMatch;
+    return GetPaletteLookup().FindClosest(colour[0], colour[1], colour[2]);
 }
 
 const PaletteBGRA ImageImporter::StandardPalette[256] = {
@@ -51,6 +51,8 @@ namespace OpenRCT2::Drawing
             IMPORT_MODE mode = IMPORT_MODE::DEFAULT) const;
 
     private:
+        struct PaletteLookup;
+
         static const PaletteBGRA StandardPalette[256];
 
         static std::vector<int32_t> GetPixels(
@@ -60,9 +62,17 @@ namespace OpenRCT2::Drawing
 
         static int32_t CalculatePaletteIndex(
             IMPORT_MODE mode, int16_t* rgbaSrc, int32_t x, int32_t y, int32_t width, int32_t height);
-        static int32_t GetPaletteIndex(const PaletteBGRA* palette, int16_t* colour);
+        static const PaletteLookup& GetPaletteLookup();
+        static int32_t GetPaletteIndex(const int16_t* colour);
         static bool IsTransparentPixel(const int16_t* colour);
         static bool IsChangablePixel(int32_t paletteIndex);
-        static int32_t GetClosestPaletteIndex(const PaletteBGRA* palette, const int16_t* colour);
+        static int32_t GetClosestPaletteIndex(const int16_t* colour);
     };
 } // namespace OpenRCT2::Drawing
+
+// Returns the position of the first colour with the smallest squared distance to (r, g, b).
+// count must be a multiple of 4.
+int32_t imageimporter_find_closest_colour_scalar(
+    const int32_t* red, const int32_t* green, const int32_t* blue, size_t count, int32_t r, int32_t g, int32_t b);
+int32_t imageimporter_find_closest_colour_sse4_1(
+    const int32_t* red, const int32_t* green, const int32_t* blue, size_t count, int32_t r, int32_t g, int32_t b);
@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "ImageImporter.h"
+
+#ifdef __SSE4_1__
+
+#    include <climits>
+#    include <immintrin.h>
+
+int32_t imageimporter_find_closest_colour_sse4_1(
+    const int32_t* red, const int32_t* green, const int32_t* blue, size_t count, int32_t r, int32_t g, int32_t b)
+{
+    const __m128i colourR = _mm_set1_epi32(r);
+    const __m128i colourG = _mm_set1_epi32(g);
+    const __m128i colourB = _mm_set1_epi32(b);
+    const __m128i four = _mm_set1_epi32(4);
+
+    // Each lane keeps the smallest error and its position out of every fourth entry
+    __m128i smallestError = _mm_set1_epi32(INT32_MAX);
+    __m128i bestPosition = _mm_setzero_si128();
+    __m128i position = _mm_setr_epi32(0, 1, 2, 3);
+    for (size_t i = 0; i < count; i += 4)
+    {
+        const __m128i dr = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(red + i)), colourR);
+        const __m128i dg = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(green + i)), colourG);
+        const __m128i db = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(blue + i)), colourB);
+        // _mm_mullo_epi32 and _mm_min_epi32 are SSE4.1
+        const __m128i error = _mm_add_epi32(
+            _mm_add_epi32(_mm_mullo_epi32(dr, dr), _mm_mullo_epi32(dg, dg)), _mm_mullo_epi32(db, db));
+
+        // Strictly smaller, so the earliest entry wins within a lane
+        const __m128i smaller = _mm_cmplt_epi32(error, smallestError);
+        smallestError = _mm_min_epi32(error, smallestError);
+        bestPosition = _mm_blendv_epi8(bestPosition, position, smaller);
+        position = _mm_add_epi32(position, four);
+    }
+
+    alignas(16) int32_t errors[4];
+    alignas(16) int32_t positions[4];
+    _mm_store_si128((__m128i*)errors, smallestError);
+    _mm_store_si128((__m128i*)positions, bestPosition);
+
+    // Ties between lanes go to the earliest position
+    int32_t result = positions[0];
+    int32_t resultError = errors[0];
+    for (int32_t lane = 1; lane < 4; lane++)
+    {
+        if (errors[lane] < resultError || (errors[lane] == resultError && positions[lane] < result))
+        {
+            result = positions[lane];
+            resultError = errors[lane];
+        }
+    }
+    return result;
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with SSE4.1 enabled, when targetting x86!
+#    endif
+
+int32_t imageimporter_find_closest_colour_sse4_1(
+    const int32_t* red, const int32_t* green, const int32_t* blue, size_t count, int32_t r, int32_t g, int32_t b)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+#endif // __SSE4_1__
@@ -55,6 +55,7 @@
 #include <exception>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 #ifndef NO_TTF
@@ -419,10 +420,55 @@ static int32_t cc_rides(InteractiveConsole& console, const arguments_t& argv)
                 }
             }
         }
+        else if (argv[0] == "export_measurement")
+        {
+            if (argv.size() < 3)
+            {
+                console.WriteFormatLine("rides export_measurement <ride id> <file>");
+                return 0;
+            }
+
+            bool int_valid = false;
+            int32_t ride_index = console_parse_int(argv[1], &int_valid);
+            auto ride = int_valid ? get_ride(ride_index) : nullptr;
+            if (!int_valid)
+            {
+                console.WriteFormatLine("This command expects an integer ride id");
+            }
+            else if (ride == nullptr)
+            {
+                console.WriteFormatLine("No ride found with index %d", ride_index);
+            }
+            else if (ride->measurement == nullptr)
+            {
+                // Start measuring, the same as opening the ride's graphs does
+                RideMeasurement* measurement{};
+                std::tie(measurement, std::ignore) = ride_get_measurement(ride);
+                if (measurement == nullptr)
+                {
+                    console.WriteFormatLine("Ride %d does not support data logging", ride_index);
+                }
+                else
+                {
+                    console.WriteFormatLine("Data logging started, export again once the ride has run");
+                }
+            }
+            else
+            {
+                if (!ride_measurement_write_csv(*ride, argv[2]))
+                {
+                    console.WriteFormatLine("Unable to write '%s'", argv[2].c_str());
+                }
+                else
+                {
+                    console.WriteFormatLine("Wrote %u samples to '%s'", ride->measurement->num_items, argv[2].c_str());
+                }
+            }
+        }
     }
     else
     {
-        console.WriteFormatLine("subcommands: list, set");
+        console.WriteFormatLine("subcommands: list, set, export_measurement");
     }
     return 0;
 }
@@ -695,6 +741,10 @@ static int32_t cc_get(InteractiveConsole& console, const arguments_t& argv)
         {
             console.WriteFormatLine("current_rotation %d", get_current_rotation());
         }
+        else if (argv[0] == "autosave_pause_time")
+        {
+            console.WriteFormatLine("autosave_pause_time %.2f ms", gScenarioSavePauseTime);
+        }
 #ifndef NO_TTF
         else if (argv[0] == "enable_hinting")
         {
@@ -1359,7 +1409,7 @@ static int32_t cc_replay_startrecord(InteractiveConsole& console, const argument
 
     if (argv.size() < 1)
     {
-        console.WriteFormatLine("Parameters required <replay_name> [<max_ticks = 0xFFFFFFFF>]");
+        console.WriteFormatLine("Parameters required <replay_name> [<max_ticks = 0xFFFFFFFF>] [<keyframe_interval>]");
         return 0;
     }
 
@@ -1372,8 +1422,15 @@ static int32_t cc_replay_startrecord(InteractiveConsole& console, const argument
         maxTicks = atol(argv[1].c_str());
     }
 
+    // Amount of ticks between two keyframes, 0 disables keyframes.
+    uint32_t keyframeInterval = OpenRCT2::k_ReplayKeyframeInterval;
+    if (argv.size() >= 3)
+    {
+        keyframeInterval = atol(argv[2].c_str());
+    }
+
     auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
-    if (replayManager->StartRecording(name, maxTicks))
+    if (replayManager->StartRecording(name, maxTicks, keyframeInterval))
     {
         OpenRCT2::ReplayRecordInfo info;
         replayManager->GetCurrentReplayInfo(info);
@@ -1411,11 +1468,15 @@ static int32_t cc_replay_stoprecord(InteractiveConsole& console, const arguments
         const char* logFmt = "Replay recording stopped: (%s) %s\n"
                              "  Ticks: %u\n"
                              "  Commands: %u\n"
-                             "  Checksums: %u";
+                             "  Checksums: %u\n"
+                             "  Keyframes: %u";
 
         console.WriteFormatLine(
-            logFmt, info.Name.c_str(), info.FilePath.c_str(), info.Ticks, info.NumCommands, info.NumChecksums);
-        log_info(logFmt, info.Name.c_str(), info.FilePath.c_str(), info.Ticks, info.NumCommands, info.NumChecksums);
+            logFmt, info.Name.c_str(), info.FilePath.c_str(), info.Ticks, info.NumCommands, info.NumChecksums,
+            info.NumKeyframes);
+        log_info(
+            logFmt, info.Name.c_str(), info.FilePath.c_str(), info.Ticks, info.NumCommands, info.NumChecksums,
+            info.NumKeyframes);
 
         return 1;
     }
@@ -1454,10 +1515,14 @@ static int32_t cc_replay_start(InteractiveConsole& console, const arguments_t& a
                              "  Date Recorded: %s\n"
                              "  Ticks: %u\n"
                              "  Commands: %u\n"
-                             "  Checksums: %u";
+                             "  Checksums: %u\n"
+                             "  Keyframes: %u";
 
-        console.WriteFormatLine(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
-        log_info(logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums);
+        console.WriteFormatLine(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums,
+            info.NumKeyframes);
+        log_info(
+            logFmt, info.FilePath.c_str(), recordingDate, info.Ticks, info.NumCommands, info.NumChecksums, info.NumKeyframes);
 
         return 1;
     }
@@ -1483,6 +1548,38 @@ static int32_t cc_replay_stop(InteractiveConsole& console, const arguments_t& ar
     return 0;
 }
 
+static int32_t cc_replay_seek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (network_get_mode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    uint32_t tick = atol(argv[0].c_str());
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (!replayManager->IsReplaying())
+    {
+        console.WriteFormatLine("Replay currently not playing");
+        return 0;
+    }
+
+    if (replayManager->SeekToTick(tick))
+    {
+        console.WriteFormatLine("Replay seeked to tick %u", tick);
+        return 1;
+    }
+
+    return 0;
+}
+
 static int32_t cc_replay_normalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (network_get_mode() != NETWORK_MODE_NONE)
@@ -1643,6 +1740,7 @@ static constexpr const utf8* console_variable_table[] = {
     "cheat_disable_clearance_checks",
     "cheat_disable_support_limits",
     "current_rotation",
+    "autosave_pause_time",
 };
 static constexpr const utf8* console_window_table[] = {
     "object_selection",
@@ -1683,10 +1781,11 @@ static constexpr const console_command console_command_table[] = {
     { "twitch", cc_twitch, "Twitch API", "twitch" },
     { "variables", cc_variables, "Lists all the variables that can be used with get and sometimes set.", "variables" },
     { "windows", cc_windows, "Lists all the windows that can be opened.", "windows" },
-    { "replay_startrecord", cc_replay_startrecord, "Starts recording a new replay.", "replay_startrecord <name> [max_ticks]"},
+    { "replay_startrecord", cc_replay_startrecord, "Starts recording a new replay.", "replay_startrecord <name> [max_ticks] [keyframe_interval]"},
     { "replay_stoprecord", cc_replay_stoprecord, "Stops recording a new replay.", "replay_stoprecord"},
     { "replay_start", cc_replay_start, "Starts a replay", "replay_start <name>"},
     { "replay_stop", cc_replay_stop, "Stops the replay", "replay_stop"},
+    { "replay_seek", cc_replay_seek, "Jumps to a tick of the current replay", "replay_seek <tick>"},
     { "replay_normalise", cc_replay_normalise, "Normalises the replay to remove all gaps", "replay_normalise <input file> <output file>"},
     { "mp_desync", cc_mp_desync, "Forces a multiplayer desync", "cc_mp_desync [desync_type, 0 = Random t-shirt color on random peep, 1 = Remove random peep ]"},
 
@@ -443,6 +443,44 @@ void screenshot_giant()
     ReleaseDPI(dpi);
 }
 
+bool screenshot_dump_park(const std::string& outputPath, int32_t width, int32_t height)
+{
+    rct_drawpixelinfo dpi{};
+    bool result = false;
+    try
+    {
+        rct_viewport viewport{};
+        if (width == 0 || height == 0)
+        {
+            viewport = GetGiantViewport(gMapSize, gSavedViewRotation, 0);
+        }
+        else
+        {
+            viewport.width = width;
+            viewport.height = height;
+            viewport.view_width = viewport.width;
+            viewport.view_height = viewport.height;
+            viewport.view_x = gSavedViewX - (viewport.view_width / 2);
+            viewport.view_y = gSavedViewY - (viewport.view_height / 2);
+            viewport.zoom = gSavedViewZoom;
+        }
+        gCurrentRotation = gSavedViewRotation;
+
+        dpi = CreateDPI(viewport);
+
+        RenderViewport(nullptr, viewport, dpi);
+        auto renderedPalette = screenshot_get_rendered_palette();
+        result = WriteDpiToFile(outputPath, &dpi, renderedPalette);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("%s", e.what());
+    }
+
+    ReleaseDPI(dpi);
+    return result;
+}
+
 // TODO: Move this at some point into a more appropriate place.
 template<typename FN> static inline double MeasureFunctionTime(const FN& fn)
 {
@@ -37,5 +37,7 @@ std::string screenshot_dump_png(rct_drawpixelinfo* dpi);
 std::string screenshot_dump_png_32bpp(int32_t width, int32_t height, const void* pixels);
 
 void screenshot_giant();
+// Renders the loaded park from its saved view, a width or height of 0 renders the entire map.
+bool screenshot_dump_park(const std::string& outputPath, int32_t width, int32_t height);
 int32_t cmdline_for_screenshot(const char** argv, int32_t argc, ScreenshotOptions* options);
 int32_t cmdline_for_gfxbench(const char** argv, int32_t argc);
@@ -3891,6 +3891,9 @@ enum
     STR_SHORTCUT_DECREASE_Y_COORD = 6344,
     STR_SHORTCUT_INCREASE_ELEM_HEIGHT = 6345,
     STR_SHORTCUT_DECREASE_ELEM_HEIGHT = 6346,
+
+    STR_NETWORK_TICK_BUNDLES = 6347,
+    STR_NETWORK_TICK_BUNDLES_COMPRESSED = 6348,
     // Have to include resource strings (from scenarios and objects) for the time being now that language is partially working
     STR_COUNT = 32768
 };
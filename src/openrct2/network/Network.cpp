@@ -31,7 +31,7 @@
 // This string specifies which version of network stream current build uses.
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
-#define NETWORK_STREAM_VERSION "7"
+#define NETWORK_STREAM_VERSION "9"
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
 static Peep* _pickup_peep = nullptr;
@@ -72,6 +72,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include "NetworkPacket.h"
 #    include "NetworkPlayer.h"
 #    include "NetworkServerAdvertiser.h"
+#    include "NetworkTickBundle.h"
 #    include "NetworkUser.h"
 #    include "Socket.h"
 
@@ -81,6 +82,7 @@ static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 #    include <cmath>
 #    include <fstream>
 #    include <functional>
+#    include <limits>
 #    include <list>
 #    include <map>
 #    include <memory>
@@ -100,11 +102,6 @@ enum
     SERVER_EVENT_PLAYER_DISCONNECTED,
 };
 
-enum
-{
-    NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
-};
-
 static void network_chat_show_connected_message();
 static void network_chat_show_server_greeting();
 static void network_get_keys_directory(utf8* buffer, size_t bufferSize);
@@ -179,6 +176,7 @@ public:
     void Client_Send_GAME_ACTION(const GameAction* action);
     void Server_Send_GAME_ACTION(const GameAction* action);
     void Server_Send_TICK();
+    void Server_Send_TICK_BUNDLE();
     void Server_Send_PLAYERINFO(int32_t playerId);
     void Server_Send_PLAYERLIST();
     void Client_Send_PING();
@@ -243,6 +241,10 @@ private:
     };
 
     std::map<uint32_t, ServerTickData_t> _serverTickData;
+    // Game actions executed during a server tick are collected here and sent together with the tick
+    // header once the tick has finished.
+    NetworkTickBundle _tickBundle;
+    bool _tickBundleOpen = false;
     std::map<uint32_t, PlayerListUpdate> _pendingPlayerLists;
     std::multimap<uint32_t, NetworkPlayer> _pendingPlayerInfo;
     bool _playerListInvalidated = false;
@@ -294,6 +296,9 @@ private:
     void Client_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
     void Server_Handle_GAME_ACTION(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_TICK(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_TICK_BUNDLE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_ReceiveTick(uint32_t serverTick, uint32_t srand0, const char* spriteHash);
+    void Client_ReceiveGameAction(uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size);
     void Client_Handle_PLAYERINFO(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PLAYERLIST(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_PING(NetworkConnection& connection, NetworkPacket& packet);
@@ -332,6 +337,7 @@ Network::Network()
     client_command_handlers[NETWORK_COMMAND_CHAT] = &Network::Client_Handle_CHAT;
     client_command_handlers[NETWORK_COMMAND_GAME_ACTION] = &Network::Client_Handle_GAME_ACTION;
     client_command_handlers[NETWORK_COMMAND_TICK] = &Network::Client_Handle_TICK;
+    client_command_handlers[NETWORK_COMMAND_TICK_BUNDLE] = &Network::Client_Handle_TICK_BUNDLE;
     client_command_handlers[NETWORK_COMMAND_PLAYERLIST] = &Network::Client_Handle_PLAYERLIST;
     client_command_handlers[NETWORK_COMMAND_PLAYERINFO] = &Network::Client_Handle_PLAYERINFO;
     client_command_handlers[NETWORK_COMMAND_PING] = &Network::Client_Handle_PING;
@@ -418,6 +424,8 @@ void Network::Close()
         player_list.clear();
         group_list.clear();
         _serverTickData.clear();
+        _tickBundle = {};
+        _tickBundleOpen = false;
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
 
@@ -698,6 +706,7 @@ void Network::Flush()
     }
     else
     {
+        Server_Send_TICK_BUNDLE();
         for (auto& it : client_connection_list)
         {
             it->SendQueuedPackets();
@@ -1480,6 +1489,8 @@ NetworkStats_t Network::GetStats() const
                 stats.bytesReceived[n] += connection->Stats.bytesReceived[n];
                 stats.bytesSent[n] += connection->Stats.bytesSent[n];
             }
+            stats.tickBundleBytesRaw += connection->Stats.tickBundleBytesRaw;
+            stats.tickBundleBytesCompressed += connection->Stats.tickBundleBytesCompressed;
         }
     }
     return stats;
@@ -1643,11 +1654,18 @@ void Network::Client_Send_GAME_ACTION(const GameAction* action)
 
 void Network::Server_Send_GAME_ACTION(const GameAction* action)
 {
-    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-
     DataSerialiser stream(true);
     action->Serialise(stream);
 
+    if (_tickBundleOpen && _tickBundle.Tick == gCurrentTicks)
+    {
+        // Sent as part of the tick bundle once the tick has been processed.
+        auto& actionStream = stream.GetStream();
+        _tickBundle.AddAction(action->GetType(), actionStream.GetData(), (size_t)actionStream.GetLength());
+        return;
+    }
+
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
     *packet << (uint32_t)NETWORK_COMMAND_GAME_ACTION << gCurrentTicks << action->GetType() << stream;
 
     SendPacketToClients(*packet);
@@ -1655,8 +1673,9 @@ void Network::Server_Send_GAME_ACTION(const GameAction* action)
 
 void Network::Server_Send_TICK()
 {
-    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
-    *packet << (uint32_t)NETWORK_COMMAND_TICK << gCurrentTicks << scenario_rand_state().s0;
+    // A tick that was opened but never flushed must still reach the clients before the next one.
+    Server_Send_TICK_BUNDLE();
+
     uint32_t flags = 0;
     // Simple counter which limits how often a sprite checksum gets sent.
     // This can get somewhat expensive, so we don't want to push it every tick in release,
@@ -1668,16 +1687,62 @@ void Network::Server_Send_TICK()
         checksum_counter = 0;
         flags |= NETWORK_TICK_FLAG_CHECKSUMS;
     }
-    // Send flags always, so we can understand packet structure on the other end,
-    // and allow for some expansion.
-    *packet << flags;
+
+    // The tick header is captured now, before the tick is processed, but only sent in Server_Send_TICK_BUNDLE
+    // together with all game actions that were executed during the tick.
+    _tickBundleOpen = true;
+    _tickBundle.Tick = gCurrentTicks;
+    _tickBundle.Srand0 = scenario_rand_state().s0;
+    _tickBundle.Flags = flags;
+    _tickBundle.SpriteHash.clear();
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
         rct_sprite_checksum checksum = sprite_checksum();
-        packet->WriteString(checksum.ToString().c_str());
+        _tickBundle.SpriteHash = checksum.ToString();
     }
+    _tickBundle.Actions.clear();
+}
 
-    SendPacketToClients(*packet);
+void Network::Server_Send_TICK_BUNDLE()
+{
+    if (!_tickBundleOpen)
+        return;
+
+    _tickBundleOpen = false;
+
+    std::unique_ptr<NetworkPacket> packet(NetworkPacket::Allocate());
+    if (_tickBundle.Write(*packet))
+    {
+        SendPacketToClients(*packet);
+
+        for (auto& connection : client_connection_list)
+        {
+            if (!connection->IsDisconnected)
+            {
+                connection->Stats.tickBundleBytesRaw += _tickBundle.RawSize;
+                connection->Stats.tickBundleBytesCompressed += _tickBundle.WireSize;
+            }
+        }
+    }
+    else
+    {
+        // Too many actions for a single packet, fall back to the tick header followed by one packet per action.
+        // Clients only execute the tick once the next tick has been received, so the order does not matter.
+        *packet << (uint32_t)NETWORK_COMMAND_TICK << _tickBundle.Tick << _tickBundle.Srand0 << _tickBundle.Flags;
+        if (_tickBundle.Flags & NETWORK_TICK_FLAG_CHECKSUMS)
+        {
+            packet->WriteString(_tickBundle.SpriteHash.c_str());
+        }
+        SendPacketToClients(*packet);
+
+        for (const auto& action : _tickBundle.Actions)
+        {
+            std::unique_ptr<NetworkPacket> actionPacket(NetworkPacket::Allocate());
+            *actionPacket << (uint32_t)NETWORK_COMMAND_GAME_ACTION << _tickBundle.Tick << action.Type;
+            actionPacket->Write((const uint8_t*)action.Data.GetData(), action.Data.GetLength());
+            SendPacketToClients(*actionPacket);
+        }
+    }
 }
 
 void Network::Server_Send_PLAYERINFO(int32_t playerId)
@@ -2727,6 +2792,7 @@ bool Network::LoadMap(IStream* stream)
 
         // Read other data not in normal save files
         stream->Read(gSpriteSpatialIndex, 0x10001 * sizeof(uint16_t));
+        reset_vehicle_spatial_index();
         gGamePaused = stream->ReadValue<uint32_t>();
         _guestGenerationProbability = stream->ReadValue<uint32_t>();
         _suggestedGuestMaximum = stream->ReadValue<uint32_t>();
@@ -2844,9 +2910,14 @@ void Network::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection& conn
     uint32_t actionType;
     packet >> tick >> actionType;
 
-    MemoryStream stream;
     size_t size = packet.Size - packet.BytesRead;
-    stream.WriteArray(packet.Read(size), size);
+    Client_ReceiveGameAction(tick, actionType, packet.Read(size), size);
+}
+
+void Network::Client_ReceiveGameAction(uint32_t tick, uint32_t actionType, const uint8_t* data, size_t size)
+{
+    MemoryStream stream;
+    stream.WriteArray(data, size);
     stream.SetPosition(0);
 
     DataSerialiser ds(false, stream);
@@ -2951,17 +3022,40 @@ void Network::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connection,
 
     packet >> serverTick >> srand0 >> flags;
 
+    const char* spriteHash = nullptr;
+    if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+    {
+        spriteHash = packet.ReadString();
+    }
+
+    Client_ReceiveTick(serverTick, srand0, spriteHash);
+}
+
+void Network::Client_Handle_TICK_BUNDLE(NetworkConnection& connection, NetworkPacket& packet)
+{
+    NetworkTickBundle bundle;
+    if (!bundle.Read(packet))
+        return;
+
+    connection.Stats.tickBundleBytesRaw += bundle.RawSize;
+    connection.Stats.tickBundleBytesCompressed += bundle.WireSize;
+
+    bool hasChecksum = (bundle.Flags & NETWORK_TICK_FLAG_CHECKSUMS) != 0;
+    Client_ReceiveTick(bundle.Tick, bundle.Srand0, hasChecksum ? bundle.SpriteHash.c_str() : nullptr);
+    for (const auto& action : bundle.Actions)
+    {
+        Client_ReceiveGameAction(bundle.Tick, action.Type, (const uint8_t*)action.Data.GetData(), action.Data.GetLength());
+    }
+}
+
+void Network::Client_ReceiveTick(uint32_t serverTick, uint32_t srand0, const char* spriteHash)
+{
     ServerTickData_t tickData;
     tickData.srand0 = srand0;
     tickData.tick = serverTick;
-
-    if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+    if (spriteHash != nullptr)
     {
-        const char* text = packet.ReadString();
-        if (text != nullptr)
-        {
-            tickData.spriteHash = text;
-        }
+        tickData.spriteHash = spriteHash;
     }
 
     // Don't let the history grow too much.
@@ -192,6 +192,7 @@ void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool send
     switch (packet.GetCommand())
     {
         case NETWORK_COMMAND_GAME_ACTION:
+        case NETWORK_COMMAND_TICK_BUNDLE:
             trafficGroup = NETWORK_STATISTICS_GROUP_COMMANDS;
             break;
         case NETWORK_COMMAND_MAP:
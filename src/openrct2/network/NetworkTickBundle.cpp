@@ -0,0 +1,154 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkTickBundle.h"
+
+#    include "../core/DataSerialiser.h"
+#    include "../util/Util.h"
+#    include "NetworkPacket.h"
+#    include "NetworkTypes.h"
+
+#    include <stdexcept>
+
+// Preset dictionary used to compress tick bundles. Serialised game actions consist mostly of big endian
+// integers with small values, sprite checksums are upper case hex strings. Server and client must use the exact
+// same bytes, any change requires bumping NETWORK_STREAM_VERSION.
+static constexpr const uint8_t TickBundleDictionary[] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00,
+    0x00, 0x08, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0x80, 0x00,
+    0x00, 0x00, 0xFF, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xFF, 0xFF, '0',  '1',  '2',  '3',  '4',  '5',  '6',  '7',
+    '8',  '9',  'A',  'B',  'C',  'D',  'E',  'F',  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+void NetworkTickBundle::AddAction(uint32_t type, const void* data, size_t length)
+{
+    NetworkTickBundleAction action;
+    action.Type = type;
+    action.Data.Write(data, length);
+    Actions.push_back(std::move(action));
+}
+
+bool NetworkTickBundle::Write(NetworkPacket& packet)
+{
+    DataSerialiser payload(true);
+    if (Flags & NETWORK_TICK_FLAG_CHECKSUMS)
+    {
+        payload << SpriteHash;
+    }
+    payload << (uint32_t)Actions.size();
+    for (auto& action : Actions)
+    {
+        payload << action.Type << action.Data;
+    }
+
+    const uint8_t* rawData = (const uint8_t*)payload.GetStream().GetData();
+    RawSize = (size_t)payload.GetStream().GetLength();
+    WireSize = 0;
+    // Compressed data is only used when it is smaller, so this also limits the size on the wire.
+    if (RawSize > NETWORK_TICK_BUNDLE_MAX_PAYLOAD)
+    {
+        return false;
+    }
+
+    uint32_t flags = Flags & ~NETWORK_TICK_FLAG_COMPRESSED;
+    uint8_t* compressed = nullptr;
+    size_t compressedSize = 0;
+    if (RawSize >= NETWORK_TICK_BUNDLE_COMPRESS_THRESHOLD)
+    {
+        compressed = util_zlib_deflate_dictionary(
+            rawData, RawSize, &compressedSize, TickBundleDictionary, sizeof(TickBundleDictionary));
+        if (compressed != nullptr && compressedSize < RawSize)
+        {
+            flags |= NETWORK_TICK_FLAG_COMPRESSED;
+        }
+    }
+
+    const uint8_t* wireData = (flags & NETWORK_TICK_FLAG_COMPRESSED) ? compressed : rawData;
+    WireSize = (flags & NETWORK_TICK_FLAG_COMPRESSED) ? compressedSize : RawSize;
+
+    packet << (uint32_t)NETWORK_COMMAND_TICK_BUNDLE << Tick << Srand0 << flags << (uint32_t)RawSize;
+    packet.Write(wireData, WireSize);
+
+    free(compressed);
+    return true;
+}
+
+bool NetworkTickBundle::Read(NetworkPacket& packet)
+{
+    uint32_t rawSize = 0;
+    packet >> Tick >> Srand0 >> Flags >> rawSize;
+    RawSize = rawSize;
+    SpriteHash.clear();
+    Actions.clear();
+
+    WireSize = packet.Size - packet.BytesRead;
+    const uint8_t* wireData = packet.Read(WireSize);
+    if (wireData == nullptr)
+    {
+        log_error("Received malformed tick bundle for tick %u", Tick);
+        return false;
+    }
+
+    // The server never sends bundles larger than this, don't let a bad packet decide how much memory to allocate.
+    if (RawSize > NETWORK_TICK_BUNDLE_MAX_PAYLOAD || (!(Flags & NETWORK_TICK_FLAG_COMPRESSED) && WireSize != RawSize))
+    {
+        log_error("Received tick bundle with invalid size %u for tick %u", rawSize, Tick);
+        return false;
+    }
+
+    MemoryStream payloadStream;
+    if (Flags & NETWORK_TICK_FLAG_COMPRESSED)
+    {
+        // Fails unless the data inflates to exactly RawSize bytes
+        uint8_t* data = util_zlib_inflate_dictionary(
+            wireData, WireSize, RawSize, TickBundleDictionary, sizeof(TickBundleDictionary));
+        if (data == nullptr)
+        {
+            log_error("Failed to decompress tick bundle for tick %u", Tick);
+            return false;
+        }
+        payloadStream.WriteArray(data, RawSize);
+        free(data);
+    }
+    else
+    {
+        payloadStream.WriteArray(wireData, WireSize);
+    }
+    payloadStream.SetPosition(0);
+
+    try
+    {
+        DataSerialiser payload(false, payloadStream);
+        if (Flags & NETWORK_TICK_FLAG_CHECKSUMS)
+        {
+            payload << SpriteHash;
+        }
+
+        uint32_t numActions = 0;
+        payload << numActions;
+        for (uint32_t i = 0; i < numActions; i++)
+        {
+            NetworkTickBundleAction action;
+            payload << action.Type << action.Data;
+            Actions.push_back(std::move(action));
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Received malformed tick bundle for tick %u: %s", Tick, e.what());
+        return false;
+    }
+    return true;
+}
+
+#endif
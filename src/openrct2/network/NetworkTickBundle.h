@@ -0,0 +1,67 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../core/MemoryStream.h"
+
+#include <string>
+#include <vector>
+
+class NetworkPacket;
+
+enum
+{
+    NETWORK_TICK_FLAG_CHECKSUMS = 1 << 0,
+    NETWORK_TICK_FLAG_COMPRESSED = 1 << 1,
+};
+
+// Payloads smaller than this are sent as is, zlib would not gain anything on them.
+constexpr size_t NETWORK_TICK_BUNDLE_COMPRESS_THRESHOLD = 64;
+// Leave room for the packet header, the size of a packet is stored as uint16_t.
+constexpr size_t NETWORK_TICK_BUNDLE_MAX_PAYLOAD = 60000;
+
+struct NetworkTickBundleAction
+{
+    uint32_t Type = 0;
+    MemoryStream Data;
+};
+
+/**
+ * The tick header and the game actions the server executed during the tick, sent to the clients as a single
+ * NETWORK_COMMAND_TICK_BUNDLE packet. The payload is compressed with a preset dictionary when that makes it smaller.
+ */
+class NetworkTickBundle final
+{
+public:
+    uint32_t Tick = 0;
+    uint32_t Srand0 = 0;
+    uint32_t Flags = 0;
+    std::string SpriteHash;
+    std::vector<NetworkTickBundleAction> Actions;
+
+    // Size of the payload before compression and as sent over the wire, set by Write and Read.
+    size_t RawSize = 0;
+    size_t WireSize = 0;
+
+    void AddAction(uint32_t type, const void* data, size_t length);
+
+    /**
+     * Writes the bundle including the command to the packet. Returns false without writing anything if the payload
+     * is larger than NETWORK_TICK_BUNDLE_MAX_PAYLOAD, the actions then have to be sent one by one.
+     */
+    bool Write(NetworkPacket& packet);
+
+    /**
+     * Reads a bundle from a packet whose command has already been read. Returns false if the packet is malformed,
+     * claims a payload larger than NETWORK_TICK_BUNDLE_MAX_PAYLOAD or does not decompress to the claimed size.
+     */
+    bool Read(NetworkPacket& packet);
+};
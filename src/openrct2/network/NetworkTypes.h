@@ -67,6 +67,7 @@ enum NETWORK_COMMAND
     NETWORK_COMMAND_PLAYERINFO,
     NETWORK_COMMAND_REQUEST_GAMESTATE,
     NETWORK_COMMAND_GAMESTATE,
+    NETWORK_COMMAND_TICK_BUNDLE,
     NETWORK_COMMAND_MAX,
     NETWORK_COMMAND_INVALID = -1
 };
@@ -129,4 +130,6 @@ struct NetworkStats_t
 {
     uint64_t bytesReceived[NETWORK_STATISTICS_GROUP_MAX];
     uint64_t bytesSent[NETWORK_STATISTICS_GROUP_MAX];
+    uint64_t tickBundleBytesRaw;        // Tick bundle payloads before compression.
+    uint64_t tickBundleBytesCompressed; // Tick bundle payloads as sent over the wire.
 };
@@ -0,0 +1,328 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ObjectImageCache.h"
+
+#include "../Context.h"
+#include "../PlatformEnvironment.h"
+#include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/MemoryStream.h"
+#include "../core/Path.hpp"
+#include "../core/String.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace OpenRCT2;
+
+namespace ObjectImageCache
+{
+    constexpr uint32_t MAGIC_NUMBER = 0x3143494F; // OIC1
+    // Increment this when the image importer changes its output, to invalidate all cached images
+    constexpr uint32_t VERSION = 1;
+    // Size of the offset, dimensions, flags and zoomed offset stored for each element
+    constexpr size_t ELEMENT_RECORD_SIZE = 18;
+    // The least recently used entries are deleted when the cache grows beyond this size
+    constexpr uint64_t MAX_CACHE_SIZE = 256 * 1024 * 1024;
+
+    static std::atomic<uint32_t> _tempFileCounter;
+    static std::atomic<uint64_t> _bytesWrittenSinceTrim;
+    static std::atomic<bool> _trimmedThisSession;
+    static std::mutex _trimMutex;
+
+    static uint64_t GetHash(const void* data, size_t dataLength, uint64_t hash = 0xCBF29CE484222325)
+    {
+        // FNV-1a
+        auto data8 = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < dataLength; i++)
+        {
+            hash ^= data8[i];
+            hash *= 0x100000001B3;
+        }
+        return hash;
+    }
+
+    static std::string GetCacheDirectory()
+    {
+        auto env = GetContext()->GetPlatformEnvironment();
+        return Path::Combine(env->GetDirectoryPath(DIRBASE::CACHE), "objimages");
+    }
+
+    static std::string GetCachePath(const std::string& key)
+    {
+        return Path::Combine(GetCacheDirectory(), key + ".dat");
+    }
+
+    /**
+     * Checks that the image data of an element, including every run of an RLE image, lies within the given length.
+     */
+    static bool IsImageDataValid(const rct_g1_element& g1, const uint8_t* data, size_t length)
+    {
+        if (g1.width < 0 || g1.height < 0)
+        {
+            return false;
+        }
+        if (g1.flags & G1_FLAG_PALETTE)
+        {
+            return (size_t)g1.width * 3 <= length;
+        }
+        if (!(g1.flags & G1_FLAG_RLE_COMPRESSION))
+        {
+            return (size_t)g1.width * g1.height <= length;
+        }
+
+        // RLE images start with a table of row offsets, each row is a list of runs: length and end of line flag, x, pixels
+        if (g1.height == 0 || (size_t)g1.height * 2 > length)
+        {
+            return false;
+        }
+        for (int32_t y = 0; y < g1.height; y++)
+        {
+            size_t position = data[y * 2] | (data[y * 2 + 1] << 8);
+            bool endOfLine = false;
+            do
+            {
+                if (position + 2 > length)
+                {
+                    return false;
+                }
+                uint8_t chunk0 = data[position];
+                uint8_t x = data[position + 1];
+                size_t runLength = chunk0 & 0x7F;
+                if (x + runLength > (size_t)g1.width)
+                {
+                    return false;
+                }
+                position += 2 + runLength;
+                if (position > length)
+                {
+                    return false;
+                }
+                endOfLine = (chunk0 & 0x80) != 0;
+            } while (!endOfLine);
+        }
+        return true;
+    }
+
+    /**
+     * Deletes the least recently used entries until the cache fits in MAX_CACHE_SIZE.
+     */
+    static void Trim()
+    {
+        struct CacheFile
+        {
+            std::string Path;
+            uint64_t Size;
+            uint64_t LastModified;
+        };
+
+        std::vector<CacheFile> files;
+        uint64_t totalSize = 0;
+        auto pattern = Path::Combine(GetCacheDirectory(), "*.dat");
+        auto scanner = std::unique_ptr<IFileScanner>(Path::ScanDirectory(pattern, false));
+        while (scanner->Next())
+        {
+            auto fileInfo = scanner->GetFileInfo();
+            files.push_back({ scanner->GetPath(), fileInfo->Size, fileInfo->LastModified });
+            totalSize += fileInfo->Size;
+        }
+        if (totalSize <= MAX_CACHE_SIZE)
+        {
+            return;
+        }
+
+        std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) {
+            return a.LastModified < b.LastModified;
+        });
+        size_t numDeleted = 0;
+        for (const auto& file : files)
+        {
+            if (totalSize <= MAX_CACHE_SIZE)
+            {
+                break;
+            }
+            if (File::Delete(file.Path))
+            {
+                totalSize -= file.Size;
+                numDeleted++;
+            }
+        }
+        log_verbose("ObjectImageCache: deleted %zu least recently used entries", numDeleted);
+    }
+
+    /**
+     * Trims the cache on the first write of the session and then every time an eighth of the budget has been written.
+     */
+    static void TrimIfNeeded(size_t bytesWritten)
+    {
+        auto written = _bytesWrittenSinceTrim.fetch_add(bytesWritten) + bytesWritten;
+        if (_trimmedThisSession && written < MAX_CACHE_SIZE / 8)
+        {
+            return;
+        }
+
+        // Another thread already trimming is good enough
+        std::unique_lock<std::mutex> lock(_trimMutex, std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            _trimmedThisSession = true;
+            _bytesWrittenSinceTrim = 0;
+            Trim();
+        }
+    }
+
+    std::string GetKey(const void* data, size_t dataLength, uint32_t flags)
+    {
+        auto hash = GetHash(data, dataLength);
+        return String::StdFormat("%016llx-%08x-%x", (unsigned long long)hash, (uint32_t)dataLength, flags);
+    }
+
+    std::string GetKey(const std::string& path)
+    {
+        auto lastModified = File::GetLastModified(path);
+        auto hash = GetHash(path.data(), path.size());
+        hash = GetHash(&lastModified, sizeof(lastModified), hash);
+        return String::StdFormat("obj-%016llx", (unsigned long long)hash);
+    }
+
+    bool TryRead(const std::string& key, ObjectImageCacheEntry& entry)
+    {
+        auto path = GetCachePath(key);
+        if (!File::Exists(path))
+        {
+            return false;
+        }
+
+        try
+        {
+            auto data = File::ReadAllBytes(path);
+            auto ms = MemoryStream(data.data(), data.size());
+            if (ms.ReadValue<uint32_t>() != MAGIC_NUMBER || ms.ReadValue<uint32_t>() != VERSION)
+            {
+                return false;
+            }
+
+            auto count = ms.ReadValue<uint32_t>();
+            auto dataSize = ms.ReadValue<uint32_t>();
+            if ((uint64_t)count * ELEMENT_RECORD_SIZE + dataSize != ms.GetLength() - ms.GetPosition())
+            {
+                return false;
+            }
+
+            entry.Elements.resize(count);
+            std::vector<uint32_t> offsets(count);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                auto& g1 = entry.Elements[i];
+                offsets[i] = ms.ReadValue<uint32_t>();
+                g1.width = ms.ReadValue<int16_t>();
+                g1.height = ms.ReadValue<int16_t>();
+                g1.x_offset = ms.ReadValue<int16_t>();
+                g1.y_offset = ms.ReadValue<int16_t>();
+                g1.flags = ms.ReadValue<uint16_t>();
+                g1.zoomed_offset = ms.ReadValue<int32_t>();
+            }
+
+            entry.Data.resize(dataSize);
+            ms.Read(entry.Data.data(), dataSize);
+            for (uint32_t i = 0; i < count; i++)
+            {
+                if (offsets[i] == UINT32_MAX)
+                {
+                    entry.Elements[i].offset = nullptr;
+                }
+                else if (
+                    offsets[i] <= dataSize
+                    && IsImageDataValid(entry.Elements[i], entry.Data.data() + offsets[i], dataSize - offsets[i]))
+                {
+                    entry.Elements[i].offset = entry.Data.data() + offsets[i];
+                }
+                else
+                {
+                    log_warning("Cached image '%s' is corrupt", path.c_str());
+                    return false;
+                }
+            }
+
+            // Mark the entry as recently used so that it is the last to be trimmed
+            File::SetLastModifiedToNow(path);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to read cached image '%s': %s", path.c_str(), e.what());
+            return false;
+        }
+    }
+
+    void Write(const std::string& key, const rct_g1_element* elements, size_t count)
+    {
+        try
+        {
+            std::vector<uint32_t> offsets(count);
+            auto imageData = MemoryStream();
+            for (size_t i = 0; i < count; i++)
+            {
+                if (elements[i].offset == nullptr)
+                {
+                    offsets[i] = UINT32_MAX;
+                }
+                else
+                {
+                    offsets[i] = (uint32_t)imageData.GetPosition();
+                    imageData.Write(elements[i].offset, g1_calculate_data_size(&elements[i]));
+                }
+            }
+
+            auto ms = MemoryStream();
+            ms.WriteValue<uint32_t>(MAGIC_NUMBER);
+            ms.WriteValue<uint32_t>(VERSION);
+            ms.WriteValue<uint32_t>((uint32_t)count);
+            ms.WriteValue<uint32_t>((uint32_t)imageData.GetLength());
+            for (size_t i = 0; i < count; i++)
+            {
+                const auto& g1 = elements[i];
+                ms.WriteValue<uint32_t>(offsets[i]);
+                ms.WriteValue<int16_t>(g1.width);
+                ms.WriteValue<int16_t>(g1.height);
+                ms.WriteValue<int16_t>(g1.x_offset);
+                ms.WriteValue<int16_t>(g1.y_offset);
+                ms.WriteValue<uint16_t>(g1.flags);
+                ms.WriteValue<int32_t>(g1.zoomed_offset);
+            }
+            ms.Write(imageData.GetData(), imageData.GetLength());
+
+            // Other threads may be writing the same key, so write to a unique file first and move it into place.
+            auto directory = GetCacheDirectory();
+            Path::CreateDirectory(directory);
+            auto path = GetCachePath(key);
+            auto tempPath = String::StdFormat(
+                "%s.%zx.%llx.%u.tmp", path.c_str(), std::hash<std::thread::id>()(std::this_thread::get_id()),
+                (unsigned long long)std::chrono::steady_clock::now().time_since_epoch().count(), _tempFileCounter++);
+            File::WriteAllBytes(tempPath, ms.GetData(), ms.GetLength());
+            if (!File::Move(tempPath, path))
+            {
+                File::Delete(tempPath);
+            }
+            TrimIfNeeded(ms.GetLength());
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to write cached image '%s': %s", key.c_str(), e.what());
+        }
+    }
+} // namespace ObjectImageCache
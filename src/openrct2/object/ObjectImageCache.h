@@ -0,0 +1,46 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "../drawing/Drawing.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * A list of converted images loaded from the cache, the element offsets point into Data.
+ */
+struct ObjectImageCacheEntry
+{
+    std::vector<rct_g1_element> Elements;
+    std::vector<uint8_t> Data;
+};
+
+/**
+ * Persistent cache of images converted for JSON objects, so that PNG decoding, palette matching and RLE
+ * encoding only happen the first time an image is seen. Entries are stored as one file per key in the
+ * cache directory and can be read and written from multiple threads.
+ */
+namespace ObjectImageCache
+{
+    /**
+     * Creates a key from the source image data and the flags used to import it.
+     */
+    std::string GetKey(const void* data, size_t dataLength, uint32_t flags);
+
+    /**
+     * Creates a key for the image table of a legacy object file, based on its path and modification time.
+     */
+    std::string GetKey(const std::string& path);
+
+    bool TryRead(const std::string& key, ObjectImageCacheEntry& entry);
+    void Write(const std::string& key, const rct_g1_element* elements, size_t count);
+} // namespace ObjectImageCache
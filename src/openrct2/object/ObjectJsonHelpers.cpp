@@ -24,6 +24,7 @@
 #include "../sprites.h"
 #include "Object.h"
 #include "ObjectFactory.h"
+#include "ObjectImageCache.h"
 
 #include <algorithm>
 #include <cstdlib>
@@ -313,12 +314,32 @@ namespace ObjectJsonHelpers
     {
         std::vector<std::unique_ptr<RequiredImage>> result;
         auto objectPath = FindLegacyObject(name);
-        auto obj = ObjectFactory::CreateObjectFromLegacyFile(context->GetObjectRepository(), objectPath.c_str());
-        if (obj != nullptr)
+
+        // Avoid loading the whole legacy object if its image table has been cached before
+        ObjectImageCacheEntry cacheEntry;
+        auto cacheKey = ObjectImageCache::GetKey(objectPath);
+        Object* obj = nullptr;
+        const rct_g1_element* images = nullptr;
+        int32_t numImages = 0;
+        if (File::Exists(objectPath) && ObjectImageCache::TryRead(cacheKey, cacheEntry))
+        {
+            images = cacheEntry.Elements.data();
+            numImages = (int32_t)cacheEntry.Elements.size();
+        }
+        else
+        {
+            obj = ObjectFactory::CreateObjectFromLegacyFile(context->GetObjectRepository(), objectPath.c_str());
+            if (obj != nullptr)
+            {
+                auto& imgTable = static_cast<const Object*>(obj)->GetImageTable();
+                images = imgTable.GetImages();
+                numImages = (int32_t)imgTable.GetCount();
+                ObjectImageCache::Write(cacheKey, images, numImages);
+            }
+        }
+
+        if (images != nullptr)
         {
-            auto& imgTable = static_cast<const Object*>(obj)->GetImageTable();
-            auto numImages = (int32_t)imgTable.GetCount();
-            auto images = imgTable.GetImages();
             size_t placeHoldersAdded = 0;
             for (auto i : range)
             {
@@ -354,6 +375,32 @@ namespace ObjectJsonHelpers
         return result;
     }
 
+    /**
+     * Converts a PNG image to a g1 element, or takes the result of a previous conversion from the image cache.
+     */
+    static ObjectImageCacheEntry ImportImage(const std::vector<uint8_t>& imageData, ImageImporter::IMPORT_FLAGS flags)
+    {
+        ObjectImageCacheEntry entry;
+        auto cacheKey = ObjectImageCache::GetKey(imageData.data(), imageData.size(), flags);
+        if (ObjectImageCache::TryRead(cacheKey, entry) && entry.Elements.size() == 1)
+        {
+            return entry;
+        }
+
+        auto image = Imaging::ReadFromBuffer(imageData, IMAGE_FORMAT::PNG_32);
+        ImageImporter importer;
+        auto importResult = importer.Import(image, 0, 0, flags);
+        ObjectImageCache::Write(cacheKey, &importResult.Element, 1);
+
+        // Keep the converted data in the entry so it is owned the same way as a cached image
+        auto buffer = static_cast<const uint8_t*>(importResult.Buffer);
+        entry.Data.assign(buffer, buffer + importResult.BufferLength);
+        entry.Elements = { importResult.Element };
+        entry.Elements[0].offset = entry.Data.data();
+        std::free(importResult.Buffer);
+        return entry;
+    }
+
     static std::vector<std::unique_ptr<RequiredImage>> ParseImages(IReadObjectContext* context, std::string s)
     {
         std::vector<std::unique_ptr<RequiredImage>> result;
@@ -406,13 +453,8 @@ namespace ObjectJsonHelpers
             try
             {
                 auto imageData = context->GetData(s);
-                auto image = Imaging::ReadFromBuffer(imageData, IMAGE_FORMAT::PNG_32);
-
-                ImageImporter importer;
-                auto importResult = importer.Import(image, 0, 0, ImageImporter::IMPORT_FLAGS::RLE);
-
-                result.push_back(std::make_unique<RequiredImage>(importResult.Element));
-                std::free(importResult.Buffer);
+                auto g1Element = ImportImage(imageData, ImageImporter::IMPORT_FLAGS::RLE);
+                result.push_back(std::make_unique<RequiredImage>(g1Element.Elements[0]));
             }
             catch (const std::exception& e)
             {
@@ -440,15 +482,11 @@ namespace ObjectJsonHelpers
                 flags = (ImageImporter::IMPORT_FLAGS)(flags | ImageImporter::IMPORT_FLAGS::RLE);
             }
             auto imageData = context->GetData(path);
-            auto image = Imaging::ReadFromBuffer(imageData, IMAGE_FORMAT::PNG_32);
-
-            ImageImporter importer;
-            auto importResult = importer.Import(image, 0, 0, flags);
-            auto g1Element = importResult.Element;
+            auto importedImage = ImportImage(imageData, flags);
+            auto g1Element = importedImage.Elements[0];
             g1Element.x_offset = x;
             g1Element.y_offset = y;
             result.push_back(std::make_unique<RequiredImage>(g1Element));
-            std::free(importResult.Buffer);
         }
         catch (const std::exception& e)
         {
@@ -12,6 +12,7 @@
 #include "../Context.h"
 #include "../ParkImporter.h"
 #include "../core/Console.hpp"
+#include "../core/JobPool.hpp"
 #include "../core/Memory.hpp"
 #include "../localisation/StringIds.h"
 #include "FootpathItemObject.h"
@@ -25,9 +26,9 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
-#include <mutex>
-#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 
 class ObjectManager final : public IObjectManager
@@ -35,6 +36,9 @@ class ObjectManager final : public IObjectManager
 private:
     IObjectRepository& _objectRepository;
     std::vector<Object*> _loadedObjects;
+    // Reverse index of _loadedObjects, the same object can occupy more than one slot
+    std::unordered_multimap<const Object*, size_t> _loadedObjectSlots;
+    std::unique_ptr<JobPool> _loadJobs;
 
 public:
     explicit ObjectManager(IObjectRepository& objectRepository)
@@ -112,11 +116,7 @@ public:
                     loadedObject = GetOrLoadObject(ori);
                     if (loadedObject != nullptr)
                     {
-                        if (_loadedObjects.size() <= (size_t)slot)
-                        {
-                            _loadedObjects.resize(slot + 1);
-                        }
-                        _loadedObjects[slot] = loadedObject;
+                        SetLoadedObject(slot, loadedObject);
                         UpdateSceneryGroupIndexes();
                         ResetTypeToRideEntryIndexMap();
                     }
@@ -144,10 +144,6 @@ public:
 
     void UnloadObjects(const rct_object_entry* entries, size_t count) override
     {
-        // TODO there are two performance issues here:
-        //        - FindObject for every entry which is a dictionary lookup
-        //        - GetLoadedObjectIndex for every entry which enumerates _loadedList
-
         size_t numObjectsUnloaded = 0;
         for (size_t i = 0; i < count; i++)
         {
@@ -319,14 +315,39 @@ private:
         Guard::ArgumentNotNull(object, GUARD_LINE);
 
         auto result = std::numeric_limits<size_t>().max();
-        auto it = std::find(_loadedObjects.begin(), _loadedObjects.end(), object);
-        if (it != _loadedObjects.end())
+        auto range = _loadedObjectSlots.equal_range(object);
+        for (auto it = range.first; it != range.second; it++)
         {
-            result = std::distance(_loadedObjects.begin(), it);
+            result = std::min(result, it->second);
         }
         return result;
     }
 
+    void SetLoadedObject(size_t slot, Object* object)
+    {
+        if (_loadedObjects.size() <= slot)
+        {
+            _loadedObjects.resize(slot + 1);
+        }
+        _loadedObjects[slot] = object;
+        if (object != nullptr)
+        {
+            _loadedObjectSlots.emplace(object, slot);
+        }
+    }
+
+    void RebuildLoadedObjectSlots()
+    {
+        _loadedObjectSlots.clear();
+        for (size_t i = 0; i < _loadedObjects.size(); i++)
+        {
+            if (_loadedObjects[i] != nullptr)
+            {
+                _loadedObjectSlots.emplace(_loadedObjects[i], i);
+            }
+        }
+    }
+
     void SetNewLoadedObjectList(const std::vector<Object*>& newLoadedObjects)
     {
         if (newLoadedObjects.empty())
@@ -338,13 +359,13 @@ private:
             UnloadObjectsExcept(newLoadedObjects);
         }
         _loadedObjects = newLoadedObjects;
+        RebuildLoadedObjectSlots();
     }
 
     void UnloadObject(Object* object)
     {
         if (object != nullptr)
         {
-            // TODO try to prevent doing a repository search
             const ObjectRepositoryItem* ori = _objectRepository.FindObject(object->GetObjectEntry());
             if (ori != nullptr)
             {
@@ -353,13 +374,12 @@ private:
 
             // Because it's possible to have the same loaded object for multiple
             // slots, we have to make sure find and set all of them to nullptr
-            for (auto& obj : _loadedObjects)
+            auto range = _loadedObjectSlots.equal_range(object);
+            for (auto it = range.first; it != range.second; it++)
             {
-                if (obj == object)
-                {
-                    obj = nullptr;
-                }
+                _loadedObjects[it->second] = nullptr;
             }
+            _loadedObjectSlots.erase(range.first, range.second);
 
             object->Unload();
             delete object;
@@ -538,72 +558,79 @@ private:
         return requiredObjects;
     }
 
-    template<typename T, typename TFunc> static void ParallelFor(const std::vector<T>& items, TFunc func)
+    /**
+     * Loads the required objects in stages:
+     *   1. read: every distinct object is read and parsed in parallel, including the import of its images.
+     *   2. register: objects are loaded one after another, which allocates their strings and ImageList entries, and
+     *      are linked to their repository items.
+     */
+    std::vector<Object*> LoadObjects(std::vector<const ObjectRepositoryItem*>& requiredObjects, size_t* outNewObjectsLoaded)
     {
-        auto partitions = std::thread::hardware_concurrency();
-        auto partitionSize = (items.size() + (partitions - 1)) / partitions;
-        std::vector<std::thread> threads;
-        for (size_t n = 0; n < partitions; n++)
+        std::vector<Object*> objects;
+        objects.resize(OBJECT_ENTRY_COUNT);
+
+        // Work out which objects need reading, the same item may be required more than once
+        std::vector<const ObjectRepositoryItem*> toRead;
+        std::unordered_set<const ObjectRepositoryItem*> toReadSet;
+        for (auto ori : requiredObjects)
         {
-            auto begin = n * partitionSize;
-            auto end = std::min(items.size(), begin + partitionSize);
-            threads.emplace_back(
-                [func](size_t pbegin, size_t pend) {
-                    for (size_t i = pbegin; i < pend; i++)
-                    {
-                        func(i);
-                    }
-                },
-                begin, end);
+            if (ori != nullptr && ori->LoadedObject == nullptr && toReadSet.insert(ori).second)
+            {
+                toRead.push_back(ori);
+            }
         }
-        for (auto& t : threads)
+
+        // Read objects, each job writes to its own slot so no locking is required
+        auto readStartTime = std::chrono::high_resolution_clock::now();
+        std::vector<Object*> readObjects(toRead.size());
+        if (!toRead.empty())
         {
-            t.join();
+            if (_loadJobs == nullptr)
+            {
+                _loadJobs = std::make_unique<JobPool>();
+            }
+            for (size_t i = 0; i < toRead.size(); i++)
+            {
+                _loadJobs->AddTask(
+                    [this, &toRead, &readObjects, i]() { readObjects[i] = _objectRepository.LoadObject(toRead[i]); });
+            }
+            _loadJobs->Join();
         }
-    }
+        auto readEndTime = std::chrono::high_resolution_clock::now();
 
-    std::vector<Object*> LoadObjects(std::vector<const ObjectRepositoryItem*>& requiredObjects, size_t* outNewObjectsLoaded)
-    {
-        std::vector<Object*> objects;
+        // Register objects
         std::vector<Object*> loadedObjects;
         std::vector<rct_object_entry> badObjects;
-        objects.resize(OBJECT_ENTRY_COUNT);
-        loadedObjects.reserve(OBJECT_ENTRY_COUNT);
-
-        // Read objects
-        std::mutex commonMutex;
-        ParallelFor(requiredObjects, [this, &commonMutex, requiredObjects, &objects, &badObjects, &loadedObjects](size_t i) {
-            auto ori = requiredObjects[i];
-            Object* loadedObject = nullptr;
-            if (ori != nullptr)
+        loadedObjects.reserve(toRead.size());
+        for (size_t i = 0; i < toRead.size(); i++)
+        {
+            auto ori = toRead[i];
+            auto loadedObject = readObjects[i];
+            if (loadedObject == nullptr)
             {
-                loadedObject = ori->LoadedObject;
-                if (loadedObject == nullptr)
-                {
-                    loadedObject = _objectRepository.LoadObject(ori);
-                    if (loadedObject == nullptr)
-                    {
-                        std::lock_guard<std::mutex> guard(commonMutex);
-                        badObjects.push_back(ori->ObjectEntry);
-                        ReportObjectLoadProblem(&ori->ObjectEntry);
-                    }
-                    else
-                    {
-                        std::lock_guard<std::mutex> guard(commonMutex);
-                        loadedObjects.push_back(loadedObject);
-                        // Connect the ori to the registered object
-                        _objectRepository.RegisterLoadedObject(ori, loadedObject);
-                    }
-                }
+                badObjects.push_back(ori->ObjectEntry);
+                ReportObjectLoadProblem(&ori->ObjectEntry);
             }
-            objects[i] = loadedObject;
-        });
-
-        // Load objects
-        for (auto obj : loadedObjects)
+            else
+            {
+                loadedObject->Load();
+                loadedObjects.push_back(loadedObject);
+                // Connect the ori to the registered object
+                _objectRepository.RegisterLoadedObject(ori, loadedObject);
+            }
+        }
+        for (size_t i = 0; i < requiredObjects.size(); i++)
         {
-            obj->Load();
+            auto ori = requiredObjects[i];
+            objects[i] = ori != nullptr ? ori->LoadedObject : nullptr;
         }
+        auto registerEndTime = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double, std::milli> readDuration = readEndTime - readStartTime;
+        std::chrono::duration<double, std::milli> registerDuration = registerEndTime - readEndTime;
+        log_verbose(
+            "Object loading: read %zu objects in %.2f ms, registered in %.2f ms", toRead.size(), readDuration.count(),
+            registerDuration.count());
 
         if (!badObjects.empty())
         {
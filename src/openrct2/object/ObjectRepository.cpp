@@ -19,6 +19,7 @@
 #include "../core/Guard.hpp"
 #include "../core/IStream.hpp"
 #include "../core/Memory.hpp"
+#include "../core/MemoryMappedFile.h"
 #include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
@@ -38,34 +39,182 @@
 #include "RideObject.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
-#include <unordered_map>
+#include <tuple>
 #include <vector>
 
 using namespace OpenRCT2;
 
-struct ObjectEntryHash
+/**
+ * Flat open addressing hash table from an object entry's name to the index of its repository item. Items are only
+ * ever added or the whole table rebuilt, so removal is not supported.
+ */
+class ObjectEntryTable
 {
-    size_t operator()(const rct_object_entry& entry) const
+private:
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+
+    struct Slot
+    {
+        uint64_t Name = 0;
+        uint32_t Index = EMPTY_SLOT;
+    };
+
+    std::vector<Slot> _slots;
+    size_t _count = 0;
+
+    static uint64_t GetKey(const rct_object_entry& entry)
+    {
+        uint64_t key;
+        static_assert(sizeof(key) == sizeof(entry.name));
+        std::memcpy(&key, entry.name, sizeof(key));
+        return key;
+    }
+
+    size_t GetSlotIndex(uint64_t key) const
     {
-        uint32_t hash = 5381;
-        for (auto i : entry.name)
+        return (size_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (_slots.size() - 1);
+    }
+
+    void Insert(uint64_t key, uint32_t index)
+    {
+        auto slot = GetSlotIndex(key);
+        while (_slots[slot].Index != EMPTY_SLOT && _slots[slot].Name != key)
         {
-            hash = ((hash << 5) + hash) + i;
+            slot = (slot + 1) & (_slots.size() - 1);
         }
-        return hash;
+        if (_slots[slot].Index == EMPTY_SLOT)
+        {
+            _count++;
+        }
+        _slots[slot] = { key, index };
     }
-};
 
-struct ObjectEntryEqual
-{
-    bool operator()(const rct_object_entry& lhs, const rct_object_entry& rhs) const
+    void Grow()
+    {
+        auto oldSlots = std::move(_slots);
+        _slots = std::vector<Slot>(std::max<size_t>(64, oldSlots.size() * 2));
+        _count = 0;
+        for (const auto& slot : oldSlots)
+        {
+            if (slot.Index != EMPTY_SLOT)
+            {
+                Insert(slot.Name, slot.Index);
+            }
+        }
+    }
+
+public:
+    void Clear()
+    {
+        _slots.clear();
+        _count = 0;
+    }
+
+    size_t GetNumSlots() const
+    {
+        return _slots.size();
+    }
+
+    std::tuple<uint64_t, uint32_t> GetSlot(size_t slot) const
     {
-        return memcmp(&lhs.name, &rhs.name, 8) == 0;
+        return std::make_tuple(_slots[slot].Name, _slots[slot].Index);
+    }
+
+    /**
+     * Replaces the table with slots taken from a previously built table, the number of slots must be a power of two.
+     */
+    void SetSlots(std::vector<std::tuple<uint64_t, uint32_t>> slots)
+    {
+        _slots.resize(slots.size());
+        _count = 0;
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            std::tie(_slots[i].Name, _slots[i].Index) = slots[i];
+            if (_slots[i].Index != EMPTY_SLOT)
+            {
+                _count++;
+            }
+        }
+    }
+
+    void Set(const rct_object_entry& entry, size_t index)
+    {
+        // Keep the load factor at or below a half so probe sequences stay short
+        if ((_count + 1) * 2 > _slots.size())
+        {
+            Grow();
+        }
+        Insert(GetKey(entry), (uint32_t)index);
+    }
+
+    size_t Find(const rct_object_entry& entry) const
+    {
+        if (_slots.empty())
+        {
+            return SIZE_MAX;
+        }
+
+        auto key = GetKey(entry);
+        for (auto slot = GetSlotIndex(key); _slots[slot].Index != EMPTY_SLOT; slot = (slot + 1) & (_slots.size() - 1))
+        {
+            if (_slots[slot].Name == key)
+            {
+                return _slots[slot].Index;
+            }
+        }
+        return SIZE_MAX;
     }
 };
 
-using ObjectEntryMap = std::unordered_map<rct_object_entry, size_t, ObjectEntryHash, ObjectEntryEqual>;
+#pragma pack(push, 1)
+/**
+ * The object repository snapshot is a flat copy of the sorted repository items and their lookup table. It is only
+ * valid for the scan fingerprint it was written for and lets startup skip reading the object index, sorting the items
+ * and building the lookup table. All offsets are relative to the start of the file.
+ */
+struct ObjectSnapshotHeader
+{
+    uint32_t MagicNumber;
+    uint32_t Version;
+    uint64_t Fingerprint;
+    uint32_t NumItems;
+    uint32_t ItemsOffset;
+    uint32_t NumEntries;
+    uint32_t EntriesOffset;
+    uint32_t NumSlots;
+    uint32_t SlotsOffset;
+    uint32_t StringsLength;
+    uint32_t StringsOffset;
+};
+assert_struct_size(ObjectSnapshotHeader, 48);
+
+struct ObjectSnapshotItem
+{
+    rct_object_entry ObjectEntry;
+    uint32_t PathOffset;
+    uint32_t PathLength;
+    uint32_t NameOffset;
+    uint32_t NameLength;
+    uint32_t SourcesOffset;
+    uint32_t SourcesLength;
+    uint8_t RideFlags;
+    uint8_t RideCategory[MAX_CATEGORIES_PER_RIDE];
+    uint8_t RideType[MAX_RIDE_TYPES_PER_RIDE_ENTRY];
+    uint8_t RideGroupIndex;
+    uint32_t SceneryEntriesIndex;
+    uint32_t SceneryEntriesCount;
+};
+assert_struct_size(ObjectSnapshotItem, 16 + 24 + 1 + MAX_CATEGORIES_PER_RIDE + MAX_RIDE_TYPES_PER_RIDE_ENTRY + 1 + 8);
+
+struct ObjectSnapshotSlot
+{
+    uint64_t Name;
+    uint32_t Index;
+};
+assert_struct_size(ObjectSnapshotSlot, 12);
+#pragma pack(pop)
 
 class ObjectFileIndex final : public FileIndex<ObjectRepositoryItem>
 {
@@ -210,7 +359,7 @@ class ObjectRepository final : public IObjectRepository
     std::shared_ptr<IPlatformEnvironment> const _env;
     ObjectFileIndex const _fileIndex;
     std::vector<ObjectRepositoryItem> _items;
-    ObjectEntryMap _itemMap;
+    ObjectEntryTable _itemMap;
 
 public:
     explicit ObjectRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -227,16 +376,23 @@ public:
     void LoadOrConstruct(int32_t language) override
     {
         ClearItems();
-        auto items = _fileIndex.LoadOrBuild(language);
-        AddItems(items);
-        SortItems();
+        auto scan = _fileIndex.Scan(language);
+        if (!ReadSnapshot(scan.Fingerprint))
+        {
+            auto items = _fileIndex.LoadOrBuild(language, scan);
+            AddItems(items);
+            SortItems();
+            WriteSnapshot(scan.Fingerprint);
+        }
     }
 
     void Construct(int32_t language) override
     {
-        auto items = _fileIndex.Rebuild(language);
+        auto scan = _fileIndex.Scan(language);
+        auto items = _fileIndex.Rebuild(language, scan);
         AddItems(items);
         SortItems();
+        WriteSnapshot(scan.Fingerprint);
     }
 
     size_t GetNumObjects() const override
@@ -256,20 +412,20 @@ public:
         String::Set(entryName, sizeof(entryName), name);
         std::copy_n(entryName, 8, entry.name);
 
-        auto kvp = _itemMap.find(entry);
-        if (kvp != _itemMap.end())
+        auto index = _itemMap.Find(entry);
+        if (index != SIZE_MAX)
         {
-            return &_items[kvp->second];
+            return &_items[index];
         }
         return nullptr;
     }
 
     const ObjectRepositoryItem* FindObject(const rct_object_entry* objectEntry) const override final
     {
-        auto kvp = _itemMap.find(*objectEntry);
-        if (kvp != _itemMap.end())
+        auto index = _itemMap.Find(*objectEntry);
+        if (index != SIZE_MAX)
         {
-            return &_items[kvp->second];
+            return &_items[index];
         }
         return nullptr;
     }
@@ -395,10 +551,184 @@ public:
     }
 
 private:
+    static constexpr uint32_t SNAPSHOT_MAGIC_NUMBER = 0x504E534F; // OSNP
+    static constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+    /**
+     * Takes the items and lookup table from the snapshot if it was written for the same set of object files.
+     */
+    bool ReadSnapshot(uint64_t fingerprint)
+    {
+        auto path = _env->GetFilePath(PATHID::CACHE_SNAPSHOT);
+        if (!File::Exists(path))
+        {
+            return false;
+        }
+
+        try
+        {
+            auto file = MemoryMappedFile(path);
+            auto data = file.GetData();
+            auto length = file.GetLength();
+            auto checkRange = [length](uint64_t offset, uint64_t size) {
+                if (offset > length || size > length - offset)
+                {
+                    throw IOException("Snapshot is truncated.");
+                }
+            };
+
+            checkRange(0, sizeof(ObjectSnapshotHeader));
+            ObjectSnapshotHeader header;
+            std::memcpy(&header, data, sizeof(header));
+            if (header.MagicNumber != SNAPSHOT_MAGIC_NUMBER || header.Version != SNAPSHOT_VERSION
+                || header.Fingerprint != fingerprint)
+            {
+                log_verbose("Object repository snapshot is out of date");
+                return false;
+            }
+            checkRange(header.ItemsOffset, (uint64_t)header.NumItems * sizeof(ObjectSnapshotItem));
+            checkRange(header.EntriesOffset, (uint64_t)header.NumEntries * sizeof(rct_object_entry));
+            checkRange(header.SlotsOffset, (uint64_t)header.NumSlots * sizeof(ObjectSnapshotSlot));
+            checkRange(header.StringsOffset, header.StringsLength);
+
+            auto items = reinterpret_cast<const ObjectSnapshotItem*>(data + header.ItemsOffset);
+            auto entries = reinterpret_cast<const rct_object_entry*>(data + header.EntriesOffset);
+            auto strings = reinterpret_cast<const char*>(data + header.StringsOffset);
+            auto checkString = [&header](uint32_t offset, uint32_t stringLength) {
+                if (offset > header.StringsLength || stringLength > header.StringsLength - offset)
+                {
+                    throw IOException("Snapshot string out of range.");
+                }
+            };
+
+            _items.resize(header.NumItems);
+            for (uint32_t i = 0; i < header.NumItems; i++)
+            {
+                ObjectSnapshotItem src;
+                std::memcpy(&src, &items[i], sizeof(src));
+                checkString(src.PathOffset, src.PathLength);
+                checkString(src.NameOffset, src.NameLength);
+                checkString(src.SourcesOffset, src.SourcesLength);
+                if (src.SceneryEntriesIndex > header.NumEntries
+                    || src.SceneryEntriesCount > header.NumEntries - src.SceneryEntriesIndex)
+                {
+                    throw IOException("Snapshot scenery group entries out of range.");
+                }
+
+                auto& item = _items[i];
+                item.Id = i;
+                item.ObjectEntry = src.ObjectEntry;
+                item.Path.assign(strings + src.PathOffset, src.PathLength);
+                item.Name.assign(strings + src.NameOffset, src.NameLength);
+                item.Sources.assign(strings + src.SourcesOffset, strings + src.SourcesOffset + src.SourcesLength);
+                item.RideInfo.RideFlags = src.RideFlags;
+                std::copy_n(src.RideCategory, MAX_CATEGORIES_PER_RIDE, item.RideInfo.RideCategory);
+                std::copy_n(src.RideType, MAX_RIDE_TYPES_PER_RIDE_ENTRY, item.RideInfo.RideType);
+                item.RideInfo.RideGroupIndex = src.RideGroupIndex;
+                item.SceneryGroupInfo.Entries.assign(
+                    entries + src.SceneryEntriesIndex, entries + src.SceneryEntriesIndex + src.SceneryEntriesCount);
+            }
+
+            std::vector<std::tuple<uint64_t, uint32_t>> slots(header.NumSlots);
+            for (uint32_t i = 0; i < header.NumSlots; i++)
+            {
+                ObjectSnapshotSlot slot;
+                std::memcpy(&slot, data + header.SlotsOffset + i * sizeof(ObjectSnapshotSlot), sizeof(slot));
+                if (slot.Index != UINT32_MAX && slot.Index >= header.NumItems)
+                {
+                    throw IOException("Snapshot lookup table out of range.");
+                }
+                slots[i] = std::make_tuple(slot.Name, slot.Index);
+            }
+            if ((header.NumSlots & (header.NumSlots - 1)) != 0)
+            {
+                throw IOException("Snapshot lookup table has an invalid size.");
+            }
+            _itemMap.SetSlots(std::move(slots));
+
+            log_verbose("Object repository loaded from snapshot (%u items)", header.NumItems);
+            return true;
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to read object repository snapshot: %s", e.what());
+            ClearItems();
+            return false;
+        }
+    }
+
+    void WriteSnapshot(uint64_t fingerprint) const
+    {
+        auto path = _env->GetFilePath(PATHID::CACHE_SNAPSHOT);
+        try
+        {
+            std::vector<ObjectSnapshotItem> items(_items.size());
+            std::vector<rct_object_entry> entries;
+            std::string strings;
+            auto addString = [&strings](const void* str, size_t length, uint32_t& outOffset, uint32_t& outLength) {
+                outOffset = (uint32_t)strings.size();
+                outLength = (uint32_t)length;
+                strings.append(static_cast<const char*>(str), length);
+            };
+            for (size_t i = 0; i < _items.size(); i++)
+            {
+                const auto& src = _items[i];
+                auto& dst = items[i];
+                dst = {};
+                dst.ObjectEntry = src.ObjectEntry;
+                addString(src.Path.data(), src.Path.size(), dst.PathOffset, dst.PathLength);
+                addString(src.Name.data(), src.Name.size(), dst.NameOffset, dst.NameLength);
+                addString(src.Sources.data(), src.Sources.size(), dst.SourcesOffset, dst.SourcesLength);
+                if (object_entry_get_type(&src.ObjectEntry) == OBJECT_TYPE_RIDE)
+                {
+                    dst.RideFlags = src.RideInfo.RideFlags;
+                    std::copy_n(src.RideInfo.RideCategory, MAX_CATEGORIES_PER_RIDE, dst.RideCategory);
+                    std::copy_n(src.RideInfo.RideType, MAX_RIDE_TYPES_PER_RIDE_ENTRY, dst.RideType);
+                    dst.RideGroupIndex = src.RideInfo.RideGroupIndex;
+                }
+                dst.SceneryEntriesIndex = (uint32_t)entries.size();
+                dst.SceneryEntriesCount = (uint32_t)src.SceneryGroupInfo.Entries.size();
+                entries.insert(entries.end(), src.SceneryGroupInfo.Entries.begin(), src.SceneryGroupInfo.Entries.end());
+            }
+
+            ObjectSnapshotHeader header{};
+            header.MagicNumber = SNAPSHOT_MAGIC_NUMBER;
+            header.Version = SNAPSHOT_VERSION;
+            header.Fingerprint = fingerprint;
+            header.NumItems = (uint32_t)items.size();
+            header.ItemsOffset = sizeof(header);
+            header.NumEntries = (uint32_t)entries.size();
+            header.EntriesOffset = header.ItemsOffset + header.NumItems * sizeof(ObjectSnapshotItem);
+            header.NumSlots = (uint32_t)_itemMap.GetNumSlots();
+            header.SlotsOffset = header.EntriesOffset + header.NumEntries * sizeof(rct_object_entry);
+            header.StringsLength = (uint32_t)strings.size();
+            header.StringsOffset = header.SlotsOffset + header.NumSlots * sizeof(ObjectSnapshotSlot);
+
+            auto ms = MemoryStream();
+            ms.WriteValue(header);
+            ms.WriteArray(items.data(), items.size());
+            ms.WriteArray(entries.data(), entries.size());
+            for (size_t i = 0; i < _itemMap.GetNumSlots(); i++)
+            {
+                ObjectSnapshotSlot slot;
+                std::tie(slot.Name, slot.Index) = _itemMap.GetSlot(i);
+                ms.WriteValue(slot);
+            }
+            ms.Write(strings.data(), strings.size());
+
+            Path::CreateDirectory(Path::GetDirectory(path));
+            File::WriteAllBytes(path, ms.GetData(), ms.GetLength());
+        }
+        catch (const std::exception& e)
+        {
+            log_warning("Unable to write object repository snapshot: %s", e.what());
+        }
+    }
+
     void ClearItems()
     {
         _items.clear();
-        _itemMap.clear();
+        _itemMap.Clear();
     }
 
     void SortItems()
@@ -414,11 +744,10 @@ private:
         }
 
         // Rebuild item map
-        _itemMap.clear();
+        _itemMap.Clear();
         for (size_t i = 0; i < _items.size(); i++)
         {
-            rct_object_entry entry = _items[i].ObjectEntry;
-            _itemMap[entry] = i;
+            _itemMap.Set(_items[i].ObjectEntry, i);
         }
     }
 
@@ -447,7 +776,7 @@ private:
             auto copy = item;
             copy.Id = index;
             _items.push_back(copy);
-            _itemMap[item.ObjectEntry] = index;
+            _itemMap.Set(item.ObjectEntry, index);
             return true;
         }
         else
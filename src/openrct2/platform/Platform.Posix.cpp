@@ -13,10 +13,22 @@
 #    include "Platform2.h"
 #    include "platform.h"
 
+#    include <cerrno>
 #    include <cstdlib>
 #    include <cstring>
 #    include <ctime>
+#    include <fcntl.h>
 #    include <pwd.h>
+#    include <sys/wait.h>
+#    include <unistd.h>
+
+// posix_spawn is only available from Android API level 28
+#    if !defined(__ANDROID__) || __ANDROID_API__ >= 28
+#        define HAVE_POSIX_SPAWN
+#        include <spawn.h>
+#    endif
+
+extern char** environ;
 
 namespace Platform
 {
@@ -96,6 +108,96 @@ namespace Platform
         }
         return isSupported;
     }
+
+    int32_t Execute(const std::vector<std::string>& args, std::string* output)
+    {
+        if (args.empty())
+        {
+            return -1;
+        }
+
+        std::vector<char*> argv;
+        for (const auto& arg : args)
+        {
+            argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+
+        // Both ends are closed on exec, otherwise children started by other threads at the same time would
+        // inherit the write end and the read below would not end until those children exit.
+        int pipeFds[2];
+#    ifdef __APPLE__
+        if (pipe(pipeFds) != 0)
+        {
+            return -1;
+        }
+        fcntl(pipeFds[0], F_SETFD, FD_CLOEXEC);
+        fcntl(pipeFds[1], F_SETFD, FD_CLOEXEC);
+#    else
+        if (pipe2(pipeFds, O_CLOEXEC) != 0)
+        {
+            return -1;
+        }
+#    endif
+
+        // The child writes its standard output to the pipe, dup2 clears close on exec for it
+        pid_t pid;
+#    ifdef HAVE_POSIX_SPAWN
+        posix_spawn_file_actions_t fileActions;
+        posix_spawn_file_actions_init(&fileActions);
+        posix_spawn_file_actions_adddup2(&fileActions, pipeFds[1], STDOUT_FILENO);
+
+        int spawnResult = posix_spawn(&pid, argv[0], &fileActions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&fileActions);
+        bool spawned = spawnResult == 0;
+#    else
+        pid = fork();
+        if (pid == 0)
+        {
+            if (dup2(pipeFds[1], STDOUT_FILENO) != -1)
+            {
+                execv(argv[0], argv.data());
+            }
+            _exit(127);
+        }
+        bool spawned = pid > 0;
+#    endif
+        close(pipeFds[1]);
+        if (!spawned)
+        {
+            close(pipeFds[0]);
+            return -1;
+        }
+
+        char buffer[1024];
+        ssize_t readBytes;
+        while ((readBytes = read(pipeFds[0], buffer, sizeof(buffer))) != 0)
+        {
+            if (readBytes < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+            if (output != nullptr)
+            {
+                output->append(buffer, readBytes);
+            }
+        }
+        close(pipeFds[0]);
+
+        int status;
+        while (waitpid(pid, &status, 0) == -1)
+        {
+            if (errno != EINTR)
+                return -1;
+        }
+        if (!WIFEXITED(status))
+        {
+            return -1;
+        }
+        return WEXITSTATUS(status);
+    }
 } // namespace Platform
 
 #endif
@@ -277,6 +277,107 @@ namespace Platform
         return isSupported;
     }
 
+    // Quotes an argument so CommandLineToArgvW and the C runtime parse it back to the same string.
+    static std::wstring WIN32_QuoteArgument(const std::wstring& arg)
+    {
+        if (!arg.empty() && arg.find_first_of(L" \t\n\v\"") == std::wstring::npos)
+        {
+            return arg;
+        }
+
+        std::wstring result = L"\"";
+        size_t numBackslashes = 0;
+        for (auto c : arg)
+        {
+            if (c == L'\\')
+            {
+                numBackslashes++;
+                continue;
+            }
+            if (c == L'"')
+            {
+                // Backslashes before a quote are escaped, as is the quote itself
+                result.append(numBackslashes * 2 + 1, L'\\');
+            }
+            else
+            {
+                result.append(numBackslashes, L'\\');
+            }
+            numBackslashes = 0;
+            result.push_back(c);
+        }
+        // Backslashes before the closing quote are escaped
+        result.append(numBackslashes * 2, L'\\');
+        result.push_back(L'"');
+        return result;
+    }
+
+    int32_t Execute(const std::vector<std::string>& args, std::string* output)
+    {
+        if (args.empty())
+        {
+            return -1;
+        }
+
+        std::wstring commandLine;
+        for (const auto& arg : args)
+        {
+            if (!commandLine.empty())
+            {
+                commandLine.push_back(L' ');
+            }
+            commandLine += WIN32_QuoteArgument(String::ToWideChar(arg));
+        }
+
+        SECURITY_ATTRIBUTES securityAttributes{};
+        securityAttributes.nLength = sizeof(securityAttributes);
+        securityAttributes.bInheritHandle = TRUE;
+        HANDLE readPipe, writePipe;
+        if (!CreatePipe(&readPipe, &writePipe, &securityAttributes, 0))
+        {
+            return -1;
+        }
+        // Only the write end is passed on to the child
+        SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0);
+
+        STARTUPINFOW startupInfo{};
+        startupInfo.cb = sizeof(startupInfo);
+        startupInfo.dwFlags = STARTF_USESTDHANDLES;
+        startupInfo.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+        startupInfo.hStdOutput = writePipe;
+        startupInfo.hStdError = GetStdHandle(STD_ERROR_HANDLE);
+
+        PROCESS_INFORMATION processInfo{};
+        auto applicationName = String::ToWideChar(args[0]);
+        BOOL created = CreateProcessW(
+            applicationName.c_str(), commandLine.data(), nullptr, nullptr, TRUE, 0, nullptr, nullptr, &startupInfo,
+            &processInfo);
+        CloseHandle(writePipe);
+        if (!created)
+        {
+            CloseHandle(readPipe);
+            return -1;
+        }
+
+        char buffer[1024];
+        DWORD readBytes;
+        while (ReadFile(readPipe, buffer, sizeof(buffer), &readBytes, nullptr) && readBytes > 0)
+        {
+            if (output != nullptr)
+            {
+                output->append(buffer, readBytes);
+            }
+        }
+        CloseHandle(readPipe);
+
+        DWORD exitCode = (DWORD)-1;
+        WaitForSingleObject(processInfo.hProcess, INFINITE);
+        GetExitCodeProcess(processInfo.hProcess, &exitCode);
+        CloseHandle(processInfo.hThread);
+        CloseHandle(processInfo.hProcess);
+        return (int32_t)exitCode;
+    }
+
 #    ifdef __USE_SHGETKNOWNFOLDERPATH__
     static std::string WIN32_GetKnownFolderPath(REFKNOWNFOLDERID rfid)
     {
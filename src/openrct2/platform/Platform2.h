@@ -13,6 +13,7 @@
 
 #include <ctime>
 #include <string>
+#include <vector>
 
 enum class SPECIAL_FOLDER
 {
@@ -46,6 +47,9 @@ namespace Platform
 #endif
 
     bool IsColourTerminalSupported();
+    // Starts the program args[0] with the given arguments, without a shell, and waits for it to finish. Returns the
+    // exit code of the program or -1 if it could not be run. Standard output is appended to output if given.
+    int32_t Execute(const std::vector<std::string>& args, std::string* output = nullptr);
     bool HandleSpecialCommandLineArgument(const char* argument);
     uintptr_t StrDecompToPrecomp(utf8* input);
 } // namespace Platform
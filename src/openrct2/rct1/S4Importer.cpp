@@ -20,7 +20,6 @@
 #include "../core/FileStream.hpp"
 #include "../core/Guard.hpp"
 #include "../core/IStream.hpp"
-#include "../core/Memory.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../interface/Window.h"
@@ -34,6 +33,8 @@
 #include "../object/ObjectRepository.h"
 #include "../peep/Peep.h"
 #include "../peep/Staff.h"
+#include "../rct12/SawyerChunkReader.h"
+#include "../rct12/SawyerEncoding.h"
 #include "../ride/RideData.h"
 #include "../ride/Station.h"
 #include "../ride/Track.h"
@@ -102,6 +103,7 @@ class S4Importer final : public IParkImporter
 private:
     std::string _s4Path;
     rct1_s4 _s4 = {};
+    size_t _peakLoadMemory = 0;
     uint8_t _gameVersion = 0;
     uint8_t _parkValueConversionFactor = 0;
     bool _isScenario = false;
@@ -168,7 +170,7 @@ public:
     ParkLoadResult LoadFromStream(
         IStream* stream, bool isScenario, [[maybe_unused]] bool skipObjectCheck, const utf8* path) override
     {
-        _s4 = *ReadAndDecodeS4(stream, isScenario);
+        ReadAndDecodeS4(stream, isScenario);
         _s4Path = path;
         _isScenario = isScenario;
 
@@ -188,6 +190,8 @@ public:
         ImportRides();
         ImportRideMeasurements();
         ImportSprites();
+        // Fix-ups below can remove guests from queues, which needs the index
+        ride_reset_all_queue_indexes();
         ImportTileElements();
         ImportPeepSpawns();
         ImportFinance();
@@ -287,36 +291,35 @@ public:
         return (oldParkValue * _parkValueConversionFactor) / 10;
     }
 
-private:
-    std::unique_ptr<rct1_s4> ReadAndDecodeS4(IStream* stream, bool isScenario)
+    size_t GetPeakLoadMemory() const override
     {
-        auto s4 = std::make_unique<rct1_s4>();
-        size_t dataSize = stream->GetLength() - stream->GetPosition();
-        auto deleter_lambda = [dataSize](uint8_t* ptr) { Memory::FreeArray(ptr, dataSize); };
-        auto data = std::unique_ptr<uint8_t, decltype(deleter_lambda)>(stream->ReadArray<uint8_t>(dataSize), deleter_lambda);
-        auto decodedData = std::unique_ptr<uint8_t, decltype(&Memory::Free<uint8_t>)>(
-            Memory::Allocate<uint8_t>(sizeof(rct1_s4)), &Memory::Free<uint8_t>);
+        return _peakLoadMemory;
+    }
 
-        size_t decodedSize;
-        int32_t fileType = sawyercoding_detect_file_type(data.get(), dataSize);
-        if (isScenario && (fileType & FILE_VERSION_MASK) != FILE_VERSION_RCT1)
-        {
-            decodedSize = sawyercoding_decode_sc4(data.get(), decodedData.get(), dataSize, sizeof(rct1_s4));
-        }
-        else
+private:
+    void ReadAndDecodeS4(IStream* stream, bool isScenario)
+    {
+        // Decode straight into _s4 rather than holding the file and a decoded copy in memory
+        bool isEncrypted = false;
+        if (isScenario)
         {
-            decodedSize = sawyercoding_decode_sv4(data.get(), decodedData.get(), dataSize, sizeof(rct1_s4));
+            int32_t fileType = SawyerEncoding::DetectRCT1FileType(stream);
+            isEncrypted = (fileType & FILE_VERSION_MASK) != FILE_VERSION_RCT1;
         }
 
-        if (decodedSize == sizeof(rct1_s4))
+        auto chunkReader = SawyerChunkReader(stream);
+        size_t decodedSize = chunkReader.ReadChunkTrack(&_s4, sizeof(rct1_s4));
+        if (decodedSize != sizeof(rct1_s4))
         {
-            std::memcpy(s4.get(), decodedData.get(), sizeof(rct1_s4));
-            return s4;
+            throw std::runtime_error("Unable to decode park.");
         }
-        else
+        if (isEncrypted)
         {
-            throw std::runtime_error("Unable to decode park.");
+            sawyercoding_decrypt_sc4((uint8_t*)&_s4, decodedSize);
         }
+
+        _peakLoadMemory = chunkReader.GetPeakBufferSize();
+        log_verbose("S4 load peak buffer memory: %zu bytes", _peakLoadMemory);
     }
 
     void Initialise()
@@ -1138,12 +1141,15 @@ private:
         dst.current_item = src.current_item;
         dst.vehicle_index = src.vehicle_index;
         dst.current_station = src.current_station;
-        for (size_t i = 0; i < std::size(src.velocity); i++)
-        {
-            dst.velocity[i] = src.velocity[i] / 2;
-            dst.altitude[i] = src.altitude[i] / 2;
-            dst.vertical[i] = src.vertical[i] / 2;
-            dst.lateral[i] = src.lateral[i] / 2;
+        auto numSamples = std::min<size_t>(std::max(src.num_items, src.current_item), std::size(src.velocity));
+        for (size_t i = 0; i < numSamples; i++)
+        {
+            RideMeasurementSample sample;
+            sample.velocity = src.velocity[i] / 2;
+            sample.altitude = src.altitude[i] / 2;
+            sample.vertical = src.vertical[i] / 2;
+            sample.lateral = src.lateral[i] / 2;
+            dst.samples.Set(i, sample);
         }
     }
 
@@ -10,6 +10,9 @@
 #include "SawyerChunkReader.h"
 
 #include "../core/IStream.hpp"
+#include "../util/Util.h"
+
+#include <algorithm>
 
 // malloc is very slow for large allocations in MSVC debug builds as it allocates
 // memory on a special debug heap and then initialises all the memory to 0xCC.
@@ -22,6 +25,9 @@
 // Allow chunks to be uncompressed to a maximum of 16 MiB
 constexpr size_t MAX_UNCOMPRESSED_CHUNK_SIZE = 16 * 1024 * 1024;
 
+// Compressed data decoded straight into a destination buffer is read in blocks of this size
+constexpr size_t STREAM_BLOCK_SIZE = 64 * 1024;
+
 constexpr const char* EXCEPTION_MSG_CORRUPT_CHUNK_SIZE = "Corrupt chunk size.";
 constexpr const char* EXCEPTION_MSG_CORRUPT_RLE = "Corrupt RLE compression data.";
 constexpr const char* EXCEPTION_MSG_DESTINATION_TOO_SMALL = "Chunk data larger than allocated destination capacity.";
@@ -41,6 +47,240 @@ public:
     }
 };
 
+/**
+ * Reads the compressed data of a chunk from the stream one block at a time.
+ */
+class SawyerChunkStreamSource final
+{
+private:
+    IStream* const _stream;
+    uint64_t _remaining;
+    std::unique_ptr<uint8_t[]> _buffer;
+    size_t _position = 0;
+    size_t _length = 0;
+
+public:
+    SawyerChunkStreamSource(IStream* stream, uint64_t length)
+        : _stream(stream)
+        , _remaining(length)
+        , _buffer(std::make_unique<uint8_t[]>(STREAM_BLOCK_SIZE))
+    {
+    }
+
+    bool IsEnd() const
+    {
+        return _position == _length && _remaining == 0;
+    }
+
+    uint8_t ReadByte()
+    {
+        if (_position == _length)
+        {
+            Refill();
+        }
+        return _buffer[_position++];
+    }
+
+    void Read(uint8_t* dst, size_t length)
+    {
+        while (length > 0)
+        {
+            if (_position == _length)
+            {
+                Refill();
+            }
+            auto copyLength = std::min(length, _length - _position);
+            std::memcpy(dst, &_buffer[_position], copyLength);
+            _position += copyLength;
+            dst += copyLength;
+            length -= copyLength;
+        }
+    }
+
+private:
+    void Refill()
+    {
+        if (_remaining == 0)
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
+        }
+        auto readLength = (size_t)std::min<uint64_t>(_remaining, STREAM_BLOCK_SIZE);
+        if (_stream->TryRead(_buffer.get(), readLength) != readLength)
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+        }
+        _remaining -= readLength;
+        _position = 0;
+        _length = readLength;
+    }
+};
+
+/**
+ * Writes decoded chunk data to a fixed size buffer, dropping anything before the offset and past the end of
+ * the buffer. The last bytes before the offset are kept so that repeat encoded data can still refer to them.
+ */
+class SawyerChunkBufferSink final
+{
+private:
+    static constexpr size_t HISTORY_SIZE = 32;
+
+    uint8_t* const _dst;
+    size_t const _offset;
+    size_t const _end;
+    size_t _position = 0;
+    uint8_t _history[HISTORY_SIZE]{};
+
+public:
+    SawyerChunkBufferSink(void* dst, size_t offset, size_t length)
+        : _dst(static_cast<uint8_t*>(dst))
+        , _offset(offset)
+        , _end(offset + length)
+    {
+    }
+
+    size_t GetLength() const
+    {
+        return _position > _offset ? _position - _offset : 0;
+    }
+
+    bool IsFull() const
+    {
+        return _position == _end;
+    }
+
+    void Write(const uint8_t* src, size_t length)
+    {
+        for (; length > 0 && _position < _offset; length--)
+        {
+            Push(*src++);
+        }
+        length = std::min(length, _end - _position);
+        std::memcpy(_dst + (_position - _offset), src, length);
+        _position += length;
+    }
+
+    void Fill(uint8_t value, size_t count)
+    {
+        for (; count > 0 && _position < _offset; count--)
+        {
+            Push(value);
+        }
+        count = std::min(count, _end - _position);
+        std::fill_n(_dst + (_position - _offset), count, value);
+        _position += count;
+    }
+
+    /**
+     * Appends count bytes copied from distance bytes back in the already written data.
+     */
+    void Repeat(size_t distance, size_t count)
+    {
+        if (IsFull())
+        {
+            return;
+        }
+        if (distance > _position || distance > HISTORY_SIZE)
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_RLE);
+        }
+        count = std::min(count, _end - _position);
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t from = _position - distance;
+            Push(from < _offset ? _history[from % HISTORY_SIZE] : _dst[from - _offset]);
+        }
+    }
+
+private:
+    void Push(uint8_t value)
+    {
+        if (_position < _offset)
+        {
+            _history[_position % HISTORY_SIZE] = value;
+        }
+        else
+        {
+            _dst[_position - _offset] = value;
+        }
+        _position++;
+    }
+};
+
+/**
+ * Decodes the repeat encoding of RLE decoded data as it is produced, writing the result to a buffer sink.
+ */
+class SawyerChunkRepeatSink final
+{
+private:
+    SawyerChunkBufferSink& _sink;
+    bool _literalPending = false;
+
+public:
+    explicit SawyerChunkRepeatSink(SawyerChunkBufferSink& sink)
+        : _sink(sink)
+    {
+    }
+
+    bool IsFull() const
+    {
+        return _sink.IsFull();
+    }
+
+    void Write(const uint8_t* src, size_t length)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            Push(src[i]);
+        }
+    }
+
+    void Fill(uint8_t value, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            Push(value);
+        }
+    }
+
+private:
+    void Push(uint8_t code)
+    {
+        if (_literalPending)
+        {
+            _sink.Write(&code, 1);
+            _literalPending = false;
+        }
+        else if (code == 0xFF)
+        {
+            _literalPending = true;
+        }
+        else
+        {
+            _sink.Repeat(32 - (code >> 3), (code & 7) + 1);
+        }
+    }
+};
+
+template<typename TSink> static void DecodeChunkRLEStream(SawyerChunkStreamSource& src, TSink& sink)
+{
+    uint8_t literal[128];
+    while (!src.IsEnd() && !sink.IsFull())
+    {
+        uint8_t rleCodeByte = src.ReadByte();
+        if (rleCodeByte & 128)
+        {
+            size_t count = 257 - rleCodeByte;
+            sink.Fill(src.ReadByte(), count);
+        }
+        else
+        {
+            size_t count = rleCodeByte + 1;
+            src.Read(literal, count);
+            sink.Write(literal, count);
+        }
+    }
+}
+
 SawyerChunkReader::SawyerChunkReader(IStream* stream)
     : _stream(stream)
 {
@@ -78,6 +318,9 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunk()
             case CHUNK_ENCODING_RLECOMPRESSED:
             case CHUNK_ENCODING_ROTATE:
             {
+                size_t largeBufferCount = header.encoding == CHUNK_ENCODING_RLECOMPRESSED ? 2 : 1;
+                UpdatePeakBufferSize(header.length + largeBufferCount * MAX_UNCOMPRESSED_CHUNK_SIZE);
+
                 std::unique_ptr<uint8_t[]> compressedData(new uint8_t[header.length]);
                 if (_stream->TryRead(compressedData.get(), header.length) != header.length)
                 {
@@ -117,6 +360,7 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunkTrack()
             throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
         }
         uint32_t compressedDataLength = compressedDataLength64;
+        UpdatePeakBufferSize(compressedDataLength + MAX_UNCOMPRESSED_CHUNK_SIZE);
         auto compressedData = std::make_unique<uint8_t[]>(compressedDataLength);
 
         if (_stream->TryRead(compressedData.get(), compressedDataLength) != compressedDataLength)
@@ -144,25 +388,137 @@ std::shared_ptr<SawyerChunk> SawyerChunkReader::ReadChunkTrack()
 
 void SawyerChunkReader::ReadChunk(void* dst, size_t length)
 {
-    auto chunk = ReadChunk();
-    auto chunkData = (const uint8_t*)chunk->GetData();
-    auto chunkLength = chunk->GetLength();
-    if (chunkLength > length)
+    ReadChunkPartial(dst, 0, length);
+}
+
+size_t SawyerChunkReader::ReadChunkPartial(void* dst, size_t offset, size_t length)
+{
+    uint64_t originalPosition = _stream->GetPosition();
+    try
+    {
+        auto header = _stream->ReadValue<sawyercoding_chunk_header>();
+        if (header.length >= MAX_UNCOMPRESSED_CHUNK_SIZE)
+            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+
+        uint64_t chunkEnd = _stream->GetPosition() + header.length;
+        if (chunkEnd > _stream->GetLength())
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+        }
+
+        size_t decodedLength = DecodeChunkStream(dst, offset, length, header.encoding, header.length);
+        if (decodedLength == 0 && offset == 0)
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+        }
+
+        // Skip whatever was not needed for the destination
+        _stream->SetPosition(chunkEnd);
+        std::fill_n((uint8_t*)dst + decodedLength, length - decodedLength, 0x00);
+        return decodedLength;
+    }
+    catch (const std::exception&)
+    {
+        // Rewind stream back to original position
+        _stream->SetPosition(originalPosition);
+        throw;
+    }
+}
+
+size_t SawyerChunkReader::ReadChunkTrack(void* dst, size_t length)
+{
+    uint64_t originalPosition = _stream->GetPosition();
+    try
+    {
+        // Remove 4 as we don't want to touch the checksum at the end of the file
+        int64_t compressedDataLength64 = _stream->GetLength() - _stream->GetPosition() - 4;
+        if (compressedDataLength64 < 0 || compressedDataLength64 > std::numeric_limits<uint32_t>::max())
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+        }
+
+        size_t decodedLength = DecodeChunkStream(dst, 0, length, CHUNK_ENCODING_RLE, (size_t)compressedDataLength64);
+        if (decodedLength == 0)
+        {
+            throw SawyerChunkException(EXCEPTION_MSG_ZERO_SIZED_CHUNK);
+        }
+
+        _stream->SetPosition(originalPosition + compressedDataLength64);
+        std::fill_n((uint8_t*)dst + decodedLength, length - decodedLength, 0x00);
+        return decodedLength;
+    }
+    catch (const std::exception&)
     {
-        std::memcpy(dst, chunkData, length);
+        // Rewind stream back to original position
+        _stream->SetPosition(originalPosition);
+        throw;
     }
-    else
+}
+
+size_t SawyerChunkReader::DecodeChunkStream(
+    void* dst, size_t offset, size_t length, uint8_t encoding, size_t compressedLength)
+{
+    switch (encoding)
     {
-        std::memcpy(dst, chunkData, chunkLength);
-        auto remainingLength = length - chunkLength;
-        if (remainingLength > 0)
+        case CHUNK_ENCODING_NONE:
+        case CHUNK_ENCODING_ROTATE:
         {
-            auto offset = (uint8_t*)dst + chunkLength;
-            std::fill_n(offset, remainingLength, 0x00);
+            // The data is already its decoded size, so it can be read straight into the destination
+            if (offset >= compressedLength)
+            {
+                return 0;
+            }
+            _stream->Seek(offset, STREAM_SEEK_CURRENT);
+            auto readLength = std::min(length, compressedLength - offset);
+            auto dst8 = static_cast<uint8_t*>(dst);
+            if (_stream->TryRead(dst8, readLength) != readLength)
+            {
+                throw SawyerChunkException(EXCEPTION_MSG_CORRUPT_CHUNK_SIZE);
+            }
+            if (encoding == CHUNK_ENCODING_ROTATE)
+            {
+                if (offset % 4 == 0)
+                {
+                    sawyercoding_rotate(dst8, dst8, readLength, false);
+                }
+                else
+                {
+                    // The rotation cycles every 4 bytes from the start of the chunk
+                    for (size_t i = 0; i < readLength; i++)
+                    {
+                        dst8[i] = ror8(dst8[i], 1 + 2 * ((offset + i) % 4));
+                    }
+                }
+            }
+            return readLength;
+        }
+        case CHUNK_ENCODING_RLE:
+        case CHUNK_ENCODING_RLECOMPRESSED:
+        {
+            UpdatePeakBufferSize(STREAM_BLOCK_SIZE);
+            SawyerChunkStreamSource source(_stream, compressedLength);
+            SawyerChunkBufferSink sink(dst, offset, length);
+            if (encoding == CHUNK_ENCODING_RLE)
+            {
+                DecodeChunkRLEStream(source, sink);
+            }
+            else
+            {
+                SawyerChunkRepeatSink repeatSink(sink);
+                DecodeChunkRLEStream(source, repeatSink);
+            }
+            return sink.GetLength();
         }
+        default:
+            throw SawyerChunkException(EXCEPTION_MSG_INVALID_CHUNK_ENCODING);
     }
 }
 
+void SawyerChunkReader::UpdatePeakBufferSize(size_t size)
+{
+    _peakBufferSize = std::max(_peakBufferSize, size);
+}
+
 size_t SawyerChunkReader::DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header)
 {
     size_t resultLength;
@@ -283,14 +639,7 @@ size_t SawyerChunkReader::DecodeChunkRotate(void* dst, size_t dstCapacity, const
         throw SawyerChunkException(EXCEPTION_MSG_DESTINATION_TOO_SMALL);
     }
 
-    auto src8 = static_cast<const uint8_t*>(src);
-    auto dst8 = static_cast<uint8_t*>(dst);
-    uint8_t code = 1;
-    for (size_t i = 0; i < srcLength; i++)
-    {
-        dst8[i] = ror8(src8[i], code);
-        code = (code + 2) % 8;
-    }
+    sawyercoding_rotate(static_cast<uint8_t*>(dst), static_cast<const uint8_t*>(src), srcLength, false);
     return srcLength;
 }
 
@@ -25,6 +25,7 @@ class SawyerChunkReader final
 {
 private:
     IStream* const _stream = nullptr;
+    size_t _peakBufferSize = 0;
 
 public:
     explicit SawyerChunkReader(IStream* stream);
@@ -46,15 +47,32 @@ public:
     std::shared_ptr<SawyerChunk> ReadChunkTrack();
 
     /**
-     * Reads the next chunk from the stream and copies it directly to the
+     * As above but decodes directly into the destination buffer, with the same
+     * truncation and padding as ReadChunk(void*, size_t).
+     * @returns The number of bytes decoded into the destination buffer.
+     */
+    size_t ReadChunkTrack(void* dst, size_t length);
+
+    /**
+     * Reads the next chunk from the stream and decodes it directly into the
      * destination buffer. If the chunk is larger than length, only length
-     * is copied. If the chunk is smaller than length, the remaining space
-     * is padded with zero.
+     * is decoded. If the chunk is smaller than length, the remaining space
+     * is padded with zero. Compressed data is streamed in small blocks, so
+     * no buffer the size of the chunk is allocated.
      * @param dst The destination buffer.
      * @param length The size of the destination buffer.
      */
     void ReadChunk(void* dst, size_t length);
 
+    /**
+     * As above but only decodes the chunk as far as needed to copy length bytes,
+     * starting at offset, into the destination buffer. Anything before the offset
+     * is decoded into a small window and discarded, so the start of a large chunk
+     * can be skipped without a buffer for it.
+     * @returns The number of bytes decoded into the destination buffer.
+     */
+    size_t ReadChunkPartial(void* dst, size_t offset, size_t length);
+
     /**
      * Reads the next chunk from the stream into a buffer returned as the
      * specified type. If the chunk is smaller than the size of the type
@@ -67,7 +85,19 @@ public:
         return result;
     }
 
+    /**
+     * Gets the largest amount of temporary buffer memory, in bytes, that this
+     * reader has held at once while reading chunks.
+     */
+    size_t GetPeakBufferSize() const
+    {
+        return _peakBufferSize;
+    }
+
 private:
+    size_t DecodeChunkStream(void* dst, size_t offset, size_t length, uint8_t encoding, size_t compressedLength);
+    void UpdatePeakBufferSize(size_t size);
+
     static size_t DecodeChunk(void* dst, size_t dstCapacity, const void* src, const sawyercoding_chunk_header& header);
     static size_t DecodeChunkRLERepeat(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
     static size_t DecodeChunkRLE(void* dst, size_t dstCapacity, const void* src, size_t srcLength);
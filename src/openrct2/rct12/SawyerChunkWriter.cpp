@@ -12,6 +12,8 @@
 #include "../core/IStream.hpp"
 #include "../util/SawyerCoding.h"
 
+#include <algorithm>
+
 // Maximum buffer size to store compressed data, maximum of 16 MiB
 constexpr size_t MAX_COMPRESSED_CHUNK_SIZE = 16 * 1024 * 1024;
 
@@ -61,11 +63,7 @@ static size_t EncodeChunkRLE(const uint8_t* src_buffer, uint8_t* dst_buffer, siz
         }
         if (*src == src[1])
         {
-            for (; (count < 125) && ((src + count) < end_src); count++)
-            {
-                if (*src != src[count])
-                    break;
-            }
+            count = (uint8_t)sawyercoding_rle_count_run(src, std::min<size_t>(125, end_src - src));
             *dst++ = 257 - count;
             *dst++ = *src;
             src += count;
@@ -74,8 +72,10 @@ static size_t EncodeChunkRLE(const uint8_t* src_buffer, uint8_t* dst_buffer, siz
         }
         else
         {
-            count++;
-            src++;
+            // Skip all bytes up to the next run, but stop when the literal block is full.
+            size_t literals = sawyercoding_rle_count_literals(src, std::min<size_t>(126 - count, end_src - 1 - src));
+            count += (uint8_t)literals;
+            src += literals;
         }
     }
     if (src == end_src - 1)
@@ -10,6 +10,7 @@
 #include "SawyerEncoding.h"
 
 #include "../core/IStream.hpp"
+#include "../util/SawyerCoding.h"
 #include "RCT12.h"
 
 #include <algorithm>
@@ -102,4 +103,47 @@ namespace SawyerEncoding
             return RCT12TrackDesignVersion::unknown;
         }
     }
+
+    // Streamed equivalent of sawyercoding_detect_file_type
+    int32_t DetectRCT1FileType(IStream* stream)
+    {
+        uint64_t initialPosition = stream->GetPosition();
+        uint64_t dataSize = stream->GetLength() - initialPosition;
+        if (dataSize < 4)
+        {
+            return -1;
+        }
+        dataSize -= 4;
+
+        try
+        {
+            uint32_t actualChecksum = 0;
+            while (dataSize != 0)
+            {
+                uint8_t buffer[4096];
+                uint64_t bufferSize = std::min<uint64_t>(dataSize, sizeof(buffer));
+                stream->Read(buffer, bufferSize);
+
+                for (uint64_t i = 0; i < bufferSize; i++)
+                {
+                    actualChecksum = (actualChecksum & 0xFFFFFF00) | (((actualChecksum & 0xFF) + buffer[i]) & 0xFF);
+                    actualChecksum = rol32(actualChecksum, 3);
+                }
+
+                dataSize -= bufferSize;
+            }
+
+            uint32_t checksum = stream->ReadValue<uint32_t>();
+
+            // Rewind back to original position
+            stream->SetPosition(initialPosition);
+            return sawyercoding_detect_rct1_version(checksum - actualChecksum);
+        }
+        catch (const std::exception&)
+        {
+            // Rewind back to original position
+            stream->SetPosition(initialPosition);
+            return -1;
+        }
+    }
 } // namespace SawyerEncoding
@@ -19,4 +19,5 @@ namespace SawyerEncoding
 {
     bool ValidateChecksum(IStream* stream);
     RCT12TrackDesignVersion ValidateTrackChecksum(IStream* stream);
+    int32_t DetectRCT1FileType(IStream* stream);
 } // namespace SawyerEncoding
@@ -32,6 +32,7 @@
 #include "../object/ObjectManager.h"
 #include "../object/ObjectRepository.h"
 #include "../peep/Staff.h"
+#include "../platform/platform.h"
 #include "../rct12/SawyerChunkWriter.h"
 #include "../ride/Ride.h"
 #include "../ride/RideRatings.h"
@@ -47,9 +48,16 @@
 #include "../world/Sprite.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <functional>
+#include <future>
 #include <iterator>
+#include <memory>
+
+double gScenarioSavePauseTime = 0;
+
+static std::future<bool> _scenarioSaveTask;
 
 S6Exporter::S6Exporter()
 {
@@ -815,16 +823,26 @@ void S6Exporter::ExportRideMeasurement(RCT12RideMeasurement& dst, const RideMeas
 {
     dst.flags = src.flags;
     dst.last_use_tick = src.last_use_tick;
-    dst.num_items = src.num_items;
-    dst.current_item = src.current_item;
+    // The saved measurement holds a fixed number of samples. Longer measurements keep the samples leading up to the
+    // current item, so the graph still ends with the latest part of the run. S6 has no room for the number of dropped
+    // samples, a loaded measurement starts counting from the first saved sample.
+    constexpr size_t maxItems = RCT12_RIDE_MEASUREMENT_MAX_ITEMS;
+    size_t firstItem = 0;
+    if (src.num_items > maxItems && src.current_item > maxItems)
+    {
+        firstItem = src.current_item - maxItems;
+    }
+    dst.num_items = (uint16_t)std::min<size_t>(src.num_items - firstItem, maxItems);
+    dst.current_item = (uint16_t)std::min<size_t>(src.current_item - firstItem, maxItems);
     dst.vehicle_index = src.vehicle_index;
     dst.current_station = src.current_station;
-    for (size_t i = 0; i < std::size(src.velocity); i++)
+    for (size_t i = 0; i < maxItems; i++)
     {
-        dst.velocity[i] = src.velocity[i];
-        dst.altitude[i] = src.altitude[i];
-        dst.vertical[i] = src.vertical[i];
-        dst.lateral[i] = src.lateral[i];
+        auto sample = src.GetSample(firstItem + i);
+        dst.velocity[i] = sample.velocity;
+        dst.altitude[i] = sample.altitude;
+        dst.vertical[i] = sample.vertical;
+        dst.lateral[i] = sample.lateral;
     }
 }
 
@@ -1600,6 +1618,68 @@ enum : uint32_t
     S6_SAVE_FLAG_AUTOMATIC = 1u << 31,
 };
 
+/**
+ * Copies the current game state into a new exporter, this must happen on the game thread at a tick boundary.
+ */
+static std::unique_ptr<S6Exporter> scenario_save_capture(int32_t flags)
+{
+    if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
+    {
+        window_close_construction_windows();
+    }
+
+    map_reorganise_elements();
+    viewport_set_saved_view();
+
+    auto s6exporter = std::make_unique<S6Exporter>();
+    if (flags & S6_SAVE_FLAG_EXPORT)
+    {
+        auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
+        s6exporter->ExportObjectsList = objManager.GetPackableObjects();
+    }
+    s6exporter->RemoveTracklessRides = true;
+    s6exporter->Export();
+    return s6exporter;
+}
+
+/**
+ * Encodes the captured state to a temporary file next to path and moves it into place once complete, so that a
+ * crash or error during the save never leaves a truncated file behind.
+ */
+static bool scenario_save_write(S6Exporter& s6exporter, const std::string& path, int32_t flags)
+{
+    auto tempPath = path + ".tmp";
+    try
+    {
+        if (flags & S6_SAVE_FLAG_SCENARIO)
+        {
+            s6exporter.SaveScenario(tempPath.c_str());
+        }
+        else
+        {
+            s6exporter.SaveGame(tempPath.c_str());
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
+        platform_file_delete(tempPath.c_str());
+        return false;
+    }
+
+    // Windows will not move over an existing file.
+    if (platform_file_exists(path.c_str()))
+    {
+        platform_file_delete(path.c_str());
+    }
+    if (!platform_file_move(tempPath.c_str(), path.c_str()))
+    {
+        log_error("Unable to move '%s' to '%s'", tempPath.c_str(), path.c_str());
+        return false;
+    }
+    return true;
+}
+
 /**
  *
  *  rct2: 0x006754F5
@@ -1616,40 +1696,19 @@ int32_t scenario_save(const utf8* path, int32_t flags)
         log_verbose("scenario_save(%s, SAVED GAME)", path);
     }
 
-    if (!(flags & S6_SAVE_FLAG_AUTOMATIC))
-    {
-        window_close_construction_windows();
-    }
-
-    map_reorganise_elements();
-    viewport_set_saved_view();
+    // Saves to the same file must not overlap.
+    scenario_save_async_wait();
 
     bool result = false;
-    auto s6exporter = new S6Exporter();
     try
     {
-        if (flags & S6_SAVE_FLAG_EXPORT)
-        {
-            auto& objManager = OpenRCT2::GetContext()->GetObjectManager();
-            s6exporter->ExportObjectsList = objManager.GetPackableObjects();
-        }
-        s6exporter->RemoveTracklessRides = true;
-        s6exporter->Export();
-        if (flags & S6_SAVE_FLAG_SCENARIO)
-        {
-            s6exporter->SaveScenario(path);
-        }
-        else
-        {
-            s6exporter->SaveGame(path);
-        }
-        result = true;
+        auto s6exporter = scenario_save_capture(flags);
+        result = scenario_save_write(*s6exporter, path, flags);
     }
     catch (const std::exception& e)
     {
         log_error("Unable to save park: '%s'", e.what());
     }
-    delete s6exporter;
 
     gfx_invalidate_screen();
 
@@ -1659,3 +1718,46 @@ int32_t scenario_save(const utf8* path, int32_t flags)
     }
     return result;
 }
+
+/**
+ * Captures the game state on the calling thread and leaves encoding, compression and writing the file to a
+ * background thread. Used for autosaves so that they do not stall the game.
+ */
+bool scenario_save_async(const utf8* path, int32_t flags)
+{
+    log_verbose("scenario_save_async(%s)", path);
+
+    // Only one save can be in flight, the previous one is normally long finished by now.
+    scenario_save_async_wait();
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    std::shared_ptr<S6Exporter> s6exporter;
+    try
+    {
+        s6exporter = scenario_save_capture(flags);
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to save park: '%s'", e.what());
+        return false;
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+    gScenarioSavePauseTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    log_verbose("scenario_save_async paused the game for %.2f ms", gScenarioSavePauseTime);
+
+    std::string savePath = path;
+    _scenarioSaveTask = std::async(std::launch::async, [s6exporter, savePath, flags]() {
+        return scenario_save_write(*s6exporter, savePath, flags);
+    });
+
+    gfx_invalidate_screen();
+    return true;
+}
+
+void scenario_save_async_wait()
+{
+    if (_scenarioSaveTask.valid())
+    {
+        _scenarioSaveTask.get();
+    }
+}
@@ -64,6 +64,7 @@ private:
 
     const utf8* _s6Path = nullptr;
     rct_s6_data _s6{};
+    size_t _peakLoadMemory = 0;
     uint8_t _gameVersion = 0;
 
 public:
@@ -170,6 +171,9 @@ public:
 
         _s6Path = path;
 
+        _peakLoadMemory = chunkReader.GetPeakBufferSize();
+        log_verbose("S6 load peak buffer memory: %zu bytes", _peakLoadMemory);
+
         return ParkLoadResult(std::vector<rct_object_entry>(std::begin(_s6.objects), std::end(_s6.objects)));
     }
 
@@ -179,6 +183,11 @@ public:
         return false;
     }
 
+    size_t GetPeakLoadMemory() const override
+    {
+        return _peakLoadMemory;
+    }
+
     void Import() override
     {
         Initialise();
@@ -445,6 +454,7 @@ public:
         game_convert_strings_to_utf8();
         map_count_remaining_land_rights();
         determine_ride_entrance_and_exit_locations();
+        ride_reset_all_queue_indexes();
 
         auto& park = OpenRCT2::GetContext()->GetGameState()->GetPark();
         park.Name = GetUserString(_s6.park_name);
@@ -816,12 +826,15 @@ public:
         dst.current_item = src.current_item;
         dst.vehicle_index = src.vehicle_index;
         dst.current_station = src.current_station;
-        for (size_t i = 0; i < std::size(src.velocity); i++)
-        {
-            dst.velocity[i] = src.velocity[i];
-            dst.altitude[i] = src.altitude[i];
-            dst.vertical[i] = src.vertical[i];
-            dst.lateral[i] = src.lateral[i];
+        auto numSamples = std::min<size_t>(std::max(src.num_items, src.current_item), std::size(src.velocity));
+        for (size_t i = 0; i < numSamples; i++)
+        {
+            RideMeasurementSample sample;
+            sample.velocity = src.velocity[i];
+            sample.altitude = src.altitude[i];
+            sample.vertical = src.vertical[i];
+            sample.lateral = src.lateral[i];
+            dst.samples.Set(i, sample);
         }
     }
 
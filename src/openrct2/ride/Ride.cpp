@@ -24,8 +24,10 @@
 #include "../audio/audio.h"
 #include "../common.h"
 #include "../config/Config.h"
+#include "../core/File.h"
 #include "../core/Guard.hpp"
 #include "../core/Optional.hpp"
+#include "../core/String.hpp"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../localisation/Localisation.h"
@@ -325,30 +327,43 @@ int32_t Ride::GetMaxQueueTime() const
     return (int32_t)queueTime;
 }
 
+// The guest behind each guest in a queue, the reverse of next_in_queue. Lets a guest leave a queue without walking it.
+static uint16_t _queueGuestBehind[MAX_SPRITES];
+
 Peep* Ride::GetQueueHeadGuest(int32_t stationIndex) const
 {
-    Peep* peep;
-    Peep* result = nullptr;
-    uint16_t spriteIndex = stations[stationIndex].LastPeepInQueue;
-    while ((peep = try_get_guest(spriteIndex)) != nullptr)
-    {
-        spriteIndex = peep->next_in_queue;
-        result = peep;
-    }
-    return result;
+    const auto& station = stations[stationIndex];
+    if (station.QueueGuestCount == 0)
+        return nullptr;
+    return try_get_guest(station.FirstPeepInQueue);
 }
 
 void Ride::UpdateQueueLength(int32_t stationIndex)
 {
-    uint16_t count = 0;
+    stations[stationIndex].QueueLength = stations[stationIndex].QueueGuestCount;
+}
+
+/**
+ * Rebuilds the front of the queue, the guest count and the guests behind by walking the queue from LastPeepInQueue.
+ */
+void Ride::UpdateQueueIndex(int32_t stationIndex)
+{
+    auto& station = stations[stationIndex];
+    station.FirstPeepInQueue = SPRITE_INDEX_NULL;
+    station.QueueGuestCount = 0;
+
     Peep* peep;
-    uint16_t spriteIndex = stations[stationIndex].LastPeepInQueue;
-    while ((peep = try_get_guest(spriteIndex)) != nullptr)
-    {
+    uint16_t behindIndex = SPRITE_INDEX_NULL;
+    uint16_t spriteIndex = station.LastPeepInQueue;
+    // Also stop at MAX_SPRITES in case the queue is broken and contains a loop
+    while ((peep = try_get_guest(spriteIndex)) != nullptr && station.QueueGuestCount < MAX_SPRITES)
+    {
+        _queueGuestBehind[spriteIndex] = behindIndex;
+        station.FirstPeepInQueue = spriteIndex;
+        station.QueueGuestCount++;
+        behindIndex = spriteIndex;
         spriteIndex = peep->next_in_queue;
-        count++;
     }
-    stations[stationIndex].QueueLength = count;
 }
 
 void Ride::QueueInsertGuestAtFront(int32_t stationIndex, Peep* peep)
@@ -356,17 +371,138 @@ void Ride::QueueInsertGuestAtFront(int32_t stationIndex, Peep* peep)
     assert(stationIndex < MAX_STATIONS);
     assert(peep != nullptr);
 
+    auto& station = stations[stationIndex];
     peep->next_in_queue = SPRITE_INDEX_NULL;
-    Peep* queueHeadGuest = GetQueueHeadGuest(peep->current_ride_station);
+    Peep* queueHeadGuest = GetQueueHeadGuest(stationIndex);
     if (queueHeadGuest == nullptr)
     {
-        stations[peep->current_ride_station].LastPeepInQueue = peep->sprite_index;
+        station.LastPeepInQueue = peep->sprite_index;
+        _queueGuestBehind[peep->sprite_index] = SPRITE_INDEX_NULL;
     }
     else
     {
         queueHeadGuest->next_in_queue = peep->sprite_index;
+        _queueGuestBehind[peep->sprite_index] = queueHeadGuest->sprite_index;
+    }
+    station.FirstPeepInQueue = peep->sprite_index;
+    station.QueueGuestCount++;
+    UpdateQueueLength(stationIndex);
+}
+
+void Ride::QueueInsertGuestAtBack(int32_t stationIndex, Peep* peep)
+{
+    assert(stationIndex < MAX_STATIONS);
+    assert(peep != nullptr);
+
+    auto& station = stations[stationIndex];
+    uint16_t previousLast = station.LastPeepInQueue;
+    station.LastPeepInQueue = peep->sprite_index;
+    peep->next_in_queue = previousLast;
+    station.QueueLength++;
+
+    _queueGuestBehind[peep->sprite_index] = SPRITE_INDEX_NULL;
+    if (station.QueueGuestCount == 0)
+    {
+        station.FirstPeepInQueue = peep->sprite_index;
+    }
+    else
+    {
+        _queueGuestBehind[previousLast] = peep->sprite_index;
+    }
+    station.QueueGuestCount++;
+}
+
+void Ride::QueueRemoveGuest(int32_t stationIndex, Peep* peep)
+{
+    auto& station = stations[stationIndex];
+    // Make sure we don't underflow, building while paused might reset it to 0 where peeps have
+    // not yet left the queue.
+    if (station.QueueLength > 0)
+    {
+        station.QueueLength--;
+    }
+
+    uint16_t spriteIndex = peep->sprite_index;
+    uint16_t behindIndex = _queueGuestBehind[spriteIndex];
+    if (spriteIndex == station.LastPeepInQueue)
+    {
+        station.LastPeepInQueue = peep->next_in_queue;
+        behindIndex = SPRITE_INDEX_NULL;
+    }
+    else if (behindIndex == SPRITE_INDEX_NULL)
+    {
+        // Not in this queue
+        return;
+    }
+    else
+    {
+        Peep* behindPeep = try_get_guest(behindIndex);
+        if (behindPeep == nullptr || behindPeep->next_in_queue != spriteIndex)
+        {
+            // The index no longer matches the queue, search for the guest behind like before and rebuild the index
+            _queueGuestBehind[spriteIndex] = SPRITE_INDEX_NULL;
+            auto spriteId = station.LastPeepInQueue;
+            while (spriteId != SPRITE_INDEX_NULL)
+            {
+                Peep* otherPeep = GET_PEEP(spriteId);
+                if (spriteIndex == otherPeep->next_in_queue)
+                {
+                    otherPeep->next_in_queue = peep->next_in_queue;
+                    break;
+                }
+                spriteId = otherPeep->next_in_queue;
+            }
+            UpdateQueueIndex(stationIndex);
+            return;
+        }
+        behindPeep->next_in_queue = peep->next_in_queue;
+    }
+
+    if (peep->next_in_queue != SPRITE_INDEX_NULL)
+    {
+        _queueGuestBehind[peep->next_in_queue] = behindIndex;
+    }
+    if (station.FirstPeepInQueue == spriteIndex)
+    {
+        station.FirstPeepInQueue = behindIndex;
+    }
+    _queueGuestBehind[spriteIndex] = SPRITE_INDEX_NULL;
+    if (station.QueueGuestCount > 0)
+    {
+        station.QueueGuestCount--;
+    }
+}
+
+/**
+ * Empties the queue of the given station without moving the guests, like when its entrance is rebuilt.
+ */
+void Ride::QueueClear(int32_t stationIndex)
+{
+    auto& station = stations[stationIndex];
+    Peep* peep;
+    uint16_t spriteIndex = station.LastPeepInQueue;
+    for (uint16_t i = 0; i < station.QueueGuestCount && (peep = try_get_guest(spriteIndex)) != nullptr; i++)
+    {
+        _queueGuestBehind[spriteIndex] = SPRITE_INDEX_NULL;
+        spriteIndex = peep->next_in_queue;
+    }
+
+    station.LastPeepInQueue = SPRITE_INDEX_NULL;
+    station.QueueLength = 0;
+    station.FirstPeepInQueue = SPRITE_INDEX_NULL;
+    station.QueueGuestCount = 0;
+}
+
+void ride_reset_all_queue_indexes()
+{
+    std::fill_n(_queueGuestBehind, std::size(_queueGuestBehind), SPRITE_INDEX_NULL);
+    for (auto& ride : GetRideManager())
+    {
+        for (int32_t stationIndex = 0; stationIndex < MAX_STATIONS; stationIndex++)
+        {
+            ride.UpdateQueueIndex(stationIndex);
+        }
     }
-    UpdateQueueLength(peep->current_ride_station);
 }
 
 /**
@@ -2929,7 +3065,10 @@ static void ride_measurement_update(Ride& ride, RideMeasurement& measurement)
 
         measurement.flags &= ~RIDE_MEASUREMENT_FLAG_UNLOADING;
         if (measurement.current_station == vehicle->current_station)
+        {
             measurement.current_item = 0;
+            measurement.num_dropped_items = 0;
+        }
     }
 
     if (vehicle->status == VEHICLE_STATUS_UNLOADING_PASSENGERS)
@@ -2945,9 +3084,19 @@ static void ride_measurement_update(Ride& ride, RideMeasurement& measurement)
         if (vehicle->velocity == 0)
             return;
 
-    if (measurement.current_item >= RideMeasurement::MAX_ITEMS)
-        return;
+    // Runs are only limited if a maximum is configured, the limit is then at least one block
+    auto maxItems = gConfigGeneral.ride_measurement_max_samples;
+    if (maxItems > 0
+        && measurement.current_item >= std::max<uint32_t>(maxItems, (uint32_t)RideMeasurementBuffer::SAMPLES_PER_BLOCK))
+    {
+        // Keep measuring long runs, dropping their oldest samples
+        measurement.samples.DropFirstBlock();
+        measurement.current_item -= RideMeasurementBuffer::SAMPLES_PER_BLOCK;
+        measurement.num_items -= RideMeasurementBuffer::SAMPLES_PER_BLOCK;
+        measurement.num_dropped_items += RideMeasurementBuffer::SAMPLES_PER_BLOCK;
+    }
 
+    auto sample = measurement.GetSample(measurement.current_item);
     if (measurement.flags & RIDE_MEASUREMENT_FLAG_G_FORCES)
     {
         auto gForces = vehicle_get_g_forces(vehicle);
@@ -2956,12 +3105,12 @@ static void ride_measurement_update(Ride& ride, RideMeasurement& measurement)
 
         if (gScenarioTicks & 1)
         {
-            gForces.VerticalG = (gForces.VerticalG + measurement.vertical[measurement.current_item]) / 2;
-            gForces.LateralG = (gForces.LateralG + measurement.lateral[measurement.current_item]) / 2;
+            gForces.VerticalG = (gForces.VerticalG + sample.vertical) / 2;
+            gForces.LateralG = (gForces.LateralG + sample.lateral) / 2;
         }
 
-        measurement.vertical[measurement.current_item] = gForces.VerticalG & 0xFF;
-        measurement.lateral[measurement.current_item] = gForces.LateralG & 0xFF;
+        sample.vertical = gForces.VerticalG & 0xFF;
+        sample.lateral = gForces.LateralG & 0xFF;
     }
 
     auto velocity = std::min(std::abs((vehicle->velocity * 5) >> 16), 255);
@@ -2969,12 +3118,13 @@ static void ride_measurement_update(Ride& ride, RideMeasurement& measurement)
 
     if (gScenarioTicks & 1)
     {
-        velocity = (velocity + measurement.velocity[measurement.current_item]) / 2;
-        altitude = (altitude + measurement.altitude[measurement.current_item]) / 2;
+        velocity = (velocity + sample.velocity) / 2;
+        altitude = (altitude + sample.altitude) / 2;
     }
 
-    measurement.velocity[measurement.current_item] = velocity & 0xFF;
-    measurement.altitude[measurement.current_item] = altitude & 0xFF;
+    sample.velocity = velocity & 0xFF;
+    sample.altitude = altitude & 0xFF;
+    measurement.samples.Set(measurement.current_item, sample);
 
     if (gScenarioTicks & 1)
     {
@@ -3091,6 +3241,53 @@ std::pair<RideMeasurement*, rct_string_id> ride_get_measurement(Ride* ride)
     }
 }
 
+/**
+ * Writes the samples of the ride's measurement as CSV. Samples after the current item are left over from the previous
+ * run. Velocity is in mph and altitude in metres, the same units the ride window graphs are drawn in. Returns false if
+ * the ride has no measurement or the file could not be written.
+ */
+bool ride_measurement_write_csv(const Ride& ride, const std::string& path)
+{
+    auto measurement = ride.measurement.get();
+    if (measurement == nullptr)
+    {
+        return false;
+    }
+
+    bool hasGForces = (measurement->flags & RIDE_MEASUREMENT_FLAG_G_FORCES) != 0;
+    std::string csv = "sample,time,run,velocity,altitude,vertical_g,lateral_g\n";
+    for (size_t i = 0; i < measurement->num_items; i++)
+    {
+        auto sampleIndex = measurement->num_dropped_items + i;
+        auto sample = measurement->GetSample(i);
+        // Samples are taken every other tick
+        csv += String::StdFormat(
+            "%zu,%.3f,%s,%.2f,%.2f,", sampleIndex, sampleIndex * 2 * GAME_UPDATE_TIME_MS / 1000.0,
+            i < measurement->current_item ? "current" : "previous", sample.velocity * 9 / 20.0,
+            (sample.altitude - gMapBaseZ * 2) * 0.75);
+        if (hasGForces)
+        {
+            csv += String::StdFormat("%.2f,%.2f", sample.vertical * 8 / 100.0, sample.lateral * 8 / 100.0);
+        }
+        else
+        {
+            csv += ',';
+        }
+        csv += '\n';
+    }
+
+    try
+    {
+        File::WriteAllBytes(path, csv.data(), csv.size());
+    }
+    catch (const std::exception& e)
+    {
+        log_error("Unable to write '%s': %s", path.c_str(), e.what());
+        return false;
+    }
+    return true;
+}
+
 #pragma endregion
 
 #pragma region Colour functions
@@ -14,6 +14,7 @@
 #include "../rct12/RCT12.h"
 #include "../rct2/RCT2.h"
 #include "../world/Map.h"
+#include "RideMeasurementBuffer.h"
 #include "RideRatings.h"
 #include "RideTypes.h"
 #include "Vehicle.h"
@@ -174,6 +175,10 @@ struct RideStation
     uint8_t QueueTime;
     uint16_t QueueLength;
     uint16_t LastPeepInQueue;
+    // The guest at the front of the queue and the number of guests linked from LastPeepInQueue.
+    // They are kept up to date as guests join and leave, and rebuilt from the queue on load so don't require export/import.
+    uint16_t FirstPeepInQueue;
+    uint16_t QueueGuestCount;
 
     static constexpr uint8_t NO_TRAIN = std::numeric_limits<uint8_t>::max();
 
@@ -184,18 +189,20 @@ struct RideStation
 
 struct RideMeasurement
 {
-    static constexpr size_t MAX_ITEMS = 4800;
-
     uint8_t flags{};
     uint32_t last_use_tick{};
-    uint16_t num_items{};
-    uint16_t current_item{};
+    uint32_t num_items{};
+    uint32_t current_item{};
     uint8_t vehicle_index{};
     uint8_t current_station{};
-    int8_t vertical[MAX_ITEMS]{};
-    int8_t lateral[MAX_ITEMS]{};
-    uint8_t velocity[MAX_ITEMS]{};
-    uint8_t altitude[MAX_ITEMS]{};
+    // Number of samples dropped from the start of the current run to keep it within the configured maximum
+    uint32_t num_dropped_items{};
+    RideMeasurementBuffer samples;
+
+    RideMeasurementSample GetSample(size_t index) const
+    {
+        return index < samples.GetCount() ? samples.Get(index) : RideMeasurementSample{};
+    }
 };
 
 enum class RideClassification
@@ -433,6 +440,10 @@ public:
     int32_t GetMaxQueueTime() const;
 
     void QueueInsertGuestAtFront(int32_t stationIndex, Peep* peep);
+    void QueueInsertGuestAtBack(int32_t stationIndex, Peep* peep);
+    void QueueRemoveGuest(int32_t stationIndex, Peep* peep);
+    void QueueClear(int32_t stationIndex);
+    void UpdateQueueIndex(int32_t stationIndex);
     Peep* GetQueueHeadGuest(int32_t stationIndex) const;
 
     void SetNameToDefault();
@@ -1136,6 +1147,7 @@ ride_id_t ride_get_empty_slot();
 int32_t ride_get_count();
 void ride_init_all();
 void reset_all_ride_build_dates();
+void ride_reset_all_queue_indexes();
 void ride_update_favourited_stat();
 void ride_check_all_reachable();
 void ride_update_satisfaction(Ride* ride, uint8_t happiness);
@@ -1159,6 +1171,7 @@ uint8_t* get_ride_entry_indices_for_ride_type(uint8_t rideType);
 void reset_type_to_ride_entry_index_map(IObjectManager& objectManager);
 void ride_measurements_update();
 std::pair<RideMeasurement*, rct_string_id> ride_get_measurement(Ride* ride);
+bool ride_measurement_write_csv(const Ride& ride, const std::string& path);
 void ride_breakdown_add_news_item(Ride* ride);
 Peep* ride_find_closest_mechanic(Ride* ride, int32_t forInspection);
 int32_t ride_is_valid_for_open(Ride* ride, int32_t goingToBeOpen, bool isApplying);
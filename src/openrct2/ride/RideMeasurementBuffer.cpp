@@ -0,0 +1,269 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "RideMeasurementBuffer.h"
+
+#include "../core/Guard.hpp"
+
+#include <algorithm>
+
+// Values are stored as a nibble holding the difference to the previous value plus 8, nibble 0 is followed by the value
+// itself in two nibbles.
+static constexpr int32_t MAX_NIBBLE_DELTA = 7;
+static constexpr uint8_t NIBBLE_ESCAPE = 0;
+static constexpr size_t VALUES_PER_SAMPLE = 4;
+
+using SampleValues = std::array<uint8_t, VALUES_PER_SAMPLE>;
+
+static SampleValues GetSampleValues(const RideMeasurementSample& sample)
+{
+    return { static_cast<uint8_t>(sample.vertical), static_cast<uint8_t>(sample.lateral), sample.velocity,
+             sample.altitude };
+}
+
+static RideMeasurementSample GetSample(const SampleValues& values)
+{
+    RideMeasurementSample sample;
+    sample.vertical = static_cast<int8_t>(values[0]);
+    sample.lateral = static_cast<int8_t>(values[1]);
+    sample.velocity = values[2];
+    sample.altitude = values[3];
+    return sample;
+}
+
+class NibbleWriter
+{
+private:
+    std::vector<uint8_t>& _data;
+    bool _lowNibble = false;
+
+public:
+    explicit NibbleWriter(std::vector<uint8_t>& data)
+        : _data(data)
+    {
+    }
+
+    void Write(uint8_t nibble)
+    {
+        if (_lowNibble)
+        {
+            _data.back() |= nibble;
+        }
+        else
+        {
+            _data.push_back(nibble << 4);
+        }
+        _lowNibble = !_lowNibble;
+    }
+};
+
+class NibbleReader
+{
+private:
+    const std::vector<uint8_t>& _data;
+    size_t _position;
+    bool _lowNibble = false;
+
+public:
+    NibbleReader(const std::vector<uint8_t>& data, size_t position)
+        : _data(data)
+        , _position(position)
+    {
+    }
+
+    uint8_t Read()
+    {
+        uint8_t nibble;
+        if (_lowNibble)
+        {
+            nibble = _data[_position] & 0x0F;
+            _position++;
+        }
+        else
+        {
+            nibble = _data[_position] >> 4;
+        }
+        _lowNibble = !_lowNibble;
+        return nibble;
+    }
+};
+
+RideMeasurementSample RideMeasurementBuffer::Get(size_t index) const
+{
+    Guard::Assert(index < _count, "Measurement sample index out of range");
+
+    auto blockIndex = index / SAMPLES_PER_BLOCK;
+    if (blockIndex == _writeBlockIndex)
+    {
+        return _writeBlock[index % SAMPLES_PER_BLOCK];
+    }
+    if (blockIndex != _readBlockIndex)
+    {
+        DecodeBlock(_blocks[blockIndex], GetBlockCount(blockIndex), _readBlock);
+        _readBlockIndex = blockIndex;
+    }
+    return _readBlock[index % SAMPLES_PER_BLOCK];
+}
+
+void RideMeasurementBuffer::Set(size_t index, const RideMeasurementSample& sample)
+{
+    Guard::Assert(index <= _count, "Measurement sample index out of range");
+
+    auto blockIndex = index / SAMPLES_PER_BLOCK;
+    if (blockIndex != _writeBlockIndex)
+    {
+        FlushWriteBlock();
+        OpenWriteBlock(blockIndex);
+    }
+    if (blockIndex == _readBlockIndex)
+    {
+        _readBlockIndex = NO_BLOCK;
+    }
+
+    _writeBlock[index % SAMPLES_PER_BLOCK] = sample;
+    if (index == _count)
+    {
+        _count++;
+    }
+}
+
+void RideMeasurementBuffer::DropFirstBlock()
+{
+    if (_blocks.empty())
+    {
+        return;
+    }
+
+    _blocks.erase(_blocks.begin());
+    _count -= std::min(_count, SAMPLES_PER_BLOCK);
+
+    if (_writeBlockIndex != NO_BLOCK)
+    {
+        _writeBlockIndex = _writeBlockIndex == 0 ? NO_BLOCK : _writeBlockIndex - 1;
+    }
+    if (_readBlockIndex != NO_BLOCK)
+    {
+        _readBlockIndex = _readBlockIndex == 0 ? NO_BLOCK : _readBlockIndex - 1;
+    }
+}
+
+void RideMeasurementBuffer::Clear()
+{
+    _blocks.clear();
+    _blocks.shrink_to_fit();
+    _count = 0;
+    _writeBlockIndex = NO_BLOCK;
+    _readBlockIndex = NO_BLOCK;
+}
+
+size_t RideMeasurementBuffer::GetEncodedSize() const
+{
+    size_t size = 0;
+    for (const auto& block : _blocks)
+    {
+        size += block.size();
+    }
+    return size;
+}
+
+size_t RideMeasurementBuffer::GetBlockCount(size_t blockIndex) const
+{
+    return std::min(SAMPLES_PER_BLOCK, _count - (blockIndex * SAMPLES_PER_BLOCK));
+}
+
+void RideMeasurementBuffer::FlushWriteBlock()
+{
+    if (_writeBlockIndex != NO_BLOCK)
+    {
+        _blocks[_writeBlockIndex] = EncodeBlock(_writeBlock, GetBlockCount(_writeBlockIndex));
+        _writeBlockIndex = NO_BLOCK;
+    }
+}
+
+void RideMeasurementBuffer::OpenWriteBlock(size_t blockIndex)
+{
+    if (blockIndex < _blocks.size())
+    {
+        DecodeBlock(_blocks[blockIndex], GetBlockCount(blockIndex), _writeBlock);
+    }
+    else
+    {
+        _blocks.emplace_back();
+        _writeBlock = {};
+    }
+    _writeBlockIndex = blockIndex;
+}
+
+std::vector<uint8_t> RideMeasurementBuffer::EncodeBlock(const DecodedBlock& samples, size_t count)
+{
+    std::vector<uint8_t> data;
+    if (count == 0)
+    {
+        return data;
+    }
+
+    auto previous = GetSampleValues(samples[0]);
+    data.insert(data.end(), previous.begin(), previous.end());
+
+    NibbleWriter writer(data);
+    for (size_t i = 1; i < count; i++)
+    {
+        auto current = GetSampleValues(samples[i]);
+        for (size_t j = 0; j < VALUES_PER_SAMPLE; j++)
+        {
+            auto delta = static_cast<int8_t>(current[j] - previous[j]);
+            if (delta >= -MAX_NIBBLE_DELTA && delta <= MAX_NIBBLE_DELTA)
+            {
+                writer.Write(delta + 8);
+            }
+            else
+            {
+                writer.Write(NIBBLE_ESCAPE);
+                writer.Write(current[j] >> 4);
+                writer.Write(current[j] & 0x0F);
+            }
+        }
+        previous = current;
+    }
+
+    data.shrink_to_fit();
+    return data;
+}
+
+void RideMeasurementBuffer::DecodeBlock(const std::vector<uint8_t>& data, size_t count, DecodedBlock& samples)
+{
+    samples = {};
+    if (count == 0)
+    {
+        return;
+    }
+
+    SampleValues values;
+    std::copy_n(data.begin(), VALUES_PER_SAMPLE, values.begin());
+    samples[0] = GetSample(values);
+
+    NibbleReader reader(data, VALUES_PER_SAMPLE);
+    for (size_t i = 1; i < count; i++)
+    {
+        for (size_t j = 0; j < VALUES_PER_SAMPLE; j++)
+        {
+            auto nibble = reader.Read();
+            if (nibble == NIBBLE_ESCAPE)
+            {
+                auto high = reader.Read();
+                values[j] = (high << 4) | reader.Read();
+            }
+            else
+            {
+                values[j] += nibble - 8;
+            }
+        }
+        samples[i] = GetSample(values);
+    }
+}
@@ -0,0 +1,90 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <array>
+#include <vector>
+
+/**
+ * A single sample of a ride measurement, taken every other tick while the measured vehicle runs.
+ */
+struct RideMeasurementSample
+{
+    int8_t vertical{};
+    int8_t lateral{};
+    uint8_t velocity{};
+    uint8_t altitude{};
+};
+
+/**
+ * Stores the samples of a ride measurement in delta encoded blocks.
+ *
+ * Samples change little from one to the next, so each block stores its first sample as is and every sample after that
+ * as the difference to the one before, using half a byte per value where it fits. Samples are written in order, so
+ * the block being written to is kept decoded until the writing moves on to the next block. Blocks can be dropped from
+ * the front to keep a long run within a fixed number of samples.
+ */
+class RideMeasurementBuffer
+{
+public:
+    static constexpr size_t SAMPLES_PER_BLOCK = 64;
+
+    size_t GetCount() const
+    {
+        return _count;
+    }
+
+    /**
+     * Gets the sample at the given index, which must be less than the number of samples.
+     */
+    RideMeasurementSample Get(size_t index) const;
+
+    /**
+     * Overwrites the sample at the given index, or adds it if the index equals the number of samples.
+     */
+    void Set(size_t index, const RideMeasurementSample& sample);
+
+    /**
+     * Removes the oldest block of samples, moving every other sample SAMPLES_PER_BLOCK indices down.
+     */
+    void DropFirstBlock();
+
+    void Clear();
+
+    /**
+     * Gets the number of bytes used by the encoded samples.
+     */
+    size_t GetEncodedSize() const;
+
+private:
+    using DecodedBlock = std::array<RideMeasurementSample, SAMPLES_PER_BLOCK>;
+
+    static constexpr size_t NO_BLOCK = SIZE_MAX;
+
+    std::vector<std::vector<uint8_t>> _blocks;
+    size_t _count = 0;
+
+    // The block being written to, only encoded into _blocks when the writing moves on
+    DecodedBlock _writeBlock{};
+    size_t _writeBlockIndex = NO_BLOCK;
+
+    // The last block that was decoded for reading, so reading the samples in order only decodes each block once
+    mutable DecodedBlock _readBlock{};
+    mutable size_t _readBlockIndex = NO_BLOCK;
+
+    size_t GetBlockCount(size_t blockIndex) const;
+    void FlushWriteBlock();
+    void OpenWriteBlock(size_t blockIndex);
+
+    static std::vector<uint8_t> EncodeBlock(const DecodedBlock& samples, size_t count);
+    static void DecodeBlock(const std::vector<uint8_t>& data, size_t count, DecodedBlock& samples);
+};
@@ -10,7 +10,9 @@
 #include "RideRatings.h"
 
 #include "../Cheats.h"
+#include "../Game.h"
 #include "../OpenRCT2.h"
+#include "../core/JobPool.hpp"
 #include "../interface/Window.h"
 #include "../localisation/Date.h"
 #include "../world/Footpath.h"
@@ -23,6 +25,8 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <vector>
 
 enum
 {
@@ -71,45 +75,113 @@ struct ShelteredEights
     uint8_t TotalShelteredEighths;
 };
 
-using ride_ratings_calculation = void (*)(Ride* ride);
+using ride_ratings_calculation = void (*)(Ride* ride, RideRatingCalculationData& state);
+
+// Rides that have finished testing but have no ratings yet are rated together every this many ticks, rather than
+// waiting for the rating cycle to reach them
+constexpr uint32_t RIDE_RATINGS_BATCH_INTERVAL = 128;
 
 RideRatingCalculationData gRideRatingsCalcData;
+static std::unique_ptr<JobPool> _ratingJobs;
 
 static ride_ratings_calculation ride_ratings_get_calculate_func(uint8_t rideType);
 
-static void ride_ratings_update_state();
-static void ride_ratings_update_state_0();
-static void ride_ratings_update_state_1();
-static void ride_ratings_update_state_2();
-static void ride_ratings_update_state_3();
-static void ride_ratings_update_state_4();
-static void ride_ratings_update_state_5();
-static void ride_ratings_begin_proximity_loop();
-static void ride_ratings_calculate(Ride* ride);
+static void ride_ratings_update_state(RideRatingCalculationData& state);
+static void ride_ratings_update_state_0(RideRatingCalculationData& state);
+static void ride_ratings_update_state_1(RideRatingCalculationData& state);
+static void ride_ratings_update_state_2(RideRatingCalculationData& state);
+static void ride_ratings_update_state_3(RideRatingCalculationData& state);
+static void ride_ratings_update_state_4(RideRatingCalculationData& state);
+static void ride_ratings_update_state_5(RideRatingCalculationData& state);
+static void ride_ratings_begin_proximity_loop(RideRatingCalculationData& state);
+static void ride_ratings_calculate(RideRatingCalculationData& state, Ride* ride);
 static void ride_ratings_calculate_value(Ride* ride);
-static void ride_ratings_score_close_proximity(TileElement* inputTileElement);
+static void ride_ratings_score_close_proximity(RideRatingCalculationData& state, TileElement* inputTileElement);
 
 static void ride_ratings_add(rating_tuple* rating, int32_t excitement, int32_t intensity, int32_t nausea);
 
 /**
- * This is a small hack function to keep calling the ride rating processor until
- * the given ride's ratings have been calculated. What ever is currently being
- * processed will be overwritten.
- * Only purpose of this function currently is for testing.
+ * Calculates the ratings of the given ride straight away. The ride is rated with its own calculation state, so the
+ * ride that is currently being rated by ride_ratings_update_all is not affected.
  */
 void ride_ratings_update_ride(const Ride& ride)
 {
     if (ride.status != RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.current_ride = ride.id;
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_INITIALISE;
-        while (gRideRatingsCalcData.state != RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+        RideRatingCalculationData state{};
+        state.current_ride = ride.id;
+        state.state = RIDE_RATINGS_STATE_INITIALISE;
+        while (state.state != RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+        {
+            ride_ratings_update_state(state);
+        }
+    }
+}
+
+/**
+ * Calculates the ratings of the given rides straight away. Walking the track of a ride only reads the map, so the
+ * tracks are walked in parallel. The ratings are then calculated and stored in the order the rides are given, on the
+ * calling thread, so the result does not depend on how the walks were scheduled.
+ */
+void ride_ratings_update_rides(const std::vector<ride_id_t>& rideIds)
+{
+    std::vector<RideRatingCalculationData> states(rideIds.size());
+    for (size_t i = 0; i < rideIds.size(); i++)
+    {
+        states[i].current_ride = rideIds[i];
+        states[i].state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        auto ride = get_ride(rideIds[i]);
+        if (ride != nullptr && ride->status != RIDE_STATUS_CLOSED)
+        {
+            states[i].state = RIDE_RATINGS_STATE_INITIALISE;
+        }
+    }
+
+    if (_ratingJobs == nullptr)
+    {
+        _ratingJobs = std::make_unique<JobPool>();
+    }
+    for (auto& state : states)
+    {
+        if (state.state == RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+            continue;
+
+        _ratingJobs->AddTask([&state]() {
+            while (state.state != RIDE_RATINGS_STATE_CALCULATE && state.state != RIDE_RATINGS_STATE_FIND_NEXT_RIDE)
+            {
+                ride_ratings_update_state(state);
+            }
+        });
+    }
+    _ratingJobs->Join();
+
+    for (auto& state : states)
+    {
+        if (state.state == RIDE_RATINGS_STATE_CALCULATE)
         {
-            ride_ratings_update_state();
+            ride_ratings_update_state(state);
         }
     }
 }
 
+/**
+ * Gets the rides that have been tested since their track last changed, but have not been rated yet. This only depends on
+ * saved ride state, so every client in a multiplayer game finds the same rides.
+ */
+static std::vector<ride_id_t> ride_ratings_get_unrated_rides()
+{
+    std::vector<ride_id_t> rideIds;
+    for (auto& ride : GetRideManager())
+    {
+        if (ride.status != RIDE_STATUS_CLOSED && (ride.lifecycle_flags & RIDE_LIFECYCLE_TESTED)
+            && ride.excitement == RIDE_RATING_UNDEFINED)
+        {
+            rideIds.push_back(ride.id);
+        }
+    }
+    return rideIds;
+}
+
 /**
  *
  *  rct2: 0x006B5A2A
@@ -119,30 +191,41 @@ void ride_ratings_update_all()
     if (gScreenFlags & SCREEN_FLAGS_SCENARIO_EDITOR)
         return;
 
-    ride_ratings_update_state();
+    // Newly tested rides are rated in one batch at fixed ticks. The batch finishes within the tick and stores the ratings
+    // in ride index order, so the result does not depend on the worker threads.
+    if (gCurrentTicks % RIDE_RATINGS_BATCH_INTERVAL == 0)
+    {
+        auto rideIds = ride_ratings_get_unrated_rides();
+        if (!rideIds.empty())
+        {
+            ride_ratings_update_rides(rideIds);
+        }
+    }
+
+    ride_ratings_update_state(gRideRatingsCalcData);
 }
 
-static void ride_ratings_update_state()
+static void ride_ratings_update_state(RideRatingCalculationData& state)
 {
-    switch (gRideRatingsCalcData.state)
+    switch (state.state)
     {
         case RIDE_RATINGS_STATE_FIND_NEXT_RIDE:
-            ride_ratings_update_state_0();
+            ride_ratings_update_state_0(state);
             break;
         case RIDE_RATINGS_STATE_INITIALISE:
-            ride_ratings_update_state_1();
+            ride_ratings_update_state_1(state);
             break;
         case RIDE_RATINGS_STATE_2:
-            ride_ratings_update_state_2();
+            ride_ratings_update_state_2(state);
             break;
         case RIDE_RATINGS_STATE_CALCULATE:
-            ride_ratings_update_state_3();
+            ride_ratings_update_state_3(state);
             break;
         case RIDE_RATINGS_STATE_4:
-            ride_ratings_update_state_4();
+            ride_ratings_update_state_4(state);
             break;
         case RIDE_RATINGS_STATE_5:
-            ride_ratings_update_state_5();
+            ride_ratings_update_state_5(state);
             break;
     }
 }
@@ -151,9 +234,9 @@ static void ride_ratings_update_state()
  *
  *  rct2: 0x006B5A5C
  */
-static void ride_ratings_update_state_0()
+static void ride_ratings_update_state_0(RideRatingCalculationData& state)
 {
-    int32_t currentRide = gRideRatingsCalcData.current_ride;
+    int32_t currentRide = state.current_ride;
 
     currentRide++;
     if (currentRide == RIDE_ID_NULL)
@@ -164,52 +247,52 @@ static void ride_ratings_update_state_0()
     auto ride = get_ride(currentRide);
     if (ride != nullptr && ride->status != RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_INITIALISE;
+        state.state = RIDE_RATINGS_STATE_INITIALISE;
     }
-    gRideRatingsCalcData.current_ride = currentRide;
+    state.current_ride = currentRide;
 }
 
 /**
  *
  *  rct2: 0x006B5A94
  */
-static void ride_ratings_update_state_1()
+static void ride_ratings_update_state_1(RideRatingCalculationData& state)
 {
-    gRideRatingsCalcData.proximity_total = 0;
+    state.proximity_total = 0;
     for (int32_t i = 0; i < PROXIMITY_COUNT; i++)
     {
-        gRideRatingsCalcData.proximity_scores[i] = 0;
+        state.proximity_scores[i] = 0;
     }
-    gRideRatingsCalcData.num_brakes = 0;
-    gRideRatingsCalcData.num_reversers = 0;
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_2;
-    gRideRatingsCalcData.station_flags = 0;
-    ride_ratings_begin_proximity_loop();
+    state.num_brakes = 0;
+    state.num_reversers = 0;
+    state.state = RIDE_RATINGS_STATE_2;
+    state.station_flags = 0;
+    ride_ratings_begin_proximity_loop(state);
 }
 
 /**
  *
  *  rct2: 0x006B5C66
  */
-static void ride_ratings_update_state_2()
+static void ride_ratings_update_state_2(RideRatingCalculationData& state)
 {
-    const ride_id_t rideIndex = gRideRatingsCalcData.current_ride;
+    const ride_id_t rideIndex = state.current_ride;
     auto ride = get_ride(rideIndex);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    int32_t x = gRideRatingsCalcData.proximity_x / 32;
-    int32_t y = gRideRatingsCalcData.proximity_y / 32;
-    int32_t z = gRideRatingsCalcData.proximity_z / 8;
-    int32_t trackType = gRideRatingsCalcData.proximity_track_type;
+    int32_t x = state.proximity_x / 32;
+    int32_t y = state.proximity_y / 32;
+    int32_t z = state.proximity_z / 8;
+    int32_t trackType = state.proximity_track_type;
 
     TileElement* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
     if (tileElement == nullptr)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
     do
@@ -227,24 +310,24 @@ static void ride_ratings_update_state_2()
             if (trackType == TRACK_ELEM_END_STATION)
             {
                 int32_t entranceIndex = tileElement->AsTrack()->GetStationIndex();
-                gRideRatingsCalcData.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                state.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
                 if (ride_get_entrance_location(ride, entranceIndex).isNull())
                 {
-                    gRideRatingsCalcData.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                    state.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
                 }
             }
 
-            ride_ratings_score_close_proximity(tileElement);
+            ride_ratings_score_close_proximity(state, tileElement);
 
             CoordsXYE trackElement = {
-                /* .x = */ gRideRatingsCalcData.proximity_x,
-                /* .y = */ gRideRatingsCalcData.proximity_y,
+                /* .x = */ state.proximity_x,
+                /* .y = */ state.proximity_y,
                 /* .element = */ tileElement,
             };
             CoordsXYE nextTrackElement;
             if (!track_block_get_next(&trackElement, &nextTrackElement, nullptr, nullptr))
             {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_4;
+                state.state = RIDE_RATINGS_STATE_4;
                 return;
             }
 
@@ -252,75 +335,75 @@ static void ride_ratings_update_state_2()
             y = nextTrackElement.y;
             z = nextTrackElement.element->GetBaseZ();
             tileElement = nextTrackElement.element;
-            if (x == gRideRatingsCalcData.proximity_start_x && y == gRideRatingsCalcData.proximity_start_y
-                && z == gRideRatingsCalcData.proximity_start_z)
+            if (x == state.proximity_start_x && y == state.proximity_start_y
+                && z == state.proximity_start_z)
             {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+                state.state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
-            gRideRatingsCalcData.proximity_x = x;
-            gRideRatingsCalcData.proximity_y = y;
-            gRideRatingsCalcData.proximity_z = z;
-            gRideRatingsCalcData.proximity_track_type = tileElement->AsTrack()->GetTrackType();
+            state.proximity_x = x;
+            state.proximity_y = y;
+            state.proximity_z = z;
+            state.proximity_track_type = tileElement->AsTrack()->GetTrackType();
             return;
         }
     } while (!(tileElement++)->IsLastForTile());
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5E4D
  */
-static void ride_ratings_update_state_3()
+static void ride_ratings_update_state_3(RideRatingCalculationData& state)
 {
-    auto ride = get_ride(gRideRatingsCalcData.current_ride);
+    auto ride = get_ride(state.current_ride);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    ride_ratings_calculate(ride);
+    ride_ratings_calculate(state, ride);
     ride_ratings_calculate_value(ride);
 
-    window_invalidate_by_number(WC_RIDE, gRideRatingsCalcData.current_ride);
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    window_invalidate_by_number(WC_RIDE, state.current_ride);
+    state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5BAB
  */
-static void ride_ratings_update_state_4()
+static void ride_ratings_update_state_4(RideRatingCalculationData& state)
 {
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_5;
-    ride_ratings_begin_proximity_loop();
+    state.state = RIDE_RATINGS_STATE_5;
+    ride_ratings_begin_proximity_loop(state);
 }
 
 /**
  *
  *  rct2: 0x006B5D72
  */
-static void ride_ratings_update_state_5()
+static void ride_ratings_update_state_5(RideRatingCalculationData& state)
 {
-    auto ride = get_ride(gRideRatingsCalcData.current_ride);
+    auto ride = get_ride(state.current_ride);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
-    int32_t x = gRideRatingsCalcData.proximity_x / 32;
-    int32_t y = gRideRatingsCalcData.proximity_y / 32;
-    int32_t z = gRideRatingsCalcData.proximity_z / 8;
-    int32_t trackType = gRideRatingsCalcData.proximity_track_type;
+    int32_t x = state.proximity_x / 32;
+    int32_t y = state.proximity_y / 32;
+    int32_t z = state.proximity_z / 8;
+    int32_t trackType = state.proximity_track_type;
 
     TileElement* tileElement = map_get_first_element_at(TileCoordsXY{ x, y }.ToCoordsXY());
     if (tileElement == nullptr)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
     do
@@ -334,53 +417,53 @@ static void ride_ratings_update_state_5()
 
         if (trackType == 255 || trackType == tileElement->AsTrack()->GetTrackType())
         {
-            ride_ratings_score_close_proximity(tileElement);
+            ride_ratings_score_close_proximity(state, tileElement);
 
-            x = gRideRatingsCalcData.proximity_x;
-            y = gRideRatingsCalcData.proximity_y;
+            x = state.proximity_x;
+            y = state.proximity_y;
             track_begin_end trackBeginEnd;
             if (!track_block_get_previous(x, y, tileElement, &trackBeginEnd))
             {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+                state.state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
 
             x = trackBeginEnd.begin_x;
             y = trackBeginEnd.begin_y;
             z = trackBeginEnd.begin_z;
-            if (x == gRideRatingsCalcData.proximity_start_x && y == gRideRatingsCalcData.proximity_start_y
-                && z == gRideRatingsCalcData.proximity_start_z)
+            if (x == state.proximity_start_x && y == state.proximity_start_y
+                && z == state.proximity_start_z)
             {
-                gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+                state.state = RIDE_RATINGS_STATE_CALCULATE;
                 return;
             }
-            gRideRatingsCalcData.proximity_x = x;
-            gRideRatingsCalcData.proximity_y = y;
-            gRideRatingsCalcData.proximity_z = z;
-            gRideRatingsCalcData.proximity_track_type = trackBeginEnd.begin_element->AsTrack()->GetTrackType();
+            state.proximity_x = x;
+            state.proximity_y = y;
+            state.proximity_z = z;
+            state.proximity_track_type = trackBeginEnd.begin_element->AsTrack()->GetTrackType();
             return;
         }
     } while (!(tileElement++)->IsLastForTile());
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
 /**
  *
  *  rct2: 0x006B5BB2
  */
-static void ride_ratings_begin_proximity_loop()
+static void ride_ratings_begin_proximity_loop(RideRatingCalculationData& state)
 {
-    auto ride = get_ride(gRideRatingsCalcData.current_ride);
+    auto ride = get_ride(state.current_ride);
     if (ride == nullptr || ride->status == RIDE_STATUS_CLOSED)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+        state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
         return;
     }
 
     if (ride->type == RIDE_TYPE_MAZE)
     {
-        gRideRatingsCalcData.state = RIDE_RATINGS_STATE_CALCULATE;
+        state.state = RIDE_RATINGS_STATE_CALCULATE;
         return;
     }
 
@@ -388,43 +471,43 @@ static void ride_ratings_begin_proximity_loop()
     {
         if (!ride->stations[i].Start.isNull())
         {
-            gRideRatingsCalcData.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+            state.station_flags &= ~RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
             if (ride_get_entrance_location(ride, i).isNull())
             {
-                gRideRatingsCalcData.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
+                state.station_flags |= RIDE_RATING_STATION_FLAG_NO_ENTRANCE;
             }
 
             int32_t x = ride->stations[i].Start.x * 32;
             int32_t y = ride->stations[i].Start.y * 32;
             int32_t z = ride->stations[i].GetBaseZ();
 
-            gRideRatingsCalcData.proximity_x = x;
-            gRideRatingsCalcData.proximity_y = y;
-            gRideRatingsCalcData.proximity_z = z;
-            gRideRatingsCalcData.proximity_track_type = 255;
-            gRideRatingsCalcData.proximity_start_x = x;
-            gRideRatingsCalcData.proximity_start_y = y;
-            gRideRatingsCalcData.proximity_start_z = z;
+            state.proximity_x = x;
+            state.proximity_y = y;
+            state.proximity_z = z;
+            state.proximity_track_type = 255;
+            state.proximity_start_x = x;
+            state.proximity_start_y = y;
+            state.proximity_start_z = z;
             return;
         }
     }
 
-    gRideRatingsCalcData.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
+    state.state = RIDE_RATINGS_STATE_FIND_NEXT_RIDE;
 }
 
-static void proximity_score_increment(int32_t type)
+static void proximity_score_increment(RideRatingCalculationData& state, int32_t type)
 {
-    gRideRatingsCalcData.proximity_scores[type]++;
+    state.proximity_scores[type]++;
 }
 
 /**
  *
  *  rct2: 0x006B6207
  */
-static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTileElement, int32_t direction)
+static void ride_ratings_score_close_proximity_in_direction(RideRatingCalculationData& state, TileElement* inputTileElement, int32_t direction)
 {
-    int32_t x = gRideRatingsCalcData.proximity_x + CoordsDirectionDelta[direction].x;
-    int32_t y = gRideRatingsCalcData.proximity_y + CoordsDirectionDelta[direction].y;
+    int32_t x = state.proximity_x + CoordsDirectionDelta[direction].x;
+    int32_t y = state.proximity_y + CoordsDirectionDelta[direction].y;
     if (x < 0 || y < 0 || x >= (32 * 256) || y >= (32 * 256))
         return;
 
@@ -439,18 +522,18 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
         switch (tileElement->GetType())
         {
             case TILE_ELEMENT_TYPE_SURFACE:
-                if (gRideRatingsCalcData.proximity_base_height <= inputTileElement->base_height)
+                if (state.proximity_base_height <= inputTileElement->base_height)
                 {
                     if (inputTileElement->clearance_height <= tileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_SURFACE_SIDE_CLOSE);
+                        proximity_score_increment(state, PROXIMITY_SURFACE_SIDE_CLOSE);
                     }
                 }
                 break;
             case TILE_ELEMENT_TYPE_PATH:
                 if (abs((int32_t)inputTileElement->base_height - (int32_t)tileElement->base_height) <= 2)
                 {
-                    proximity_score_increment(PROXIMITY_PATH_SIDE_CLOSE);
+                    proximity_score_increment(state, PROXIMITY_PATH_SIDE_CLOSE);
                 }
                 break;
             case TILE_ELEMENT_TYPE_TRACK:
@@ -458,7 +541,7 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
                 {
                     if (abs((int32_t)inputTileElement->base_height - (int32_t)tileElement->base_height) <= 2)
                     {
-                        proximity_score_increment(PROXIMITY_FOREIGN_TRACK_SIDE_CLOSE);
+                        proximity_score_increment(state, PROXIMITY_FOREIGN_TRACK_SIDE_CLOSE);
                     }
                 }
                 break;
@@ -468,11 +551,11 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
                 {
                     if (inputTileElement->base_height > tileElement->clearance_height)
                     {
-                        proximity_score_increment(PROXIMITY_SCENERY_SIDE_ABOVE);
+                        proximity_score_increment(state, PROXIMITY_SCENERY_SIDE_ABOVE);
                     }
                     else
                     {
-                        proximity_score_increment(PROXIMITY_SCENERY_SIDE_BELOW);
+                        proximity_score_increment(state, PROXIMITY_SCENERY_SIDE_BELOW);
                     }
                 }
                 break;
@@ -480,7 +563,7 @@ static void ride_ratings_score_close_proximity_in_direction(TileElement* inputTi
     } while (!(tileElement++)->IsLastForTile());
 }
 
-static void ride_ratings_score_close_proximity_loops_helper(TileElement* inputTileElement, int32_t x, int32_t y)
+static void ride_ratings_score_close_proximity_loops_helper(RideRatingCalculationData& state, TileElement* inputTileElement, int32_t x, int32_t y)
 {
     TileElement* tileElement = map_get_first_element_at({ x, y });
     if (tileElement == nullptr)
@@ -497,7 +580,7 @@ static void ride_ratings_score_close_proximity_loops_helper(TileElement* inputTi
                 int32_t zDiff = (int32_t)tileElement->base_height - (int32_t)inputTileElement->base_height;
                 if (zDiff >= 0 && zDiff <= 16)
                 {
-                    proximity_score_increment(PROXIMITY_PATH_TROUGH_VERTICAL_LOOP);
+                    proximity_score_increment(state, PROXIMITY_PATH_TROUGH_VERTICAL_LOOP);
                 }
             }
             break;
@@ -510,11 +593,11 @@ static void ride_ratings_score_close_proximity_loops_helper(TileElement* inputTi
                     int32_t zDiff = (int32_t)tileElement->base_height - (int32_t)inputTileElement->base_height;
                     if (zDiff >= 0 && zDiff <= 16)
                     {
-                        proximity_score_increment(PROXIMITY_TRACK_THROUGH_VERTICAL_LOOP);
+                        proximity_score_increment(state, PROXIMITY_TRACK_THROUGH_VERTICAL_LOOP);
                         if (tileElement->AsTrack()->GetTrackType() == TRACK_ELEM_LEFT_VERTICAL_LOOP
                             || tileElement->AsTrack()->GetTrackType() == TRACK_ELEM_RIGHT_VERTICAL_LOOP)
                         {
-                            proximity_score_increment(PROXIMITY_INTERSECTING_VERTICAL_LOOP);
+                            proximity_score_increment(state, PROXIMITY_INTERSECTING_VERTICAL_LOOP);
                         }
                     }
                 }
@@ -528,19 +611,19 @@ static void ride_ratings_score_close_proximity_loops_helper(TileElement* inputTi
  *
  *  rct2: 0x006B62DA
  */
-static void ride_ratings_score_close_proximity_loops(TileElement* inputTileElement)
+static void ride_ratings_score_close_proximity_loops(RideRatingCalculationData& state, TileElement* inputTileElement)
 {
     int32_t trackType = inputTileElement->AsTrack()->GetTrackType();
     if (trackType == TRACK_ELEM_LEFT_VERTICAL_LOOP || trackType == TRACK_ELEM_RIGHT_VERTICAL_LOOP)
     {
-        int32_t x = gRideRatingsCalcData.proximity_x;
-        int32_t y = gRideRatingsCalcData.proximity_y;
-        ride_ratings_score_close_proximity_loops_helper(inputTileElement, x, y);
+        int32_t x = state.proximity_x;
+        int32_t y = state.proximity_y;
+        ride_ratings_score_close_proximity_loops_helper(state, inputTileElement, x, y);
 
         int32_t direction = inputTileElement->GetDirection();
-        x = gRideRatingsCalcData.proximity_x + CoordsDirectionDelta[direction].x;
-        y = gRideRatingsCalcData.proximity_y + CoordsDirectionDelta[direction].y;
-        ride_ratings_score_close_proximity_loops_helper(inputTileElement, x, y);
+        x = state.proximity_x + CoordsDirectionDelta[direction].x;
+        y = state.proximity_y + CoordsDirectionDelta[direction].y;
+        ride_ratings_score_close_proximity_loops_helper(state, inputTileElement, x, y);
     }
 }
 
@@ -548,16 +631,16 @@ static void ride_ratings_score_close_proximity_loops(TileElement* inputTileEleme
  *
  *  rct2: 0x006B5F9D
  */
-static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
+static void ride_ratings_score_close_proximity(RideRatingCalculationData& state, TileElement* inputTileElement)
 {
-    if (gRideRatingsCalcData.station_flags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE)
+    if (state.station_flags & RIDE_RATING_STATION_FLAG_NO_ENTRANCE)
     {
         return;
     }
 
-    gRideRatingsCalcData.proximity_total++;
-    int32_t x = gRideRatingsCalcData.proximity_x;
-    int32_t y = gRideRatingsCalcData.proximity_y;
+    state.proximity_total++;
+    int32_t x = state.proximity_x;
+    int32_t y = state.proximity_y;
     TileElement* tileElement = map_get_first_element_at({ x, y });
     if (tileElement == nullptr)
         return;
@@ -570,31 +653,31 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
         switch (tileElement->GetType())
         {
             case TILE_ELEMENT_TYPE_SURFACE:
-                gRideRatingsCalcData.proximity_base_height = tileElement->base_height;
-                if (tileElement->GetBaseZ() == gRideRatingsCalcData.proximity_z)
+                state.proximity_base_height = tileElement->base_height;
+                if (tileElement->GetBaseZ() == state.proximity_z)
                 {
-                    proximity_score_increment(PROXIMITY_SURFACE_TOUCH);
+                    proximity_score_increment(state, PROXIMITY_SURFACE_TOUCH);
                 }
                 waterHeight = tileElement->AsSurface()->GetWaterHeight();
                 if (waterHeight != 0)
                 {
                     int32_t z = waterHeight * 16;
-                    if (z <= gRideRatingsCalcData.proximity_z)
+                    if (z <= state.proximity_z)
                     {
-                        proximity_score_increment(PROXIMITY_WATER_OVER);
-                        if (z == gRideRatingsCalcData.proximity_z)
+                        proximity_score_increment(state, PROXIMITY_WATER_OVER);
+                        if (z == state.proximity_z)
                         {
-                            proximity_score_increment(PROXIMITY_WATER_TOUCH);
+                            proximity_score_increment(state, PROXIMITY_WATER_TOUCH);
                         }
                         z += 16;
-                        if (z == gRideRatingsCalcData.proximity_z)
+                        if (z == state.proximity_z)
                         {
-                            proximity_score_increment(PROXIMITY_WATER_LOW);
+                            proximity_score_increment(state, PROXIMITY_WATER_LOW);
                         }
                         z += 112;
-                        if (z <= gRideRatingsCalcData.proximity_z)
+                        if (z <= state.proximity_z)
                         {
-                            proximity_score_increment(PROXIMITY_WATER_HIGH);
+                            proximity_score_increment(state, PROXIMITY_WATER_HIGH);
                         }
                     }
                 }
@@ -605,11 +688,11 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                 {
                     if (tileElement->clearance_height == inputTileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_PATH_TOUCH_ABOVE);
+                        proximity_score_increment(state, PROXIMITY_PATH_TOUCH_ABOVE);
                     }
                     if (tileElement->base_height == inputTileElement->clearance_height)
                     {
-                        proximity_score_increment(PROXIMITY_PATH_TOUCH_UNDER);
+                        proximity_score_increment(state, PROXIMITY_PATH_TOUCH_UNDER);
                     }
                 }
                 else
@@ -617,15 +700,15 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                     // Bonus for path in first object entry
                     if (tileElement->clearance_height <= inputTileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_PATH_ZERO_OVER);
+                        proximity_score_increment(state, PROXIMITY_PATH_ZERO_OVER);
                     }
                     if (tileElement->clearance_height == inputTileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_PATH_ZERO_TOUCH_ABOVE);
+                        proximity_score_increment(state, PROXIMITY_PATH_ZERO_TOUCH_ABOVE);
                     }
                     if (tileElement->base_height == inputTileElement->clearance_height)
                     {
-                        proximity_score_increment(PROXIMITY_PATH_ZERO_TOUCH_UNDER);
+                        proximity_score_increment(state, PROXIMITY_PATH_ZERO_TOUCH_UNDER);
                     }
                 }
                 break;
@@ -639,33 +722,33 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                     {
                         if (tileElement->base_height - inputTileElement->clearance_height <= 10)
                         {
-                            proximity_score_increment(PROXIMITY_THROUGH_VERTICAL_LOOP);
+                            proximity_score_increment(state, PROXIMITY_THROUGH_VERTICAL_LOOP);
                         }
                     }
                 }
                 if (inputTileElement->AsTrack()->GetRideIndex() != tileElement->AsTrack()->GetRideIndex())
                 {
-                    proximity_score_increment(PROXIMITY_FOREIGN_TRACK_ABOVE_OR_BELOW);
+                    proximity_score_increment(state, PROXIMITY_FOREIGN_TRACK_ABOVE_OR_BELOW);
                     if (tileElement->clearance_height == inputTileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
+                        proximity_score_increment(state, PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
                     }
                     if (tileElement->clearance_height + 2 <= inputTileElement->base_height)
                     {
                         if (tileElement->clearance_height + 10 >= inputTileElement->base_height)
                         {
-                            proximity_score_increment(PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
+                            proximity_score_increment(state, PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
                         }
                     }
                     if (inputTileElement->clearance_height == tileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
+                        proximity_score_increment(state, PROXIMITY_FOREIGN_TRACK_TOUCH_ABOVE);
                     }
                     if (inputTileElement->clearance_height + 2 == tileElement->base_height)
                     {
                         if ((uint8_t)(inputTileElement->clearance_height + 10) >= tileElement->base_height)
                         {
-                            proximity_score_increment(PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
+                            proximity_score_increment(state, PROXIMITY_FOREIGN_TRACK_CLOSE_ABOVE);
                         }
                     }
                 }
@@ -677,40 +760,40 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
                            || trackType == TRACK_ELEM_BEGIN_STATION);
                     if (tileElement->clearance_height == inputTileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
+                        proximity_score_increment(state, PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
                         if (isStation)
                         {
-                            proximity_score_increment(PROXIMITY_OWN_STATION_TOUCH_ABOVE);
+                            proximity_score_increment(state, PROXIMITY_OWN_STATION_TOUCH_ABOVE);
                         }
                     }
                     if (tileElement->clearance_height + 2 <= inputTileElement->base_height)
                     {
                         if (tileElement->clearance_height + 10 >= inputTileElement->base_height)
                         {
-                            proximity_score_increment(PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
+                            proximity_score_increment(state, PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
                             if (isStation)
                             {
-                                proximity_score_increment(PROXIMITY_OWN_STATION_CLOSE_ABOVE);
+                                proximity_score_increment(state, PROXIMITY_OWN_STATION_CLOSE_ABOVE);
                             }
                         }
                     }
 
                     if (inputTileElement->clearance_height == tileElement->base_height)
                     {
-                        proximity_score_increment(PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
+                        proximity_score_increment(state, PROXIMITY_OWN_TRACK_TOUCH_ABOVE);
                         if (isStation)
                         {
-                            proximity_score_increment(PROXIMITY_OWN_STATION_TOUCH_ABOVE);
+                            proximity_score_increment(state, PROXIMITY_OWN_STATION_TOUCH_ABOVE);
                         }
                     }
                     if (inputTileElement->clearance_height + 2 <= tileElement->base_height)
                     {
                         if (inputTileElement->clearance_height + 10 >= tileElement->base_height)
                         {
-                            proximity_score_increment(PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
+                            proximity_score_increment(state, PROXIMITY_OWN_TRACK_CLOSE_ABOVE);
                             if (isStation)
                             {
-                                proximity_score_increment(PROXIMITY_OWN_STATION_CLOSE_ABOVE);
+                                proximity_score_increment(state, PROXIMITY_OWN_STATION_CLOSE_ABOVE);
                             }
                         }
                     }
@@ -721,28 +804,28 @@ static void ride_ratings_score_close_proximity(TileElement* inputTileElement)
     } while (!(tileElement++)->IsLastForTile());
 
     uint8_t direction = inputTileElement->GetDirection();
-    ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction + 1) & 3);
-    ride_ratings_score_close_proximity_in_direction(inputTileElement, (direction - 1) & 3);
-    ride_ratings_score_close_proximity_loops(inputTileElement);
+    ride_ratings_score_close_proximity_in_direction(state, inputTileElement, (direction + 1) & 3);
+    ride_ratings_score_close_proximity_in_direction(state, inputTileElement, (direction - 1) & 3);
+    ride_ratings_score_close_proximity_loops(state, inputTileElement);
 
-    switch (gRideRatingsCalcData.proximity_track_type)
+    switch (state.proximity_track_type)
     {
         case TRACK_ELEM_BRAKES:
-            gRideRatingsCalcData.num_brakes++;
+            state.num_brakes++;
             break;
         case TRACK_ELEM_LEFT_REVERSER:
         case TRACK_ELEM_RIGHT_REVERSER:
-            gRideRatingsCalcData.num_reversers++;
+            state.num_reversers++;
             break;
     }
 }
 
-static void ride_ratings_calculate(Ride* ride)
+static void ride_ratings_calculate(RideRatingCalculationData& state, Ride* ride)
 {
     auto calcFunc = ride_ratings_get_calculate_func(ride->type);
     if (calcFunc != nullptr)
     {
-        calcFunc(ride);
+        calcFunc(ride, state);
     }
 
 #ifdef ORIGINAL_RATINGS
@@ -853,7 +936,7 @@ static void ride_ratings_calculate_value(Ride* ride)
  * inputs
  * - edi: ride ptr
  */
-static uint16_t ride_compute_upkeep(Ride* ride)
+static uint16_t ride_compute_upkeep(Ride* ride, const RideRatingCalculationData& state)
 {
     // data stored at 0x0057E3A8, incrementing 18 bytes at a time
     uint16_t upkeep = initialUpkeepCosts[ride->type];
@@ -892,10 +975,10 @@ static uint16_t ride_compute_upkeep(Ride* ride)
     {
         reverserMaintenanceCost = 10;
     }
-    upkeep += reverserMaintenanceCost * gRideRatingsCalcData.num_reversers;
+    upkeep += reverserMaintenanceCost * state.num_reversers;
 
     // Add maintenance cost for brake track pieces
-    upkeep += 20 * gRideRatingsCalcData.num_brakes;
+    upkeep += 20 * state.num_brakes;
 
     // these seem to be adhoc adjustments to a ride's upkeep/cost, times
     // various variables set on the ride itself.
@@ -1053,9 +1136,9 @@ static uint32_t get_proximity_score_helper_3(uint16_t x, uint16_t resultIfNotZer
  *
  *  rct2: 0x0065E277
  */
-static uint32_t ride_ratings_get_proximity_score()
+static uint32_t ride_ratings_get_proximity_score(const RideRatingCalculationData& state)
 {
-    const uint16_t* scores = gRideRatingsCalcData.proximity_scores;
+    const uint16_t* scores = state.proximity_scores;
 
     uint32_t result = 0;
     result += get_proximity_score_helper_1(scores[PROXIMITY_WATER_OVER], 60, 0x00AAAA);
@@ -1585,9 +1668,9 @@ static void ride_ratings_apply_rotations(
         ride->rotations * nauseaMultiplier);
 }
 
-static void ride_ratings_apply_proximity(rating_tuple* ratings, int32_t excitementMultiplier)
+static void ride_ratings_apply_proximity(RideRatingCalculationData& state, rating_tuple* ratings, int32_t excitementMultiplier)
 {
-    ride_ratings_add(ratings, (ride_ratings_get_proximity_score() * excitementMultiplier) >> 16, 0, 0);
+    ride_ratings_add(ratings, (ride_ratings_get_proximity_score(state) * excitementMultiplier) >> 16, 0, 0);
 }
 
 static void ride_ratings_apply_scenery(rating_tuple* ratings, Ride* ride, int32_t excitementMultiplier)
@@ -1712,7 +1795,7 @@ static void ride_ratings_apply_first_length_penalty(
 
 #pragma region Ride rating calculation functions
 
-static void ride_ratings_calculate_spiral_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_spiral_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1732,7 +1815,7 @@ static void ride_ratings_calculate_spiral_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 28235, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -1752,13 +1835,13 @@ static void ride_ratings_calculate_spiral_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_stand_up_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_stand_up_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1778,7 +1861,7 @@ static void ride_ratings_calculate_stand_up_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 34952, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 28398, 30427);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(state, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -1790,13 +1873,13 @@ static void ride_ratings_calculate_stand_up_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_suspended_swinging_coaster(Ride* ride)
+static void ride_ratings_calculate_suspended_swinging_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1816,7 +1899,7 @@ static void ride_ratings_calculate_suspended_swinging_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 48036);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6971);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xC0000, 2, 2, 2);
@@ -1830,13 +1913,13 @@ static void ride_ratings_calculate_suspended_swinging_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_inverted_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_inverted_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1856,7 +1939,7 @@ static void ride_ratings_calculate_inverted_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(state, &ratings, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
 
     if (ride->inversions == 0)
@@ -1873,13 +1956,13 @@ static void ride_ratings_calculate_inverted_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_junior_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_junior_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1899,7 +1982,7 @@ static void ride_ratings_calculate_junior_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -1911,13 +1994,13 @@ static void ride_ratings_calculate_junior_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_miniature_railway(Ride* ride)
+static void ride_ratings_calculate_miniature_railway(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1933,7 +2016,7 @@ static void ride_ratings_calculate_miniature_railway(Ride* ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 436906);
     ride_ratings_apply_duration(&ratings, ride, 150, 26214);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, -6425, 6553, 23405);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(state, &ratings, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 20915);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 2, 2, 2);
 
@@ -1942,7 +2025,7 @@ static void ride_ratings_calculate_miniature_railway(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -1952,7 +2035,7 @@ static void ride_ratings_calculate_miniature_railway(Ride* ride)
     ride->sheltered_eighths = shelteredEighths.TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_monorail(Ride* ride)
+static void ride_ratings_calculate_monorail(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -1968,7 +2051,7 @@ static void ride_ratings_calculate_monorail(Ride* ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 218453);
     ride_ratings_apply_duration(&ratings, ride, 150, 21845);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 18724);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(state, &ratings, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xAA0000, 2, 2, 2);
 
@@ -1977,7 +2060,7 @@ static void ride_ratings_calculate_monorail(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -1987,7 +2070,7 @@ static void ride_ratings_calculate_monorail(Ride* ride)
     ride->sheltered_eighths = shelteredEighths.TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mini_suspended_coaster(Ride* ride)
+static void ride_ratings_calculate_mini_suspended_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2007,7 +2090,7 @@ static void ride_ratings_calculate_mini_suspended_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 34179, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 58254, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 13943);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x80000, 2, 2, 2);
@@ -2020,13 +2103,13 @@ static void ride_ratings_calculate_mini_suspended_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_boat_hire(Ride* ride)
+static void ride_ratings_calculate_boat_hire(Ride* ride, RideRatingCalculationData& state)
 {
     ride->unreliability_factor = 7;
     set_unreliability_factor(ride);
@@ -2044,7 +2127,7 @@ static void ride_ratings_calculate_boat_hire(Ride* ride)
         ride_ratings_add(&ratings, RIDE_RATING(0, 20), 0, 0);
     }
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 22310);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2052,13 +2135,13 @@ static void ride_ratings_calculate_boat_hire(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_wooden_wild_mouse(Ride* ride)
+static void ride_ratings_calculate_wooden_wild_mouse(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2078,7 +2161,7 @@ static void ride_ratings_calculate_wooden_wild_mouse(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(state, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -2093,13 +2176,13 @@ static void ride_ratings_calculate_wooden_wild_mouse(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_steeplechase(Ride* ride)
+static void ride_ratings_calculate_steeplechase(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2119,7 +2202,7 @@ static void ride_ratings_calculate_steeplechase(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 4, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x80000, 2, 2, 2);
@@ -2133,13 +2216,13 @@ static void ride_ratings_calculate_steeplechase(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_car_ride(Ride* ride)
+static void ride_ratings_calculate_car_ride(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2158,7 +2241,7 @@ static void ride_ratings_calculate_car_ride(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 11437);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 8, 2, 2);
 
@@ -2167,13 +2250,13 @@ static void ride_ratings_calculate_car_ride(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_launched_freefall(Ride* ride)
+static void ride_ratings_calculate_launched_freefall(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2210,7 +2293,7 @@ static void ride_ratings_calculate_launched_freefall(Ride* ride)
     }
 #endif
 
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2218,13 +2301,13 @@ static void ride_ratings_calculate_launched_freefall(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_bobsleigh_coaster(Ride* ride)
+static void ride_ratings_calculate_bobsleigh_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2244,7 +2327,7 @@ static void ride_ratings_calculate_bobsleigh_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xC0000, 2, 2, 2);
     ride_ratings_apply_max_lateral_g_penalty(&ratings, ride, FIXED_2DP(1, 20), 2, 2, 2);
@@ -2256,13 +2339,13 @@ static void ride_ratings_calculate_bobsleigh_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_observation_tower(Ride* ride)
+static void ride_ratings_calculate_observation_tower(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2274,7 +2357,7 @@ static void ride_ratings_calculate_observation_tower(Ride* ride)
     ride_ratings_set(&ratings, RIDE_RATING(1, 50), RIDE_RATING(0, 00), RIDE_RATING(0, 10));
     ride_ratings_add(
         &ratings, ((ride_get_total_length(ride) >> 16) * 45875) >> 16, 0, ((ride_get_total_length(ride) >> 16) * 26214) >> 16);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 83662);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2282,7 +2365,7 @@ static void ride_ratings_calculate_observation_tower(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
@@ -2292,7 +2375,7 @@ static void ride_ratings_calculate_observation_tower(Ride* ride)
         ride->excitement /= 4;
 }
 
-static void ride_ratings_calculate_looping_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_looping_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2312,7 +2395,7 @@ static void ride_ratings_calculate_looping_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -2332,13 +2415,13 @@ static void ride_ratings_calculate_looping_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_dinghy_slide(Ride* ride)
+static void ride_ratings_calculate_dinghy_slide(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2358,7 +2441,7 @@ static void ride_ratings_calculate_dinghy_slide(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -2370,13 +2453,13 @@ static void ride_ratings_calculate_dinghy_slide(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mine_train_coaster(Ride* ride)
+static void ride_ratings_calculate_mine_train_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2396,7 +2479,7 @@ static void ride_ratings_calculate_mine_train_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 21472);
+    ride_ratings_apply_proximity(state, &ratings, 21472);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -2410,13 +2493,13 @@ static void ride_ratings_calculate_mine_train_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_chairlift(Ride* ride)
+static void ride_ratings_calculate_chairlift(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2433,7 +2516,7 @@ static void ride_ratings_calculate_chairlift(Ride* ride)
     ride_ratings_apply_duration(&ratings, ride, 150, 26214);
     ride_ratings_apply_turns(&ratings, ride, 7430, 3476, 4574);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, -19275, 21845, 23405);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x960000, 2, 2, 2);
 
@@ -2448,7 +2531,7 @@ static void ride_ratings_calculate_chairlift(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -2458,7 +2541,7 @@ static void ride_ratings_calculate_chairlift(Ride* ride)
     ride->sheltered_eighths = shelteredEighths.TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_corkscrew_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_corkscrew_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2478,7 +2561,7 @@ static void ride_ratings_calculate_corkscrew_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -2498,13 +2581,13 @@ static void ride_ratings_calculate_corkscrew_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_maze(Ride* ride)
+static void ride_ratings_calculate_maze(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2524,13 +2607,13 @@ static void ride_ratings_calculate_maze(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_spiral_slide(Ride* ride)
+static void ride_ratings_calculate_spiral_slide(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2553,13 +2636,13 @@ static void ride_ratings_calculate_spiral_slide(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 2;
 }
 
-static void ride_ratings_calculate_go_karts(Ride* ride)
+static void ride_ratings_calculate_go_karts(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2582,7 +2665,7 @@ static void ride_ratings_calculate_go_karts(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 4458, 3476, 5718);
     ride_ratings_apply_drops(&ratings, ride, 8738, 5461, 6553);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 2570, 8738, 2340);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -2590,7 +2673,7 @@ static void ride_ratings_calculate_go_karts(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -2600,7 +2683,7 @@ static void ride_ratings_calculate_go_karts(Ride* ride)
         ride->excitement /= 2;
 }
 
-static void ride_ratings_calculate_log_flume(Ride* ride)
+static void ride_ratings_calculate_log_flume(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2617,7 +2700,7 @@ static void ride_ratings_calculate_log_flume(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 69905, 62415, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(state, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 2, 2, 2, 2);
 
@@ -2626,13 +2709,13 @@ static void ride_ratings_calculate_log_flume(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_river_rapids(Ride* ride)
+static void ride_ratings_calculate_river_rapids(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2649,7 +2732,7 @@ static void ride_ratings_calculate_river_rapids(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 22598, 5718);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 31314);
+    ride_ratings_apply_proximity(state, &ratings, 31314);
     ride_ratings_apply_scenery(&ratings, ride, 13943);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 2, 2, 2, 2);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xC80000, 2, 2, 2);
@@ -2659,13 +2742,13 @@ static void ride_ratings_calculate_river_rapids(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_dodgems(Ride* ride)
+static void ride_ratings_calculate_dodgems(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2694,13 +2777,13 @@ static void ride_ratings_calculate_dodgems(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_pirate_ship(Ride* ride)
+static void ride_ratings_calculate_pirate_ship(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2719,13 +2802,13 @@ static void ride_ratings_calculate_pirate_ship(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_inverter_ship(Ride* ride)
+static void ride_ratings_calculate_inverter_ship(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2744,31 +2827,31 @@ static void ride_ratings_calculate_inverter_ship(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_food_stall(Ride* ride)
+static void ride_ratings_calculate_food_stall(Ride* ride, RideRatingCalculationData& state)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_drink_stall(Ride* ride)
+static void ride_ratings_calculate_drink_stall(Ride* ride, RideRatingCalculationData& state)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_shop(Ride* ride)
+static void ride_ratings_calculate_shop(Ride* ride, RideRatingCalculationData& state)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_merry_go_round(Ride* ride)
+static void ride_ratings_calculate_merry_go_round(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2784,25 +2867,25 @@ static void ride_ratings_calculate_merry_go_round(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_information_kiosk(Ride* ride)
+static void ride_ratings_calculate_information_kiosk(Ride* ride, RideRatingCalculationData& state)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_toilets(Ride* ride)
+static void ride_ratings_calculate_toilets(Ride* ride, RideRatingCalculationData& state)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_ferris_wheel(Ride* ride)
+static void ride_ratings_calculate_ferris_wheel(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2818,13 +2901,13 @@ static void ride_ratings_calculate_ferris_wheel(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_motion_simulator(Ride* ride)
+static void ride_ratings_calculate_motion_simulator(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2851,13 +2934,13 @@ static void ride_ratings_calculate_motion_simulator(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_3d_cinema(Ride* ride)
+static void ride_ratings_calculate_3d_cinema(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2891,13 +2974,13 @@ static void ride_ratings_calculate_3d_cinema(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths |= 7;
 }
 
-static void ride_ratings_calculate_top_spin(Ride* ride)
+static void ride_ratings_calculate_top_spin(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2933,13 +3016,13 @@ static void ride_ratings_calculate_top_spin(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_space_rings(Ride* ride)
+static void ride_ratings_calculate_space_rings(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -2955,13 +3038,13 @@ static void ride_ratings_calculate_space_rings(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_reverse_freefall_coaster(Ride* ride)
+static void ride_ratings_calculate_reverse_freefall_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -2976,7 +3059,7 @@ static void ride_ratings_calculate_reverse_freefall_coaster(Ride* ride)
     ride_ratings_apply_max_speed(&ratings, ride, 436906, 436906, 320398);
     ride_ratings_apply_gforces(&ratings, ride, 24576, 41704, 59578);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 28398, 11702);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(state, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 34, 2, 2, 2);
 
@@ -2985,13 +3068,13 @@ static void ride_ratings_calculate_reverse_freefall_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_lift(Ride* ride)
+static void ride_ratings_calculate_lift(Ride* ride, RideRatingCalculationData& state)
 {
     int32_t totalLength;
 
@@ -3007,7 +3090,7 @@ static void ride_ratings_calculate_lift(Ride* ride)
     totalLength = ride_get_total_length(ride) >> 16;
     ride_ratings_add(&ratings, (totalLength * 45875) >> 16, 0, (totalLength * 26214) >> 16);
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 83662);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -3015,7 +3098,7 @@ static void ride_ratings_calculate_lift(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
@@ -3024,7 +3107,7 @@ static void ride_ratings_calculate_lift(Ride* ride)
         ride->excitement /= 4;
 }
 
-static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3043,7 +3126,7 @@ static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 58254, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 20, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -3056,19 +3139,19 @@ static void ride_ratings_calculate_vertical_drop_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_cash_machine(Ride* ride)
+static void ride_ratings_calculate_cash_machine(Ride* ride, RideRatingCalculationData& state)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_twist(Ride* ride)
+static void ride_ratings_calculate_twist(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3084,13 +3167,13 @@ static void ride_ratings_calculate_twist(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_haunted_house(Ride* ride)
+static void ride_ratings_calculate_haunted_house(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3108,13 +3191,13 @@ static void ride_ratings_calculate_haunted_house(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_flying_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_flying_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3134,7 +3217,7 @@ static void ride_ratings_calculate_flying_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3153,13 +3236,13 @@ static void ride_ratings_calculate_flying_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_virginia_reel(Ride* ride)
+static void ride_ratings_calculate_virginia_reel(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3179,7 +3262,7 @@ static void ride_ratings_calculate_virginia_reel(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 52012, 26075, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(state, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xD20000, 2, 2, 2);
     ride_ratings_apply_num_drops_penalty(&ratings, ride, 2, 2, 2, 2);
@@ -3190,13 +3273,13 @@ static void ride_ratings_calculate_virginia_reel(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_splash_boats(Ride* ride)
+static void ride_ratings_calculate_splash_boats(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3213,7 +3296,7 @@ static void ride_ratings_calculate_splash_boats(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 87381, 93622, 62259);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(state, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
 
@@ -3222,13 +3305,13 @@ static void ride_ratings_calculate_splash_boats(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mini_helicopters(Ride* ride)
+static void ride_ratings_calculate_mini_helicopters(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3247,7 +3330,7 @@ static void ride_ratings_calculate_mini_helicopters(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 4574);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 12850, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(state, &ratings, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xA00000, 2, 2, 2);
 
@@ -3256,13 +3339,13 @@ static void ride_ratings_calculate_mini_helicopters(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 6;
 }
 
-static void ride_ratings_calculate_lay_down_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_lay_down_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3282,7 +3365,7 @@ static void ride_ratings_calculate_lay_down_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3306,13 +3389,13 @@ static void ride_ratings_calculate_lay_down_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_suspended_monorail(Ride* ride)
+static void ride_ratings_calculate_suspended_monorail(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3328,7 +3411,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride* ride)
     ride_ratings_apply_average_speed(&ratings, ride, 291271, 218453);
     ride_ratings_apply_duration(&ratings, ride, 150, 21845);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 18724);
-    ride_ratings_apply_proximity(&ratings, 12525);
+    ride_ratings_apply_proximity(state, &ratings, 12525);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xAA0000, 2, 2, 2);
 
@@ -3337,7 +3420,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     auto shelteredEighths = get_num_of_sheltered_eighths(ride);
@@ -3347,7 +3430,7 @@ static void ride_ratings_calculate_suspended_monorail(Ride* ride)
     ride->sheltered_eighths = shelteredEighths.TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3363,7 +3446,7 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
     ride_ratings_apply_max_speed(&ratings, ride, 44281, 88562, 35424);
     ride_ratings_apply_average_speed(&ratings, ride, 364088, 655360);
 
-    int32_t numReversers = std::min<uint16_t>(gRideRatingsCalcData.num_reversers, 6);
+    int32_t numReversers = std::min<uint16_t>(state.num_reversers, 6);
     ride_rating reverserRating = numReversers * RIDE_RATING(0, 20);
     ride_ratings_add(&ratings, reverserRating, reverserRating, reverserRating);
 
@@ -3372,10 +3455,10 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(state, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
 
-    if (gRideRatingsCalcData.num_reversers < 1)
+    if (state.num_reversers < 1)
     {
         ratings.excitement /= 8;
     }
@@ -3389,13 +3472,13 @@ static void ride_ratings_calculate_reverser_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_heartline_twister_coaster(Ride* ride)
+static void ride_ratings_calculate_heartline_twister_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3415,7 +3498,7 @@ static void ride_ratings_calculate_heartline_twister_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 52150, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 53052, 55705);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 34952, 35108);
-    ride_ratings_apply_proximity(&ratings, 9841);
+    ride_ratings_apply_proximity(state, &ratings, 9841);
     ride_ratings_apply_scenery(&ratings, ride, 3904);
 
     if (ride->inversions == 0)
@@ -3429,13 +3512,13 @@ static void ride_ratings_calculate_heartline_twister_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mini_golf(Ride* ride)
+static void ride_ratings_calculate_mini_golf(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3448,7 +3531,7 @@ static void ride_ratings_calculate_mini_golf(Ride* ride)
     ride_ratings_apply_length(&ratings, ride, 6000, 873);
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(state, &ratings, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 27887);
 
     // Apply golf holes factor
@@ -3467,19 +3550,19 @@ static void ride_ratings_calculate_mini_golf(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_first_aid(Ride* ride)
+static void ride_ratings_calculate_first_aid(Ride* ride, RideRatingCalculationData& state)
 {
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 }
 
-static void ride_ratings_calculate_circus_show(Ride* ride)
+static void ride_ratings_calculate_circus_show(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3497,13 +3580,13 @@ static void ride_ratings_calculate_circus_show(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_ghost_train(Ride* ride)
+static void ride_ratings_calculate_ghost_train(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3521,7 +3604,7 @@ static void ride_ratings_calculate_ghost_train(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 11437);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 6553, 4681);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0xB40000, 2, 2, 2);
 
@@ -3530,13 +3613,13 @@ static void ride_ratings_calculate_ghost_train(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_twister_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_twister_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3556,7 +3639,7 @@ static void ride_ratings_calculate_twister_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3576,13 +3659,13 @@ static void ride_ratings_calculate_twister_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_wooden_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_wooden_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3602,7 +3685,7 @@ static void ride_ratings_calculate_wooden_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(state, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -3616,13 +3699,13 @@ static void ride_ratings_calculate_wooden_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_side_friction_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_side_friction_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3642,7 +3725,7 @@ static void ride_ratings_calculate_side_friction_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 22367);
+    ride_ratings_apply_proximity(state, &ratings, 22367);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x50000, 2, 2, 2);
@@ -3655,13 +3738,13 @@ static void ride_ratings_calculate_side_friction_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_wild_mouse(Ride* ride)
+static void ride_ratings_calculate_wild_mouse(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3681,7 +3764,7 @@ static void ride_ratings_calculate_wild_mouse(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(state, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 6, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -3695,13 +3778,13 @@ static void ride_ratings_calculate_wild_mouse(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3721,7 +3804,7 @@ static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3740,13 +3823,13 @@ static void ride_ratings_calculate_multi_dimension_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_giga_coaster(Ride* ride)
+static void ride_ratings_calculate_giga_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3766,7 +3849,7 @@ static void ride_ratings_calculate_giga_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 28235, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 43690, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -3786,13 +3869,13 @@ static void ride_ratings_calculate_giga_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_roto_drop(Ride* ride)
+static void ride_ratings_calculate_roto_drop(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3806,7 +3889,7 @@ static void ride_ratings_calculate_roto_drop(Ride* ride)
     int32_t lengthFactor = ((ride_get_total_length(ride) >> 16) * 209715) >> 16;
     ride_ratings_add(&ratings, lengthFactor, lengthFactor * 2, lengthFactor * 2);
 
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 25098);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -3814,13 +3897,13 @@ static void ride_ratings_calculate_roto_drop(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_flying_saucers(Ride* ride)
+static void ride_ratings_calculate_flying_saucers(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3852,13 +3935,13 @@ static void ride_ratings_calculate_flying_saucers(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_crooked_house(Ride* ride)
+static void ride_ratings_calculate_crooked_house(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -3876,13 +3959,13 @@ static void ride_ratings_calculate_crooked_house(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 7;
 }
 
-static void ride_ratings_calculate_monorail_cycles(Ride* ride)
+static void ride_ratings_calculate_monorail_cycles(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3901,7 +3984,7 @@ static void ride_ratings_calculate_monorail_cycles(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 14860, 0, 4574);
     ride_ratings_apply_drops(&ratings, ride, 8738, 0, 0);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 5140, 6553, 2340);
-    ride_ratings_apply_proximity(&ratings, 8946);
+    ride_ratings_apply_proximity(state, &ratings, 8946);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x8C0000, 2, 2, 2);
 
@@ -3910,13 +3993,13 @@ static void ride_ratings_calculate_monorail_cycles(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_compact_inverted_coaster(Ride* ride)
+static void ride_ratings_calculate_compact_inverted_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3936,7 +4019,7 @@ static void ride_ratings_calculate_compact_inverted_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(state, &ratings, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 8366);
 
     if (ride->inversions == 0)
@@ -3953,13 +4036,13 @@ static void ride_ratings_calculate_compact_inverted_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_water_coaster(Ride* ride)
+static void ride_ratings_calculate_water_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -3979,7 +4062,7 @@ static void ride_ratings_calculate_water_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -3994,13 +4077,13 @@ static void ride_ratings_calculate_water_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_air_powered_vertical_coaster(Ride* ride)
+static void ride_ratings_calculate_air_powered_vertical_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4015,7 +4098,7 @@ static void ride_ratings_calculate_air_powered_vertical_coaster(Ride* ride)
     ride_ratings_apply_max_speed(&ratings, ride, 509724, 364088, 320398);
     ride_ratings_apply_gforces(&ratings, ride, 24576, 35746, 59578);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 21845, 11702);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(state, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 34, 2, 1, 1);
 
@@ -4025,13 +4108,13 @@ static void ride_ratings_calculate_air_powered_vertical_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_inverted_hairpin_coaster(Ride* ride)
+static void ride_ratings_calculate_inverted_hairpin_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4051,7 +4134,7 @@ static void ride_ratings_calculate_inverted_hairpin_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 43458, 45749);
     ride_ratings_apply_drops(&ratings, ride, 40777, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 16705, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 17893);
+    ride_ratings_apply_proximity(state, &ratings, 17893);
     ride_ratings_apply_scenery(&ratings, ride, 5577);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 8, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -4066,13 +4149,13 @@ static void ride_ratings_calculate_inverted_hairpin_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_magic_carpet(Ride* ride)
+static void ride_ratings_calculate_magic_carpet(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -4091,13 +4174,13 @@ static void ride_ratings_calculate_magic_carpet(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 0;
 }
 
-static void ride_ratings_calculate_submarine_ride(Ride* ride)
+static void ride_ratings_calculate_submarine_ride(Ride* ride, RideRatingCalculationData& state)
 {
     ride->unreliability_factor = 7;
     set_unreliability_factor(ride);
@@ -4107,7 +4190,7 @@ static void ride_ratings_calculate_submarine_ride(Ride* ride)
     rating_tuple ratings;
     ride_ratings_set(&ratings, RIDE_RATING(2, 20), RIDE_RATING(1, 80), RIDE_RATING(1, 40));
     ride_ratings_apply_length(&ratings, ride, 6000, 764);
-    ride_ratings_apply_proximity(&ratings, 11183);
+    ride_ratings_apply_proximity(state, &ratings, 11183);
     ride_ratings_apply_scenery(&ratings, ride, 22310);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -4115,14 +4198,14 @@ static void ride_ratings_calculate_submarine_ride(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     // Originally, this was always to zero, even though the default vehicle is completely enclosed.
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_river_rafts(Ride* ride)
+static void ride_ratings_calculate_river_rafts(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4138,7 +4221,7 @@ static void ride_ratings_calculate_river_rafts(Ride* ride)
     ride_ratings_apply_duration(&ratings, ride, 500, 13107);
     ride_ratings_apply_turns(&ratings, ride, 22291, 20860, 4574);
     ride_ratings_apply_drops(&ratings, ride, 78643, 93622, 62259);
-    ride_ratings_apply_proximity(&ratings, 13420);
+    ride_ratings_apply_proximity(state, &ratings, 13420);
     ride_ratings_apply_scenery(&ratings, ride, 11155);
 
     ride_ratings_apply_intensity_penalty(&ratings);
@@ -4146,13 +4229,13 @@ static void ride_ratings_calculate_river_rafts(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_enterprise(Ride* ride)
+static void ride_ratings_calculate_enterprise(Ride* ride, RideRatingCalculationData& state)
 {
     ride->lifecycle_flags |= RIDE_LIFECYCLE_TESTED;
     ride->lifecycle_flags |= RIDE_LIFECYCLE_NO_RAW_STATS;
@@ -4175,13 +4258,13 @@ static void ride_ratings_calculate_enterprise(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = 3;
 }
 
-static void ride_ratings_calculate_inverted_impulse_coaster(Ride* ride)
+static void ride_ratings_calculate_inverted_impulse_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4201,7 +4284,7 @@ static void ride_ratings_calculate_inverted_impulse_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 29552, 57186);
     ride_ratings_apply_drops(&ratings, ride, 29127, 39009, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 15291, 35108);
-    ride_ratings_apply_proximity(&ratings, 15657);
+    ride_ratings_apply_proximity(state, &ratings, 15657);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 20, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0xA0000, 2, 2, 2);
@@ -4212,13 +4295,13 @@ static void ride_ratings_calculate_inverted_impulse_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mini_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_mini_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4238,7 +4321,7 @@ static void ride_ratings_calculate_mini_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 25700, 30583, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 9760);
     ride_ratings_apply_highest_drop_height_penalty(&ratings, ride, 12, 2, 2, 2);
     ride_ratings_apply_max_speed_penalty(&ratings, ride, 0x70000, 2, 2, 2);
@@ -4251,13 +4334,13 @@ static void ride_ratings_calculate_mini_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_mine_ride(Ride* ride)
+static void ride_ratings_calculate_mine_ride(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4277,7 +4360,7 @@ static void ride_ratings_calculate_mine_ride(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 29721, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 19275, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 21472);
+    ride_ratings_apply_proximity(state, &ratings, 21472);
     ride_ratings_apply_scenery(&ratings, ride, 16732);
     ride_ratings_apply_first_length_penalty(&ratings, ride, 0x10E0000, 2, 2, 2);
 
@@ -4287,13 +4370,13 @@ static void ride_ratings_calculate_mine_ride(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
 }
 
-static void ride_ratings_calculate_lim_launched_roller_coaster(Ride* ride)
+static void ride_ratings_calculate_lim_launched_roller_coaster(Ride* ride, RideRatingCalculationData& state)
 {
     if (!(ride->lifecycle_flags & RIDE_LIFECYCLE_TESTED))
         return;
@@ -4313,7 +4396,7 @@ static void ride_ratings_calculate_lim_launched_roller_coaster(Ride* ride)
     ride_ratings_apply_turns(&ratings, ride, 26749, 34767, 45749);
     ride_ratings_apply_drops(&ratings, ride, 29127, 46811, 49152);
     ride_ratings_apply_sheltered_ratings(&ratings, ride, 15420, 32768, 35108);
-    ride_ratings_apply_proximity(&ratings, 20130);
+    ride_ratings_apply_proximity(state, &ratings, 20130);
     ride_ratings_apply_scenery(&ratings, ride, 6693);
 
     if (ride->inversions == 0)
@@ -4333,7 +4416,7 @@ static void ride_ratings_calculate_lim_launched_roller_coaster(Ride* ride)
 
     ride->ratings = ratings;
 
-    ride->upkeep_cost = ride_compute_upkeep(ride);
+    ride->upkeep_cost = ride_compute_upkeep(ride, state);
     ride->window_invalidate_flags |= RIDE_INVALIDATE_RIDE_INCOME;
 
     ride->sheltered_eighths = get_num_of_sheltered_eighths(ride).TotalShelteredEighths;
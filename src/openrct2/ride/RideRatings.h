@@ -12,6 +12,8 @@
 #include "../common.h"
 #include "RideTypes.h"
 
+#include <vector>
+
 using ride_rating = fixed16_2dp;
 
 // Convenience function for writing ride ratings. The result is a 16 bit signed
@@ -59,4 +61,5 @@ struct RideRatingCalculationData
 extern RideRatingCalculationData gRideRatingsCalcData;
 
 void ride_ratings_update_ride(const Ride& ride);
+void ride_ratings_update_rides(const std::vector<ride_id_t>& rideIds);
 void ride_ratings_update_all();
@@ -26,6 +26,7 @@
 #include "TrackDesign.h"
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -127,9 +128,18 @@ private:
 class TrackDesignRepository final : public ITrackDesignRepository
 {
 private:
+    // Range of _items that have a given ride type
+    struct RideTypeBucket
+    {
+        size_t Begin = 0;
+        size_t End = 0;
+    };
+
     std::shared_ptr<IPlatformEnvironment> const _env;
     TrackDesignFileIndex const _fileIndex;
     std::vector<TrackRepositoryItem> _items;
+    // Indexed by the ride type byte of a design, which is not limited to RIDE_TYPE_COUNT
+    std::array<RideTypeBucket, 256> _buckets;
 
 public:
     explicit TrackDesignRepository(const std::shared_ptr<IPlatformEnvironment>& env)
@@ -152,25 +162,10 @@ public:
     size_t GetCountForObjectEntry(uint8_t rideType, const std::string& entry) const override
     {
         size_t count = 0;
-        const auto& repo = GetContext()->GetObjectRepository();
-
-        for (const auto& item : _items)
+        const auto& bucket = _buckets[rideType];
+        for (size_t i = bucket.Begin; i < bucket.End; i++)
         {
-            if (item.RideType != rideType)
-            {
-                continue;
-            }
-
-            bool entryIsNotSeparate = false;
-            if (entry.empty())
-            {
-                const ObjectRepositoryItem* ori = repo.FindObject(item.ObjectEntry.c_str());
-
-                if (ori == nullptr || !RideGroupManager::RideTypeIsIndependent(rideType))
-                    entryIsNotSeparate = true;
-            }
-
-            if (entryIsNotSeparate || String::Equals(item.ObjectEntry, entry, true))
+            if (IsItemForObjectEntry(_items[i], rideType, entry))
             {
                 count++;
             }
@@ -181,25 +176,14 @@ public:
     size_t GetCountForRideGroup(uint8_t rideType, const RideGroup* rideGroup) const override
     {
         size_t count = 0;
-        const auto& repo = GetContext()->GetObjectRepository();
-
-        for (const auto& item : _items)
+        const auto& bucket = _buckets[rideType];
+        for (size_t i = bucket.Begin; i < bucket.End; i++)
         {
-            if (item.RideType != rideType)
-            {
-                continue;
-            }
-
-            const ObjectRepositoryItem* ori = repo.FindObject(item.ObjectEntry.c_str());
-            uint8_t rideGroupIndex = (ori != nullptr) ? ori->RideInfo.RideGroupIndex : 0;
-            const RideGroup* itemRideGroup = RideGroupManager::RideGroupFind(rideType, rideGroupIndex);
-
-            if (itemRideGroup != nullptr && itemRideGroup->Equals(rideGroup))
+            if (IsItemForRideGroup(_items[i], rideGroup))
             {
                 count++;
             }
         }
-
         return count;
     }
 
@@ -211,61 +195,28 @@ public:
     std::vector<track_design_file_ref> GetItemsForObjectEntry(uint8_t rideType, const std::string& entry) const override
     {
         std::vector<track_design_file_ref> refs;
-        const auto& repo = GetContext()->GetObjectRepository();
-
-        for (const auto& item : _items)
+        const auto& bucket = _buckets[rideType];
+        for (size_t i = bucket.Begin; i < bucket.End; i++)
         {
-            if (item.RideType != rideType)
+            if (IsItemForObjectEntry(_items[i], rideType, entry))
             {
-                continue;
-            }
-
-            bool entryIsNotSeparate = false;
-            if (entry.empty())
-            {
-                const ObjectRepositoryItem* ori = repo.FindObject(item.ObjectEntry.c_str());
-
-                if (ori == nullptr || !RideGroupManager::RideTypeIsIndependent(rideType))
-                    entryIsNotSeparate = true;
-            }
-
-            if (entryIsNotSeparate || String::Equals(item.ObjectEntry, entry, true))
-            {
-                track_design_file_ref ref;
-                ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
-                ref.path = String::Duplicate(item.Path);
-                refs.push_back(ref);
+                refs.push_back(CreateFileRef(_items[i]));
             }
         }
-
         return refs;
     }
 
     std::vector<track_design_file_ref> GetItemsForRideGroup(uint8_t rideType, const RideGroup* rideGroup) const override
     {
         std::vector<track_design_file_ref> refs;
-        const auto& repo = GetContext()->GetObjectRepository();
-
-        for (const auto& item : _items)
+        const auto& bucket = _buckets[rideType];
+        for (size_t i = bucket.Begin; i < bucket.End; i++)
         {
-            if (item.RideType != rideType)
+            if (IsItemForRideGroup(_items[i], rideGroup))
             {
-                continue;
-            }
-
-            const ObjectRepositoryItem* ori = repo.FindObject(item.ObjectEntry.c_str());
-            uint8_t rideGroupIndex = (ori != nullptr) ? ori->RideInfo.RideGroupIndex : 0;
-            const RideGroup* itemRideGroup = RideGroupManager::RideGroupFind(rideType, rideGroupIndex);
-
-            if (itemRideGroup != nullptr && itemRideGroup->Equals(rideGroup))
-            {
-                track_design_file_ref ref;
-                ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
-                ref.path = String::Duplicate(item.Path);
-                refs.push_back(ref);
+                refs.push_back(CreateFileRef(_items[i]));
             }
         }
-
         return refs;
     }
 
@@ -293,6 +244,7 @@ public:
                 if (File::Delete(path))
                 {
                     _items.erase(_items.begin() + index);
+                    UpdateBuckets();
                     result = true;
                 }
             }
@@ -354,6 +306,56 @@ private:
             }
             return String::Compare(a.Name, b.Name) < 0;
         });
+        UpdateBuckets();
+    }
+
+    /**
+     * Records the range of items of each ride type, so that queries only visit the designs of the requested ride type.
+     * Items must be sorted by ride type.
+     */
+    void UpdateBuckets()
+    {
+        _buckets.fill({});
+        for (size_t i = 0; i < _items.size(); i++)
+        {
+            auto& bucket = _buckets[_items[i].RideType];
+            if (bucket.Begin == bucket.End)
+            {
+                bucket.Begin = i;
+            }
+            bucket.End = i + 1;
+        }
+    }
+
+    static bool IsItemForObjectEntry(const TrackRepositoryItem& item, uint8_t rideType, const std::string& entry)
+    {
+        if (entry.empty())
+        {
+            const auto& repo = GetContext()->GetObjectRepository();
+            const ObjectRepositoryItem* ori = repo.FindObject(item.ObjectEntry.c_str());
+            if (ori == nullptr || !RideGroupManager::RideTypeIsIndependent(rideType))
+            {
+                return true;
+            }
+        }
+        return String::Equals(item.ObjectEntry, entry, true);
+    }
+
+    static bool IsItemForRideGroup(const TrackRepositoryItem& item, const RideGroup* rideGroup)
+    {
+        const auto& repo = GetContext()->GetObjectRepository();
+        const ObjectRepositoryItem* ori = repo.FindObject(item.ObjectEntry.c_str());
+        uint8_t rideGroupIndex = (ori != nullptr) ? ori->RideInfo.RideGroupIndex : 0;
+        const RideGroup* itemRideGroup = RideGroupManager::RideGroupFind(item.RideType, rideGroupIndex);
+        return itemRideGroup != nullptr && itemRideGroup->Equals(rideGroup);
+    }
+
+    static track_design_file_ref CreateFileRef(const TrackRepositoryItem& item)
+    {
+        track_design_file_ref ref;
+        ref.name = String::Duplicate(GetNameFromTrackPath(item.Path));
+        ref.path = String::Duplicate(item.Path);
+        return ref;
     }
 
     size_t GetTrackIndex(const std::string& path) const
@@ -27,6 +27,8 @@
 #include "TrackData.h"
 #include "TrackDesign.h"
 
+#include <array>
+
 // clang-format off
 /* rct2: 0x007667AC */
 static constexpr TileCoordsXY EntranceOffsetEdgeNE[] = {
@@ -2147,6 +2149,56 @@ void track_paint_util_left_corkscrew_up_supports(paint_session* session, uint8_t
     }
 }
 
+/**
+ * The paint function of every track type for every ride type, looked up once through the ride type getters so painting
+ * a track element does not have to go through a getter's switch each time.
+ *
+ * The table cannot be built at compile time: the paint functions are static in the translation unit of their ride type
+ * and only reachable through its getter, which is defined there too. Making the getters constexpr would mean moving
+ * thousands of paint functions into headers. The table is filled during static initialisation instead, from
+ * RideTypeTrackPaintFunctions, which is itself constant initialised.
+ */
+class TrackPaintFunctionTable
+{
+private:
+    static constexpr size_t TRACK_TYPE_COUNT = 256;
+
+    std::array<std::array<TRACK_PAINT_FUNCTION, TRACK_TYPE_COUNT>, RIDE_TYPE_COUNT> _functions{};
+
+public:
+    TrackPaintFunctionTable()
+    {
+        for (size_t rideType = 0; rideType < RIDE_TYPE_COUNT; rideType++)
+        {
+            auto paintFunctionGetter = RideTypeTrackPaintFunctions[rideType];
+            if (paintFunctionGetter != nullptr)
+            {
+                for (size_t trackType = 0; trackType < TRACK_TYPE_COUNT; trackType++)
+                {
+                    // The getters only pass the direction on to each other, none of them picks a function by it
+                    _functions[rideType][trackType] = paintFunctionGetter((int32_t)trackType, 0);
+                }
+            }
+        }
+    }
+
+    TRACK_PAINT_FUNCTION Get(uint8_t rideType, uint8_t trackType) const
+    {
+        if (rideType >= RIDE_TYPE_COUNT)
+        {
+            return nullptr;
+        }
+        return _functions[rideType][trackType];
+    }
+};
+
+static const TrackPaintFunctionTable _trackPaintFunctionTable;
+
+TRACK_PAINT_FUNCTION track_paint_get_function(uint8_t rideType, uint8_t trackType)
+{
+    return _trackPaintFunctionTable.Get(rideType, trackType);
+}
+
 /**
  *
  *  rct2: 0x006C4794
@@ -2206,14 +2258,10 @@ void track_paint(paint_session* session, uint8_t direction, int32_t height, cons
             session->TrackColours[SCHEME_3] = ghost_id;
         }
 
-        TRACK_PAINT_FUNCTION_GETTER paintFunctionGetter = RideTypeTrackPaintFunctions[ride->type];
-        if (paintFunctionGetter != nullptr)
+        TRACK_PAINT_FUNCTION paintFunction = track_paint_get_function(ride->type, trackType);
+        if (paintFunction != nullptr)
         {
-            TRACK_PAINT_FUNCTION paintFunction = paintFunctionGetter(trackType, direction);
-            if (paintFunction != nullptr)
-            {
-                paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
-            }
+            paintFunction(session, rideIndex, trackSequence, direction, height, tileElement);
         }
     }
 }
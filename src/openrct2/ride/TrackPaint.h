@@ -395,6 +395,11 @@ using TRACK_PAINT_FUNCTION = void (*)(
     const TileElement* tileElement);
 using TRACK_PAINT_FUNCTION_GETTER = TRACK_PAINT_FUNCTION (*)(int32_t trackType, int32_t direction);
 
+/**
+ * Gets the paint function for a track type of a ride type from a table filled once from RideTypeTrackPaintFunctions.
+ */
+TRACK_PAINT_FUNCTION track_paint_get_function(uint8_t rideType, uint8_t trackType);
+
 TRACK_PAINT_FUNCTION get_track_paint_function_stand_up_rc(int32_t trackType, int32_t direction);
 TRACK_PAINT_FUNCTION get_track_paint_function_suspended_swinging_rc(int32_t trackType, int32_t direction);
 TRACK_PAINT_FUNCTION get_track_paint_function_inverted_rc(int32_t trackType, int32_t direction);
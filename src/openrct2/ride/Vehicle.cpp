@@ -42,9 +42,11 @@
 #include "VehicleData.h"
 
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <unordered_map>
+#include <vector>
 
-static void vehicle_update(rct_vehicle* vehicle);
 static void vehicle_update_crossings(const rct_vehicle* vehicle);
 static void vehicle_claxon(const rct_vehicle* vehicle);
 
@@ -764,73 +766,93 @@ static const struct
 
 // clang-format on
 
-static bool vehicle_move_info_valid(int32_t cd, int32_t typeAndDirection, int32_t offset)
+// Number of track type and direction combinations in each of the gTrackVehicleInfo lists
+static constexpr const uint16_t VehicleMoveInfoListCounts[] = {
+    1024, 692, 404, 404, 404, 208, 208, 208, 208, 824, 824, 824, 824, 824, 824, 868, 868,
+};
+static_assert(std::size(VehicleMoveInfoListCounts) == std::size(gTrackVehicleInfo));
+
+static constexpr const rct_vehicle_info VehicleMoveInfoZero = {};
+
+/**
+ * The move info of every vehicle subposition, track type and direction copied into one array when the game starts, so
+ * looking up a position is a single index into it rather than going through three levels of pointers. Lists shared by
+ * several track types are only copied once.
+ */
+class VehicleMoveInfoTable
 {
-    if (cd >= static_cast<int32_t>(std::size(gTrackVehicleInfo)))
-    {
-        return false;
-    }
-    int32_t size = 0;
-    switch (cd)
+private:
+    std::vector<rct_vehicle_info> _infos;
+    std::vector<VehicleMoveInfoList> _lists;
+    std::array<size_t, std::size(gTrackVehicleInfo)> _firstList{};
+
+public:
+    VehicleMoveInfoTable()
     {
-        case 0:
-            size = 1024;
-            break;
-        case 1:
-            size = 692;
-            break;
-        case 2:
-        case 3:
-        case 4:
-            size = 404;
-            break;
-        case 5:
-        case 6:
-        case 7:
-        case 8:
-            size = 208;
-            break;
-        case 9:
-        case 10:
-        case 11:
-        case 12:
-        case 13:
-        case 14:
-            size = 824;
-            break;
-        case 15:
-        case 16:
-            size = 868;
-            break;
+        std::unordered_map<const rct_vehicle_info_list*, size_t> infoOffsets;
+        std::vector<size_t> listOffsets;
+        for (size_t cd = 0; cd < std::size(gTrackVehicleInfo); cd++)
+        {
+            _firstList[cd] = listOffsets.size();
+            for (size_t i = 0; i < VehicleMoveInfoListCounts[cd]; i++)
+            {
+                auto list = gTrackVehicleInfo[cd][i];
+                auto result = infoOffsets.emplace(list, _infos.size());
+                if (result.second)
+                {
+                    _infos.insert(_infos.end(), list->info, list->info + list->size);
+                }
+                listOffsets.push_back(result.first->second);
+            }
+        }
+
+        // Only take pointers once the array is complete
+        _lists.reserve(listOffsets.size());
+        for (size_t cd = 0; cd < std::size(gTrackVehicleInfo); cd++)
+        {
+            for (size_t i = 0; i < VehicleMoveInfoListCounts[cd]; i++)
+            {
+                auto list = gTrackVehicleInfo[cd][i];
+                _lists.push_back({ _infos.data() + listOffsets[_firstList[cd] + i], list->size });
+            }
+        }
     }
-    if (typeAndDirection >= size)
+
+    VehicleMoveInfoList GetList(int32_t cd, int32_t typeAndDirection) const
     {
-        return false;
+        if (static_cast<uint32_t>(cd) >= std::size(gTrackVehicleInfo)
+            || static_cast<uint32_t>(typeAndDirection) >= VehicleMoveInfoListCounts[cd])
+        {
+            return {};
+        }
+        return _lists[_firstList[cd] + typeAndDirection];
     }
-    if (offset >= gTrackVehicleInfo[cd][typeAndDirection]->size)
+};
+
+static const VehicleMoveInfoTable _vehicleMoveInfoTable;
+
+const rct_vehicle_info* VehicleMoveInfoList::Get(int32_t offset) const
+{
+    if (static_cast<uint32_t>(offset) >= Size)
     {
-        return false;
+        return &VehicleMoveInfoZero;
     }
-    return true;
+    return &Infos[offset];
+}
+
+VehicleMoveInfoList vehicle_get_move_info_list(int32_t cd, int32_t typeAndDirection)
+{
+    return _vehicleMoveInfoTable.GetList(cd, typeAndDirection);
 }
 
 const rct_vehicle_info* vehicle_get_move_info(int32_t cd, int32_t typeAndDirection, int32_t offset)
 {
-    if (!vehicle_move_info_valid(cd, typeAndDirection, offset))
-    {
-        static constexpr const rct_vehicle_info zero = {};
-        return &zero;
-    }
-    return &gTrackVehicleInfo[cd][typeAndDirection]->info[offset];
+    return _vehicleMoveInfoTable.GetList(cd, typeAndDirection).Get(offset);
 }
 
 uint16_t vehicle_get_move_info_size(int32_t cd, int32_t typeAndDirection)
 {
-    if (!vehicle_move_info_valid(cd, typeAndDirection, 0))
-    {
-        return 0;
-    }
-    return gTrackVehicleInfo[cd][typeAndDirection]->size;
+    return _vehicleMoveInfoTable.GetList(cd, typeAndDirection).Size;
 }
 
 rct_vehicle* try_get_vehicle(uint16_t spriteIndex)
@@ -1343,13 +1365,21 @@ void vehicle_update_all()
     if ((gScreenFlags & SCREEN_FLAGS_TRACK_DESIGNER) && gS6Info.editor_step != EDITOR_STEP_ROLLERCOASTER_DESIGNER)
         return;
 
+    // The trains of a ride usually follow each other in the list, so the ride is only looked up when it changes
+    ride_id_t rideIndex = RIDE_ID_NULL;
+    Ride* ride = nullptr;
     sprite_index = gSpriteListHead[SPRITE_LIST_VEHICLE_HEAD];
     while (sprite_index != SPRITE_INDEX_NULL)
     {
         vehicle = GET_VEHICLE(sprite_index);
         sprite_index = vehicle->next;
 
-        vehicle_update(vehicle);
+        if (ride == nullptr || vehicle->ride != rideIndex)
+        {
+            rideIndex = vehicle->ride;
+            ride = get_ride(rideIndex);
+        }
+        vehicle_update(vehicle, ride);
     }
 }
 
@@ -1939,7 +1969,7 @@ static SoundIdVolume sub_6D7AC0(SoundId currentSoundId, uint8_t currentVolume, S
  *
  *  rct2: 0x006D77F2
  */
-static void vehicle_update(rct_vehicle* vehicle)
+void vehicle_update(rct_vehicle* vehicle, Ride* ride)
 {
     // The cable lift uses the ride type of NULL
     if (vehicle->ride_subtype == RIDE_TYPE_NULL)
@@ -1952,7 +1982,6 @@ static void vehicle_update(rct_vehicle* vehicle)
     if (rideEntry == nullptr)
         return;
 
-    auto ride = get_ride(vehicle->ride);
     if (ride == nullptr)
         return;
 
@@ -6432,18 +6461,15 @@ bool vehicle_update_dodgems_collision(rct_vehicle* vehicle, int16_t x, int16_t y
     {
         location += xy_offset;
 
-        uint16_t spriteIdx = sprite_get_first_in_quadrant(location.x * 32, location.y * 32);
+        uint16_t spriteIdx = sprite_get_first_vehicle_in_quadrant(location.x * 32, location.y * 32);
         while (spriteIdx != SPRITE_INDEX_NULL)
         {
             rct_vehicle* vehicle2 = GET_VEHICLE(spriteIdx);
-            spriteIdx = vehicle2->next_in_quadrant;
+            spriteIdx = sprite_get_next_vehicle_in_quadrant(spriteIdx);
 
             if (vehicle2 == vehicle)
                 continue;
 
-            if (vehicle2->sprite_identifier != SPRITE_IDENTIFIER_VEHICLE)
-                continue;
-
             if (vehicle2->ride != rideIndex)
                 continue;
 
@@ -7665,16 +7691,13 @@ static bool vehicle_update_motion_collision_detection(
     {
         location += xy_offset;
 
-        collideId = sprite_get_first_in_quadrant(location.x * 32, location.y * 32);
-        for (; collideId != SPRITE_INDEX_NULL; collideId = collideVehicle->next_in_quadrant)
+        collideId = sprite_get_first_vehicle_in_quadrant(location.x * 32, location.y * 32);
+        for (; collideId != SPRITE_INDEX_NULL; collideId = sprite_get_next_vehicle_in_quadrant(collideId))
         {
             collideVehicle = GET_VEHICLE(collideId);
             if (collideVehicle == vehicle)
                 continue;
 
-            if (collideVehicle->sprite_identifier != SPRITE_IDENTIFIER_VEHICLE)
-                continue;
-
             int32_t z_diff = abs(collideVehicle->z - z);
 
             if (z_diff > 16)
@@ -8213,11 +8236,8 @@ loc_6DAEB9:
 
     regs.ax = vehicle->track_progress + 1;
 
-    const rct_vehicle_info* moveInfo = vehicle_get_move_info(vehicle->var_CD, vehicle->track_type, 0);
-
-    // Track Total Progress is in the two bytes before the move info list
-    uint16_t trackTotalProgress = vehicle_get_move_info_size(vehicle->var_CD, vehicle->track_type);
-    if (regs.ax >= trackTotalProgress)
+    auto moveInfoList = vehicle_get_move_info_list(vehicle->var_CD, vehicle->track_type);
+    if (regs.ax >= moveInfoList.Size)
     {
         vehicle_update_crossings(vehicle);
 
@@ -8228,6 +8248,7 @@ loc_6DAEB9:
             vehicle->remaining_distance = -1;
             return false;
         }
+        moveInfoList = vehicle_get_move_info_list(vehicle->var_CD, vehicle->track_type);
         regs.ax = 0;
     }
 
@@ -8235,7 +8256,7 @@ loc_6DAEB9:
     vehicle_update_handle_water_splash(vehicle);
 
     // loc_6DB706
-    moveInfo = vehicle_get_move_info(vehicle->var_CD, vehicle->track_type, vehicle->track_progress);
+    const rct_vehicle_info* moveInfo = moveInfoList.Get(vehicle->track_progress);
     trackType = vehicle->track_type >> 2;
     {
         int16_t x = vehicle->track_x + moveInfo->x;
@@ -293,6 +293,20 @@ struct rct_vehicle_info
     uint8_t bank_rotation;       // 0x08
 };
 
+/**
+ * The positions a vehicle moves through along one track piece, the entry for each track progress.
+ */
+struct VehicleMoveInfoList
+{
+    const rct_vehicle_info* Infos = nullptr;
+    uint16_t Size = 0;
+
+    /**
+     * Gets the entry for the given track progress, or an all zero entry if it is out of range.
+     */
+    const rct_vehicle_info* Get(int32_t offset) const;
+};
+
 enum : uint32_t
 {
     VEHICLE_ENTRY_FLAG_POWERED_RIDE_UNRESTRICTED_GRAVITY = 1
@@ -468,6 +482,7 @@ struct GForces
 
 rct_vehicle* try_get_vehicle(uint16_t spriteIndex);
 void vehicle_update_all();
+void vehicle_update(rct_vehicle* vehicle, Ride* ride);
 void vehicle_sounds_update();
 GForces vehicle_get_g_forces(const rct_vehicle* vehicle);
 void vehicle_set_map_toolbar(const rct_vehicle* vehicle);
@@ -483,6 +498,7 @@ rct_vehicle* vehicle_get_head(const rct_vehicle* vehicle);
 rct_vehicle* vehicle_get_tail(const rct_vehicle* vehicle);
 const rct_vehicle_info* vehicle_get_move_info(int32_t cd, int32_t typeAndDirection, int32_t offset);
 uint16_t vehicle_get_move_info_size(int32_t cd, int32_t typeAndDirection);
+VehicleMoveInfoList vehicle_get_move_info_list(int32_t cd, int32_t typeAndDirection);
 bool vehicle_update_dodgems_collision(rct_vehicle* vehicle, int16_t x, int16_t y, uint16_t* spriteId);
 
 extern rct_vehicle* gCurrentVehicle;
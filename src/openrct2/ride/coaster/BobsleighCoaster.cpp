@@ -19,59 +19,74 @@
 #include "../TrackData.h"
 #include "../TrackPaint.h"
 
+/**
+ * Sprites of a straight piece for each direction, the track and its side rail, without and with a chain lift. The side
+ * rail's bounding box height and the supports' special value depend on the slope of the piece.
+ */
+struct bobsleigh_rc_straight_piece
+{
+    uint32_t sprites[2][4][2];
+    int8_t rail_bound_box_height;
+    uint8_t supports_special;
+};
+
+// clang-format off
+static constexpr const bobsleigh_rc_straight_piece bobsleigh_rc_track_pieces_flat = {
+    {
+        { { 14572, 14574 }, { 14573, 14575 }, { 14572, 14574 }, { 14573, 14575 } },
+        { { 14576, 14578 }, { 14577, 14579 }, { 14576, 14578 }, { 14577, 14579 } },
+    },
+    26, 0,
+};
+
+static constexpr const bobsleigh_rc_straight_piece bobsleigh_rc_track_pieces_25_deg_up = {
+    {
+        { { 14610, 14614 }, { 14611, 14615 }, { 14612, 14616 }, { 14613, 14617 } },
+        { { 14634, 14638 }, { 14635, 14639 }, { 14636, 14640 }, { 14637, 14641 } },
+    },
+    50, 8,
+};
+
+static constexpr const bobsleigh_rc_straight_piece bobsleigh_rc_track_pieces_flat_to_25_deg_up = {
+    {
+        { { 14594, 14598 }, { 14595, 14599 }, { 14596, 14600 }, { 14597, 14601 } },
+        { { 14618, 14622 }, { 14619, 14623 }, { 14620, 14624 }, { 14621, 14625 } },
+    },
+    42, 3,
+};
+
+static constexpr const bobsleigh_rc_straight_piece bobsleigh_rc_track_pieces_25_deg_up_to_flat = {
+    {
+        { { 14602, 14606 }, { 14603, 14607 }, { 14604, 14608 }, { 14605, 14609 } },
+        { { 14626, 14630 }, { 14627, 14631 }, { 14628, 14632 }, { 14629, 14633 } },
+    },
+    34, 6,
+};
+// clang-format on
+
+static void bobsleigh_rc_track_straight(
+    paint_session* session, uint8_t direction, int32_t height, const TileElement* tileElement,
+    const bobsleigh_rc_straight_piece& piece)
+{
+    const auto& sprites = piece.sprites[tileElement->AsTrack()->HasChain() ? 1 : 0][direction];
+    sub_98197C_rotated(
+        session, direction, session->TrackColours[SCHEME_TRACK] | sprites[0], 0, 0, 32, 20, 2, height, 0, 6, height);
+    sub_98197C_rotated(
+        session, direction, session->TrackColours[SCHEME_TRACK] | sprites[1], 0, 0, 32, 1, piece.rail_bound_box_height,
+        height, 0, 27, height);
+    if (track_paint_util_should_paint_supports(session->MapPosition))
+    {
+        metal_a_supports_paint_setup(
+            session, METAL_SUPPORTS_TUBES, 4, piece.supports_special, height, session->TrackColours[SCHEME_SUPPORTS]);
+    }
+}
+
 /** rct2: 0x006FE5B4 */
 static void bobsleigh_rc_track_flat(
     paint_session* session, ride_id_t rideIndex, uint8_t trackSequence, uint8_t direction, int32_t height,
     const TileElement* tileElement)
 {
-    if (tileElement->AsTrack()->HasChain())
-    {
-        switch (direction)
-        {
-            case 0:
-            case 2:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14576, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14578, 0, 0, 32, 1, 26, height, 0, 27, height);
-                break;
-            case 1:
-            case 3:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14577, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14579, 0, 0, 32, 1, 26, height, 0, 27, height);
-                break;
-        }
-        if (track_paint_util_should_paint_supports(session->MapPosition))
-        {
-            metal_a_supports_paint_setup(session, METAL_SUPPORTS_TUBES, 4, 0, height, session->TrackColours[SCHEME_SUPPORTS]);
-        }
-    }
-    else
-    {
-        switch (direction)
-        {
-            case 0:
-            case 2:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14572, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14574, 0, 0, 32, 1, 26, height, 0, 27, height);
-                break;
-            case 1:
-            case 3:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14573, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14575, 0, 0, 32, 1, 26, height, 0, 27, height);
-                break;
-        }
-        if (track_paint_util_should_paint_supports(session->MapPosition))
-        {
-            metal_a_supports_paint_setup(session, METAL_SUPPORTS_TUBES, 4, 0, height, session->TrackColours[SCHEME_SUPPORTS]);
-        }
-    }
+    bobsleigh_rc_track_straight(session, direction, height, tileElement, bobsleigh_rc_track_pieces_flat);
     paint_util_push_tunnel_rotated(session, direction, height, TUNNEL_0);
     paint_util_set_segment_support_height(
         session, paint_util_rotate_segments(SEGMENT_C4 | SEGMENT_CC | SEGMENT_D0, direction), 0xFFFF, 0);
@@ -106,74 +121,7 @@ static void bobsleigh_rc_track_25_deg_up(
     paint_session* session, ride_id_t rideIndex, uint8_t trackSequence, uint8_t direction, int32_t height,
     const TileElement* tileElement)
 {
-    if (tileElement->AsTrack()->HasChain())
-    {
-        switch (direction)
-        {
-            case 0:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14634, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14638, 0, 0, 32, 1, 50, height, 0, 27, height);
-                break;
-            case 1:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14635, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14639, 0, 0, 32, 1, 50, height, 0, 27, height);
-                break;
-            case 2:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14636, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14640, 0, 0, 32, 1, 50, height, 0, 27, height);
-                break;
-            case 3:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14637, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14641, 0, 0, 32, 1, 50, height, 0, 27, height);
-                break;
-        }
-        if (track_paint_util_should_paint_supports(session->MapPosition))
-        {
-            metal_a_supports_paint_setup(session, METAL_SUPPORTS_TUBES, 4, 8, height, session->TrackColours[SCHEME_SUPPORTS]);
-        }
-    }
-    else
-    {
-        switch (direction)
-        {
-            case 0:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14610, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14614, 0, 0, 32, 1, 50, height, 0, 27, height);
-                break;
-            case 1:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14611, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14615, 0, 0, 32, 1, 50, height, 0, 27, height);
-                break;
-            case 2:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14612, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14616, 0, 0, 32, 1, 50, height, 0, 27, height);
-                break;
-            case 3:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14613, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14617, 0, 0, 32, 1, 50, height, 0, 27, height);
-                break;
-        }
-        if (track_paint_util_should_paint_supports(session->MapPosition))
-        {
-            metal_a_supports_paint_setup(session, METAL_SUPPORTS_TUBES, 4, 8, height, session->TrackColours[SCHEME_SUPPORTS]);
-        }
-    }
+    bobsleigh_rc_track_straight(session, direction, height, tileElement, bobsleigh_rc_track_pieces_25_deg_up);
     if (direction == 0 || direction == 3)
     {
         paint_util_push_tunnel_rotated(session, direction, height - 8, TUNNEL_1);
@@ -192,74 +140,7 @@ static void bobsleigh_rc_track_flat_to_25_deg_up(
     paint_session* session, ride_id_t rideIndex, uint8_t trackSequence, uint8_t direction, int32_t height,
     const TileElement* tileElement)
 {
-    if (tileElement->AsTrack()->HasChain())
-    {
-        switch (direction)
-        {
-            case 0:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14618, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14622, 0, 0, 32, 1, 42, height, 0, 27, height);
-                break;
-            case 1:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14619, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14623, 0, 0, 32, 1, 42, height, 0, 27, height);
-                break;
-            case 2:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14620, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14624, 0, 0, 32, 1, 42, height, 0, 27, height);
-                break;
-            case 3:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14621, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14625, 0, 0, 32, 1, 42, height, 0, 27, height);
-                break;
-        }
-        if (track_paint_util_should_paint_supports(session->MapPosition))
-        {
-            metal_a_supports_paint_setup(session, METAL_SUPPORTS_TUBES, 4, 3, height, session->TrackColours[SCHEME_SUPPORTS]);
-        }
-    }
-    else
-    {
-        switch (direction)
-        {
-            case 0:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14594, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14598, 0, 0, 32, 1, 42, height, 0, 27, height);
-                break;
-            case 1:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14595, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14599, 0, 0, 32, 1, 42, height, 0, 27, height);
-                break;
-            case 2:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14596, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14600, 0, 0, 32, 1, 42, height, 0, 27, height);
-                break;
-            case 3:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14597, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14601, 0, 0, 32, 1, 42, height, 0, 27, height);
-                break;
-        }
-        if (track_paint_util_should_paint_supports(session->MapPosition))
-        {
-            metal_a_supports_paint_setup(session, METAL_SUPPORTS_TUBES, 4, 3, height, session->TrackColours[SCHEME_SUPPORTS]);
-        }
-    }
+    bobsleigh_rc_track_straight(session, direction, height, tileElement, bobsleigh_rc_track_pieces_flat_to_25_deg_up);
     if (direction == 0 || direction == 3)
     {
         paint_util_push_tunnel_rotated(session, direction, height, TUNNEL_0);
@@ -278,74 +159,7 @@ static void bobsleigh_rc_track_25_deg_up_to_flat(
     paint_session* session, ride_id_t rideIndex, uint8_t trackSequence, uint8_t direction, int32_t height,
     const TileElement* tileElement)
 {
-    if (tileElement->AsTrack()->HasChain())
-    {
-        switch (direction)
-        {
-            case 0:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14626, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14630, 0, 0, 32, 1, 34, height, 0, 27, height);
-                break;
-            case 1:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14627, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14631, 0, 0, 32, 1, 34, height, 0, 27, height);
-                break;
-            case 2:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14628, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14632, 0, 0, 32, 1, 34, height, 0, 27, height);
-                break;
-            case 3:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14629, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14633, 0, 0, 32, 1, 34, height, 0, 27, height);
-                break;
-        }
-        if (track_paint_util_should_paint_supports(session->MapPosition))
-        {
-            metal_a_supports_paint_setup(session, METAL_SUPPORTS_TUBES, 4, 6, height, session->TrackColours[SCHEME_SUPPORTS]);
-        }
-    }
-    else
-    {
-        switch (direction)
-        {
-            case 0:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14602, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14606, 0, 0, 32, 1, 34, height, 0, 27, height);
-                break;
-            case 1:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14603, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14607, 0, 0, 32, 1, 34, height, 0, 27, height);
-                break;
-            case 2:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14604, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14608, 0, 0, 32, 1, 34, height, 0, 27, height);
-                break;
-            case 3:
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14605, 0, 0, 32, 20, 2, height, 0, 6, height);
-                sub_98197C_rotated(
-                    session, direction, session->TrackColours[SCHEME_TRACK] | 14609, 0, 0, 32, 1, 34, height, 0, 27, height);
-                break;
-        }
-        if (track_paint_util_should_paint_supports(session->MapPosition))
-        {
-            metal_a_supports_paint_setup(session, METAL_SUPPORTS_TUBES, 4, 6, height, session->TrackColours[SCHEME_SUPPORTS]);
-        }
-    }
+    bobsleigh_rc_track_straight(session, direction, height, tileElement, bobsleigh_rc_track_pieces_25_deg_up_to_flat);
     if (direction == 0 || direction == 3)
     {
         paint_util_push_tunnel_rotated(session, direction, height - 8, TUNNEL_0);
@@ -0,0 +1,452 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "ParkMetadataRepository.h"
+
+#include "../Context.h"
+#include "../FileClassifier.h"
+#include "../PlatformEnvironment.h"
+#include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileStream.hpp"
+#include "../core/JobPool.hpp"
+#include "../core/MemoryStream.h"
+#include "../core/String.hpp"
+#include "../localisation/Language.h"
+#include "../localisation/Localisation.h"
+#include "../rct1/RCT1.h"
+#include "../rct12/RCT12.h"
+#include "../rct12/SawyerChunkReader.h"
+#include "../rct12/SawyerEncoding.h"
+#include "../util/SawyerCoding.h"
+#include "Scenario.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace OpenRCT2;
+
+// Offsets of the members of rct_s6_data that are read from the saved game chunk, relative to the start of that
+// chunk (next_free_tile_element_pointer_index). rct_s6_data is packed plain data, it is only not standard layout
+// because some RCT12 element types mix private and public members.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+constexpr size_t S6_CHUNK_START = offsetof(rct_s6_data, next_free_tile_element_pointer_index);
+constexpr size_t S6_CHUNK_PARK_NAME = offsetof(rct_s6_data, park_name) - S6_CHUNK_START;
+constexpr size_t S6_CHUNK_GUESTS_IN_PARK = offsetof(rct_s6_data, guests_in_park) - S6_CHUNK_START;
+constexpr size_t S6_CHUNK_PARK_VALUE = offsetof(rct_s6_data, park_value) - S6_CHUNK_START;
+constexpr size_t S6_CHUNK_SCENARIO_NAME = offsetof(rct_s6_data, scenario_name) - S6_CHUNK_START;
+constexpr size_t S6_CHUNK_SCENARIO_NAME_LENGTH = sizeof(rct_s6_data::scenario_name);
+constexpr size_t S6_CHUNK_CUSTOM_STRINGS = offsetof(rct_s6_data, custom_strings) - S6_CHUNK_START;
+constexpr size_t S6_CHUNK_CUSTOM_STRINGS_END = S6_CHUNK_CUSTOM_STRINGS + sizeof(rct_s6_data::custom_strings);
+#pragma GCC diagnostic pop
+
+/**
+ * A decoded range of a chunk, so that members can be read without decoding the whole chunk they are in.
+ */
+class S6DataRange final
+{
+private:
+    size_t const _start;
+    std::vector<uint8_t> _data;
+
+public:
+    S6DataRange(size_t start, size_t end)
+        : _start(start)
+        , _data(end - start)
+    {
+    }
+
+    void Read(SawyerChunkReader& chunkReader)
+    {
+        chunkReader.ReadChunkPartial(_data.data(), _start, _data.size());
+    }
+
+    template<typename T> T Get(size_t offset) const
+    {
+        T value;
+        std::memcpy(&value, &_data[offset - _start], sizeof(T));
+        return value;
+    }
+
+    std::string_view GetString(size_t offset, size_t maxLength) const
+    {
+        auto str = (const char*)&_data[offset - _start];
+        return std::string_view(str, strnlen(str, maxLength));
+    }
+};
+
+class ParkMetadataRepository final : public IParkMetadataRepository
+{
+private:
+    struct CacheHeader
+    {
+        uint32_t HeaderSize = sizeof(CacheHeader);
+        uint32_t MagicNumber = MAGIC_NUMBER;
+        uint16_t Version = VERSION;
+        uint16_t Padding = 0;
+        uint32_t NumEntries = 0;
+    };
+
+    static constexpr uint32_t MAGIC_NUMBER = 0x58444D50; // PMDX
+    static constexpr uint16_t VERSION = 1;
+
+    // Files per task when reading files in parallel
+    static constexpr size_t STEP_SIZE = 32;
+
+    // Maximum number of entries kept in the cache file
+    static constexpr size_t MAX_CACHE_ENTRIES = 16384;
+
+    std::string const _cachePath;
+    std::unordered_map<std::string, ParkMetadata> _cache;
+    bool _cacheLoaded = false;
+    std::unique_ptr<JobPool> _readJobs;
+
+public:
+    explicit ParkMetadataRepository(const std::shared_ptr<IPlatformEnvironment>& env)
+        : _cachePath(env->GetFilePath(PATHID::CACHE_PARKS))
+    {
+    }
+
+    std::vector<ParkMetadata> GetMetadata(const std::vector<std::string>& paths) override
+    {
+        if (!_cacheLoaded)
+        {
+            ReadCacheFile();
+            _cacheLoaded = true;
+        }
+
+        // Take unchanged files from the cache, every other file needs to be read
+        std::vector<ParkMetadata> result(paths.size());
+        std::vector<size_t> toRead;
+        for (size_t i = 0; i < paths.size(); i++)
+        {
+            auto lastModified = File::GetLastModified(paths[i]);
+            auto it = _cache.find(paths[i]);
+            if (it != _cache.end() && it->second.LastModified == lastModified)
+            {
+                result[i] = it->second;
+            }
+            else
+            {
+                result[i].Path = paths[i];
+                result[i].LastModified = lastModified;
+                toRead.push_back(i);
+            }
+        }
+
+        if (!toRead.empty())
+        {
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            if (_readJobs == nullptr)
+            {
+                _readJobs = std::make_unique<JobPool>();
+            }
+            for (size_t rangeStart = 0; rangeStart < toRead.size(); rangeStart += STEP_SIZE)
+            {
+                size_t rangeEnd = std::min(rangeStart + STEP_SIZE, toRead.size());
+                _readJobs->AddTask([&result, &toRead, rangeStart, rangeEnd]() {
+                    for (size_t i = rangeStart; i < rangeEnd; i++)
+                    {
+                        ReadMetadata(result[toRead[i]]);
+                    }
+                });
+            }
+            _readJobs->Join();
+
+            for (auto i : toRead)
+            {
+                _cache[result[i].Path] = result[i];
+            }
+            if (_cache.size() > MAX_CACHE_ENTRIES)
+            {
+                TrimCache(paths);
+            }
+            WriteCacheFile();
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            auto duration = (std::chrono::duration<float, std::milli>)(endTime - startTime);
+            log_verbose("Read metadata of %zu park files in %.2f ms", toRead.size(), duration.count());
+        }
+        return result;
+    }
+
+private:
+    static void ReadMetadata(ParkMetadata& metadata)
+    {
+        try
+        {
+            switch (get_file_extension_type(metadata.Path.c_str()))
+            {
+                case FILE_EXTENSION_SC6:
+                case FILE_EXTENSION_SV6:
+                    ReadS6Metadata(metadata);
+                    break;
+                case FILE_EXTENSION_SC4:
+                case FILE_EXTENSION_SV4:
+                    ReadS4Metadata(metadata);
+                    break;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            log_verbose("Unable to read park metadata of '%s': %s", metadata.Path.c_str(), e.what());
+            metadata.Valid = false;
+        }
+    }
+
+    /**
+     * Reads the metadata from the header chunks of an SV6 or SC6 file. Chunks that are not needed are skipped
+     * over and the large saved game chunk is only decoded as far as the user strings.
+     */
+    static void ReadS6Metadata(ParkMetadata& metadata)
+    {
+        auto fs = FileStream(metadata.Path, FILE_MODE_OPEN);
+        auto chunkReader = SawyerChunkReader(&fs);
+
+        auto header = chunkReader.ReadChunkAs<rct_s6_header>();
+        if (header.type != S6_TYPE_SCENARIO && header.type != S6_TYPE_SAVEDGAME)
+        {
+            return;
+        }
+
+        rct_s6_info info{};
+        if (header.type == S6_TYPE_SCENARIO)
+        {
+            chunkReader.ReadChunk(&info, sizeof(info));
+        }
+        for (uint16_t i = 0; i < header.num_packed_objects; i++)
+        {
+            fs.Seek(sizeof(rct_object_entry), STREAM_SEEK_CURRENT);
+            chunkReader.SkipChunk();
+        }
+
+        // Objects, date and tile elements
+        chunkReader.SkipChunk();
+        uint16_t date[2];
+        chunkReader.ReadChunk(date, sizeof(date));
+        chunkReader.SkipChunk();
+        metadata.ElapsedMonths = date[0];
+        metadata.CurrentDay = date[1];
+
+        if (header.type == S6_TYPE_SCENARIO)
+        {
+            // Scenarios store the remaining state in small chunks, starting with the sprites
+            chunkReader.SkipChunk();
+            chunkReader.ReadChunk(&metadata.NumGuests, sizeof(metadata.NumGuests));
+            for (int32_t i = 0; i < 4; i++)
+            {
+                chunkReader.SkipChunk();
+            }
+            chunkReader.ReadChunk(&metadata.ParkValue, sizeof(metadata.ParkValue));
+
+            // If the name contains a colour code, it might be in UTF-8 already
+            std::string_view name(info.name, strnlen(info.name, sizeof(info.name)));
+            metadata.Name = String::ContainsColourCode(std::string(name))
+                ? std::string(name)
+                : rct2_to_utf8(name, RCT2_LANGUAGE_ID_ENGLISH_UK);
+        }
+        else
+        {
+            S6DataRange range(S6_CHUNK_PARK_NAME, S6_CHUNK_CUSTOM_STRINGS_END);
+            range.Read(chunkReader);
+
+            metadata.NumGuests = range.Get<uint16_t>(S6_CHUNK_GUESTS_IN_PARK);
+            metadata.ParkValue = range.Get<money32>(S6_CHUNK_PARK_VALUE);
+
+            auto parkName = range.Get<rct_string_id>(S6_CHUNK_PARK_NAME);
+            std::string_view name;
+            if (is_user_string_id(parkName))
+            {
+                size_t userStringOffset = S6_CHUNK_CUSTOM_STRINGS
+                    + ((parkName - USER_STRING_START) % RCT12_MAX_USER_STRINGS) * RCT12_USER_STRING_MAX_LENGTH;
+                name = range.GetString(userStringOffset, RCT12_USER_STRING_MAX_LENGTH);
+            }
+            if (name.empty())
+            {
+                name = range.GetString(S6_CHUNK_SCENARIO_NAME, S6_CHUNK_SCENARIO_NAME_LENGTH);
+            }
+            metadata.Name = rct2_to_utf8(RCT12::RemoveFormatCodes(name), RCT2_LANGUAGE_ID_ENGLISH_UK);
+        }
+        metadata.Valid = true;
+    }
+
+    /**
+     * Reads the metadata from an SV4 or SC4 file. These have no chunks, so the park is decoded as far as its
+     * user strings.
+     */
+    static void ReadS4Metadata(ParkMetadata& metadata)
+    {
+        auto fs = FileStream(metadata.Path, FILE_MODE_OPEN);
+        bool isEncrypted = false;
+        if (get_file_extension_type(metadata.Path.c_str()) == FILE_EXTENSION_SC4)
+        {
+            int32_t fileType = SawyerEncoding::DetectRCT1FileType(&fs);
+            isEncrypted = (fileType & FILE_VERSION_MASK) != FILE_VERSION_RCT1;
+        }
+
+        auto s4 = std::make_unique<rct1_s4>();
+        auto chunkReader = SawyerChunkReader(&fs);
+        size_t decodedSize = chunkReader.ReadChunkTrack(s4.get(), sizeof(rct1_s4));
+        if (decodedSize != sizeof(rct1_s4))
+        {
+            throw std::runtime_error("Unable to decode park.");
+        }
+        if (isEncrypted)
+        {
+            sawyercoding_decrypt_sc4((uint8_t*)s4.get(), decodedSize);
+        }
+
+        metadata.ElapsedMonths = s4->month;
+        metadata.CurrentDay = s4->day;
+        metadata.NumGuests = s4->guests_in_park;
+        metadata.ParkValue = s4->park_value;
+
+        std::string_view name;
+        if (is_user_string_id((rct_string_id)s4->park_name_string_index))
+        {
+            auto userString = s4->string_table[(s4->park_name_string_index - USER_STRING_START) % RCT12_MAX_USER_STRINGS];
+            name = std::string_view(userString, strnlen(userString, RCT12_USER_STRING_MAX_LENGTH));
+        }
+        if (name.empty())
+        {
+            name = std::string_view(s4->scenario_name, strnlen(s4->scenario_name, sizeof(s4->scenario_name)));
+        }
+        metadata.Name = rct2_to_utf8(RCT12::RemoveFormatCodes(name), RCT2_LANGUAGE_ID_ENGLISH_UK);
+        metadata.Valid = true;
+    }
+
+    /**
+     * Brings the cache down to MAX_CACHE_ENTRIES entries. Entries of files that no longer exist are dropped first,
+     * then entries of files that were not asked for, then entries of the least recently modified files.
+     */
+    void TrimCache(const std::vector<std::string>& paths)
+    {
+        for (auto it = _cache.begin(); it != _cache.end();)
+        {
+            if (File::Exists(it->first))
+            {
+                ++it;
+            }
+            else
+            {
+                it = _cache.erase(it);
+            }
+        }
+        if (_cache.size() <= MAX_CACHE_ENTRIES)
+        {
+            return;
+        }
+
+        std::unordered_set<std::string> wanted(paths.begin(), paths.end());
+        std::vector<std::pair<bool, decltype(_cache)::iterator>> entries;
+        entries.reserve(_cache.size());
+        for (auto it = _cache.begin(); it != _cache.end(); ++it)
+        {
+            entries.emplace_back(wanted.find(it->first) != wanted.end(), it);
+        }
+        std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+            if (a.first != b.first)
+                return !a.first;
+            return a.second->second.LastModified < b.second->second.LastModified;
+        });
+        size_t numToRemove = _cache.size() - MAX_CACHE_ENTRIES;
+        for (size_t i = 0; i < numToRemove; i++)
+        {
+            _cache.erase(entries[i].second);
+        }
+    }
+
+    void ReadCacheFile()
+    {
+        if (!File::Exists(_cachePath))
+        {
+            return;
+        }
+
+        try
+        {
+            auto data = File::ReadAllBytes(_cachePath);
+            auto ms = MemoryStream(data.data(), data.size());
+            auto header = ms.ReadValue<CacheHeader>();
+            if (header.HeaderSize != sizeof(CacheHeader) || header.MagicNumber != MAGIC_NUMBER || header.Version != VERSION)
+            {
+                return;
+            }
+
+            _cache.reserve(header.NumEntries);
+            for (uint32_t i = 0; i < header.NumEntries; i++)
+            {
+                ParkMetadata metadata;
+                metadata.Path = ms.ReadStdString();
+                metadata.LastModified = ms.ReadValue<uint64_t>();
+                metadata.Valid = ms.ReadValue<uint8_t>() != 0;
+                metadata.Name = ms.ReadStdString();
+                metadata.ElapsedMonths = ms.ReadValue<uint16_t>();
+                metadata.CurrentDay = ms.ReadValue<uint16_t>();
+                metadata.NumGuests = ms.ReadValue<uint16_t>();
+                metadata.ParkValue = ms.ReadValue<money32>();
+                auto path = metadata.Path;
+                _cache.emplace(std::move(path), std::move(metadata));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to load park metadata cache: '%s'.", _cachePath.c_str());
+            Console::Error::WriteLine("%s", e.what());
+            _cache.clear();
+        }
+    }
+
+    void WriteCacheFile() const
+    {
+        try
+        {
+            CacheHeader header;
+            header.NumEntries = (uint32_t)_cache.size();
+
+            auto ms = MemoryStream();
+            ms.WriteValue(header);
+            for (const auto& entry : _cache)
+            {
+                const auto& metadata = entry.second;
+                ms.WriteString(metadata.Path);
+                ms.WriteValue<uint64_t>(metadata.LastModified);
+                ms.WriteValue<uint8_t>(metadata.Valid ? 1 : 0);
+                ms.WriteString(metadata.Name);
+                ms.WriteValue<uint16_t>(metadata.ElapsedMonths);
+                ms.WriteValue<uint16_t>(metadata.CurrentDay);
+                ms.WriteValue<uint16_t>(metadata.NumGuests);
+                ms.WriteValue<money32>(metadata.ParkValue);
+            }
+            File::WriteAllBytes(_cachePath, ms.GetData(), ms.GetLength());
+        }
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to save park metadata cache: '%s'.", _cachePath.c_str());
+            Console::Error::WriteLine("%s", e.what());
+        }
+    }
+};
+
+std::unique_ptr<IParkMetadataRepository> CreateParkMetadataRepository(const std::shared_ptr<IPlatformEnvironment>& env)
+{
+    return std::make_unique<ParkMetadataRepository>(env);
+}
+
+IParkMetadataRepository* GetParkMetadataRepository()
+{
+    return GetContext()->GetParkMetadataRepository();
+}
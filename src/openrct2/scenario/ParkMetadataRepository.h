@@ -0,0 +1,53 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenRCT2
+{
+    interface IPlatformEnvironment;
+}
+
+/**
+ * Details of a saved game or scenario file, as shown in the load / save window.
+ */
+struct ParkMetadata
+{
+    std::string Path;
+    uint64_t LastModified = 0;
+
+    // Set if the details below could be read from the file
+    bool Valid = false;
+    std::string Name;
+    uint16_t ElapsedMonths = 0;
+    uint16_t CurrentDay = 0;
+    uint16_t NumGuests = 0;
+    money32 ParkValue = MONEY32_UNDEFINED;
+};
+
+interface IParkMetadataRepository
+{
+    virtual ~IParkMetadataRepository() = default;
+
+    /**
+     * Gets the metadata of the given park files. Files that are not in the cache, or have been
+     * modified since, are read in parallel and added to it.
+     */
+    virtual std::vector<ParkMetadata> GetMetadata(const std::vector<std::string>& paths) abstract;
+};
+
+std::unique_ptr<IParkMetadataRepository> CreateParkMetadataRepository(
+    const std::shared_ptr<OpenRCT2::IPlatformEnvironment>& env);
+IParkMetadataRepository* GetParkMetadataRepository();
@@ -389,6 +389,8 @@ extern char gScenarioExpansionPacks[3256];
 extern bool gFirstTimeSaving;
 extern uint16_t gSavedAge;
 extern uint32_t gLastAutoSaveUpdate;
+// Time in milliseconds the game thread spent capturing the state for the last asynchronous save.
+extern double gScenarioSavePauseTime;
 
 extern char gScenarioFileName[260];
 
@@ -412,6 +414,8 @@ uint32_t scenario_rand_max(uint32_t max);
 
 bool scenario_prepare_for_save();
 int32_t scenario_save(const utf8* path, int32_t flags);
+bool scenario_save_async(const utf8* path, int32_t flags);
+void scenario_save_async_wait();
 void scenario_remove_trackless_rides(rct_s6_data* s6);
 void scenario_fix_ghosts(rct_s6_data* s6);
 void scenario_failure();
@@ -26,6 +26,13 @@ static void encode_chunk_rotate(uint8_t* buffer, size_t length);
 bool gUseRLE = true;
 
 uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
+{
+    static const auto fn = sse41_available() ? sawyercoding_calculate_checksum_sse4_1
+                                             : sawyercoding_calculate_checksum_scalar;
+    return fn(buffer, length);
+}
+
+uint32_t sawyercoding_calculate_checksum_scalar(const uint8_t* buffer, size_t length)
 {
     size_t i;
     uint32_t checksum = 0;
@@ -35,6 +42,66 @@ uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length)
     return checksum;
 }
 
+/**
+ * Rotates every byte by 1, 3, 5, 7, 1, ... bits, to the right when decoding and to the left when encoding.
+ * dst and src may be the same buffer.
+ */
+void sawyercoding_rotate(uint8_t* dst, const uint8_t* src, size_t length, bool encode)
+{
+    static const auto fn = sse41_available() ? sawyercoding_rotate_sse4_1 : sawyercoding_rotate_scalar;
+    fn(dst, src, length, encode);
+}
+
+void sawyercoding_rotate_scalar(uint8_t* dst, const uint8_t* src, size_t length, bool encode)
+{
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++)
+    {
+        dst[i] = encode ? rol8(src[i], code) : ror8(src[i], code);
+        code = (code + 2) % 8;
+    }
+}
+
+/**
+ * Returns the number of bytes from src, up to max, that are not followed by an equal byte.
+ * src[max] must be readable.
+ */
+size_t sawyercoding_rle_count_literals(const uint8_t* src, size_t max)
+{
+    static const auto fn = sse41_available() ? sawyercoding_rle_count_literals_sse4_1
+                                             : sawyercoding_rle_count_literals_scalar;
+    return fn(src, max);
+}
+
+size_t sawyercoding_rle_count_literals_scalar(const uint8_t* src, size_t max)
+{
+    for (size_t i = 0; i < max; i++)
+    {
+        if (src[i] == src[i + 1])
+            return i;
+    }
+    return max;
+}
+
+/**
+ * Returns the number of bytes from src, up to max, that are equal to src[0].
+ */
+size_t sawyercoding_rle_count_run(const uint8_t* src, size_t max)
+{
+    static const auto fn = sse41_available() ? sawyercoding_rle_count_run_sse4_1 : sawyercoding_rle_count_run_scalar;
+    return fn(src, max);
+}
+
+size_t sawyercoding_rle_count_run_scalar(const uint8_t* src, size_t max)
+{
+    for (size_t i = 0; i < max; i++)
+    {
+        if (src[i] != src[0])
+            return i;
+    }
+    return max;
+}
+
 /**
  *
  *  rct2: 0x006762E1
@@ -109,6 +176,15 @@ size_t sawyercoding_decode_sc4(const uint8_t* src, uint8_t* dst, size_t length,
     size_t decodedLength = decode_chunk_rle_with_size(src, dst, length - 4, bufferLength);
 
     // Decode
+    sawyercoding_decrypt_sc4(dst, decodedLength);
+    return decodedLength;
+}
+
+/**
+ * Reverses the scrambling applied to the RLE decoded data of an SC4 file.
+ */
+void sawyercoding_decrypt_sc4(uint8_t* dst, size_t decodedLength)
+{
     for (size_t i = 0x60018; i <= std::min(decodedLength - 1, (size_t)0x1F8353); i++)
         dst[i] = dst[i] ^ 0x9C;
 
@@ -119,8 +195,6 @@ size_t sawyercoding_decode_sc4(const uint8_t* src, uint8_t* dst, size_t length,
         uint32_t* code = (uint32_t*)&dst[i];
         *code = rol32(*code, 9);
     }
-
-    return decodedLength;
 }
 
 size_t sawyercoding_encode_sv4(const uint8_t* src, uint8_t* dst, size_t length)
@@ -286,11 +360,7 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
         }
         if (*src == src[1])
         {
-            for (; (count < 125) && ((src + count) < end_src); count++)
-            {
-                if (*src != src[count])
-                    break;
-            }
+            count = (uint8_t)sawyercoding_rle_count_run(src, std::min<size_t>(125, end_src - src));
             *dst++ = 257 - count;
             *dst++ = *src;
             src += count;
@@ -299,8 +369,10 @@ static size_t encode_chunk_rle(const uint8_t* src_buffer, uint8_t* dst_buffer, s
         }
         else
         {
-            count++;
-            src++;
+            // Skip all bytes up to the next run, but stop when the literal block is full.
+            size_t literals = sawyercoding_rle_count_literals(src, std::min<size_t>(126 - count, end_src - 1 - src));
+            count += (uint8_t)literals;
+            src += literals;
         }
     }
     if (src == end_src - 1)
@@ -383,13 +455,7 @@ static size_t encode_chunk_repeat(const uint8_t* src_buffer, uint8_t* dst_buffer
 
 static void encode_chunk_rotate(uint8_t* buffer, size_t length)
 {
-    size_t i;
-    uint8_t code = 1;
-    for (i = 0; i < length; i++)
-    {
-        buffer[i] = rol8(buffer[i], code);
-        code = (code + 2) % 8;
-    }
+    sawyercoding_rotate(buffer, buffer, length, true);
 }
 
 #pragma endregion
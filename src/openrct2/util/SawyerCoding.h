@@ -48,11 +48,27 @@ uint32_t sawyercoding_calculate_checksum(const uint8_t* buffer, size_t length);
 size_t sawyercoding_write_chunk_buffer(uint8_t* dst_file, const uint8_t* src_buffer, sawyercoding_chunk_header chunkHeader);
 size_t sawyercoding_decode_sv4(const uint8_t* src, uint8_t* dst, size_t length, size_t bufferLength);
 size_t sawyercoding_decode_sc4(const uint8_t* src, uint8_t* dst, size_t length, size_t bufferLength);
+void sawyercoding_decrypt_sc4(uint8_t* dst, size_t decodedLength);
 size_t sawyercoding_encode_sv4(const uint8_t* src, uint8_t* dst, size_t length);
 size_t sawyercoding_decode_td6(const uint8_t* src, uint8_t* dst, size_t length);
 size_t sawyercoding_encode_td6(const uint8_t* src, uint8_t* dst, size_t length);
 int32_t sawyercoding_validate_track_checksum(const uint8_t* src, size_t length);
 
+// Kernels shared by the Sawyer encoders and decoders, these dispatch to the fastest implementation for the CPU.
+void sawyercoding_rotate(uint8_t* dst, const uint8_t* src, size_t length, bool encode);
+size_t sawyercoding_rle_count_literals(const uint8_t* src, size_t max);
+size_t sawyercoding_rle_count_run(const uint8_t* src, size_t max);
+
+uint32_t sawyercoding_calculate_checksum_scalar(const uint8_t* buffer, size_t length);
+void sawyercoding_rotate_scalar(uint8_t* dst, const uint8_t* src, size_t length, bool encode);
+size_t sawyercoding_rle_count_literals_scalar(const uint8_t* src, size_t max);
+size_t sawyercoding_rle_count_run_scalar(const uint8_t* src, size_t max);
+
+uint32_t sawyercoding_calculate_checksum_sse4_1(const uint8_t* buffer, size_t length);
+void sawyercoding_rotate_sse4_1(uint8_t* dst, const uint8_t* src, size_t length, bool encode);
+size_t sawyercoding_rle_count_literals_sse4_1(const uint8_t* src, size_t max);
+size_t sawyercoding_rle_count_run_sse4_1(const uint8_t* src, size_t max);
+
 int32_t sawyercoding_detect_file_type(const uint8_t* src, size_t length);
 int32_t sawyercoding_detect_rct1_version(int32_t gameVersion);
 
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "../common.h"
+#include "../core/Guard.hpp"
+#include "SawyerCoding.h"
+#include "Util.h"
+
+#ifdef __SSE4_1__
+
+#    include <immintrin.h>
+
+uint32_t sawyercoding_calculate_checksum_sse4_1(const uint8_t* buffer, size_t length)
+{
+    // _mm_sad_epu8 against zero sums each half of the vector into a 64-bit lane.
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum = zero;
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i*)(buffer + i));
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(data, zero));
+    }
+
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128((__m128i*)lanes, sum);
+    uint32_t checksum = (uint32_t)(lanes[0] + lanes[1]);
+    for (; i < length; i++)
+    {
+        checksum += buffer[i];
+    }
+    return checksum;
+}
+
+static __m128i ror_epi8(__m128i value, int32_t shift)
+{
+    // There is no 8-bit shift, so shift 16-bit lanes and mask off the bits that crossed into the neighbouring byte.
+    const __m128i right = _mm_and_si128(
+        _mm_srl_epi16(value, _mm_cvtsi32_si128(shift)), _mm_set1_epi8((char)(0xFF >> shift)));
+    const __m128i left = _mm_and_si128(
+        _mm_sll_epi16(value, _mm_cvtsi32_si128(8 - shift)), _mm_set1_epi8((char)(0xFF << (8 - shift))));
+    return _mm_or_si128(right, left);
+}
+
+void sawyercoding_rotate_sse4_1(uint8_t* dst, const uint8_t* src, size_t length, bool encode)
+{
+    // The rotation repeats every four bytes: right by 1, 3, 5, 7 to decode, left by the same amounts to encode.
+    const int32_t shifts[4] = { encode ? 7 : 1, encode ? 5 : 3, encode ? 3 : 5, encode ? 1 : 7 };
+    const __m128i masks[4] = {
+        _mm_set1_epi32(0x000000FF),
+        _mm_set1_epi32(0x0000FF00),
+        _mm_set1_epi32(0x00FF0000),
+        _mm_set1_epi32((int32_t)0xFF000000),
+    };
+
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i result = _mm_and_si128(ror_epi8(data, shifts[0]), masks[0]);
+        for (int32_t j = 1; j < 4; j++)
+        {
+            result = _mm_or_si128(result, _mm_and_si128(ror_epi8(data, shifts[j]), masks[j]));
+        }
+        _mm_storeu_si128((__m128i*)(dst + i), result);
+    }
+    for (; i < length; i++)
+    {
+        dst[i] = ror8(src[i], shifts[i % 4]);
+    }
+}
+
+size_t sawyercoding_rle_count_literals_sse4_1(const uint8_t* src, size_t max)
+{
+    size_t i = 0;
+    for (; i + 16 <= max; i += 16)
+    {
+        const __m128i current = _mm_loadu_si128((const __m128i*)(src + i));
+        const __m128i next = _mm_loadu_si128((const __m128i*)(src + i + 1));
+        const int32_t equal = _mm_movemask_epi8(_mm_cmpeq_epi8(current, next));
+        if (equal != 0)
+        {
+            return i + bitscanforward(equal);
+        }
+    }
+    for (; i < max; i++)
+    {
+        if (src[i] == src[i + 1])
+            return i;
+    }
+    return max;
+}
+
+size_t sawyercoding_rle_count_run_sse4_1(const uint8_t* src, size_t max)
+{
+    const __m128i value = _mm_set1_epi8((char)src[0]);
+    size_t i = 0;
+    for (; i + 16 <= max; i += 16)
+    {
+        const __m128i data = _mm_loadu_si128((const __m128i*)(src + i));
+        const int32_t different = ~_mm_movemask_epi8(_mm_cmpeq_epi8(data, value)) & 0xFFFF;
+        if (different != 0)
+        {
+            return i + bitscanforward(different);
+        }
+    }
+    for (; i < max; i++)
+    {
+        if (src[i] != src[0])
+            return i;
+    }
+    return max;
+}
+
+#else
+
+#    ifdef OPENRCT2_X86
+#        error You have to compile this file with SSE4.1 enabled, when targetting x86!
+#    endif
+
+uint32_t sawyercoding_calculate_checksum_sse4_1(const uint8_t* buffer, size_t length)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+void sawyercoding_rotate_sse4_1(uint8_t* dst, const uint8_t* src, size_t length, bool encode)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+}
+
+size_t sawyercoding_rle_count_literals_sse4_1(const uint8_t* src, size_t max)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+size_t sawyercoding_rle_count_run_sse4_1(const uint8_t* src, size_t max)
+{
+    openrct2_assert(false, "SSE 4.1 function called on a CPU that doesn't support SSE 4.1");
+    return 0;
+}
+
+#endif // __SSE4_1__
@@ -620,6 +620,96 @@ uint8_t* util_zlib_deflate(const uint8_t* data, size_t data_in_size, size_t* dat
     return buffer;
 }
 
+/**
+ * @brief Deflates input using zlib, priming the compressor with a preset dictionary
+ * @param data Data to be compressed
+ * @param data_in_size Size of data to be compressed
+ * @param data_out_size Pointer to a variable where output size will be written
+ * @param dict Preset dictionary, the same bytes must be passed to util_zlib_inflate_dictionary
+ * @param dict_size Size of the preset dictionary
+ * @return Returns a pointer to memory holding compressed data or NULL on failure.
+ * @note It is caller's responsibility to free() the returned pointer once done with it.
+ */
+uint8_t* util_zlib_deflate_dictionary(
+    const uint8_t* data, size_t data_in_size, size_t* data_out_size, const uint8_t* dict, size_t dict_size)
+{
+    z_stream strm{};
+    if (deflateInit(&strm, Z_BEST_COMPRESSION) != Z_OK)
+    {
+        log_error("Failed to initialise zlib stream.");
+        return nullptr;
+    }
+    if (deflateSetDictionary(&strm, dict, (uInt)dict_size) != Z_OK)
+    {
+        log_error("Failed to set zlib dictionary.");
+        deflateEnd(&strm);
+        return nullptr;
+    }
+
+    uLong buffer_size = deflateBound(&strm, (uLong)data_in_size);
+    uint8_t* buffer = (uint8_t*)malloc(buffer_size);
+    strm.next_in = (Bytef*)data;
+    strm.avail_in = (uInt)data_in_size;
+    strm.next_out = buffer;
+    strm.avail_out = (uInt)buffer_size;
+
+    int32_t ret = deflate(&strm, Z_FINISH);
+    deflateEnd(&strm);
+    if (ret != Z_STREAM_END)
+    {
+        log_error("Error compressing data.");
+        free(buffer);
+        return nullptr;
+    }
+    *data_out_size = strm.total_out;
+    buffer = (uint8_t*)realloc(buffer, *data_out_size);
+    return buffer;
+}
+
+/**
+ * @brief Inflates zlib-compressed data that was deflated with a preset dictionary
+ * @param data Data to be decompressed
+ * @param data_in_size Size of data to be decompressed
+ * @param data_out_size Exact size of the decompressed data
+ * @param dict Preset dictionary used when compressing
+ * @param dict_size Size of the preset dictionary
+ * @return Returns a pointer to memory holding decompressed data or NULL on failure.
+ * @note It is caller's responsibility to free() the returned pointer once done with it.
+ */
+uint8_t* util_zlib_inflate_dictionary(
+    const uint8_t* data, size_t data_in_size, size_t data_out_size, const uint8_t* dict, size_t dict_size)
+{
+    z_stream strm{};
+    if (inflateInit(&strm) != Z_OK)
+    {
+        log_error("Failed to initialise zlib stream.");
+        return nullptr;
+    }
+
+    uint8_t* buffer = (uint8_t*)malloc(std::max<size_t>(data_out_size, 1));
+    strm.next_in = (Bytef*)data;
+    strm.avail_in = (uInt)data_in_size;
+    strm.next_out = buffer;
+    strm.avail_out = (uInt)data_out_size;
+
+    int32_t ret = inflate(&strm, Z_FINISH);
+    if (ret == Z_NEED_DICT)
+    {
+        if (inflateSetDictionary(&strm, dict, (uInt)dict_size) == Z_OK)
+        {
+            ret = inflate(&strm, Z_FINISH);
+        }
+    }
+    inflateEnd(&strm);
+    if (ret != Z_STREAM_END || strm.total_out != data_out_size)
+    {
+        log_error("Error uncompressing data.");
+        free(buffer);
+        return nullptr;
+    }
+    return buffer;
+}
+
 // Compress the source to gzip-compatible stream, write to dest.
 // Mainly used for compressing the crashdumps
 bool util_gzip_compress(FILE* source, FILE* dest)
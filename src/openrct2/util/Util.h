@@ -54,6 +54,10 @@ uint32_t util_rand();
 
 uint8_t* util_zlib_deflate(const uint8_t* data, size_t data_in_size, size_t* data_out_size);
 uint8_t* util_zlib_inflate(uint8_t* data, size_t data_in_size, size_t* data_out_size);
+uint8_t* util_zlib_deflate_dictionary(
+    const uint8_t* data, size_t data_in_size, size_t* data_out_size, const uint8_t* dict, size_t dict_size);
+uint8_t* util_zlib_inflate_dictionary(
+    const uint8_t* data, size_t data_in_size, size_t data_out_size, const uint8_t* dict, size_t dict_size);
 bool util_gzip_compress(FILE* source, FILE* dest);
 
 int8_t add_clamp_int8_t(int8_t value, int8_t value_to_add);
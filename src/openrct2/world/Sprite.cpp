@@ -35,6 +35,12 @@ static bool _spriteFlashingList[MAX_SPRITES];
 
 uint16_t gSpriteSpatialIndex[0x10001];
 
+// Only the vehicles of gSpriteSpatialIndex, in the same order, so vehicle collision checks skip over peeps and litter
+// but still find the same vehicle first.
+static uint16_t _vehicleSpatialIndex[SPATIAL_INDEX_LOCATION_NULL];
+static uint16_t _vehicleNextInQuadrant[MAX_SPRITES];
+static uint32_t _vehicleQuadrant[MAX_SPRITES];
+
 const rct_string_id litterNames[12] = { STR_LITTER_VOMIT,
                                         STR_LITTER_VOMIT,
                                         STR_SHOP_ITEM_SINGULAR_EMPTY_CAN,
@@ -52,6 +58,7 @@ static LocationXYZ16 _spritelocations1[MAX_SPRITES];
 static LocationXYZ16 _spritelocations2[MAX_SPRITES];
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y);
+static void vehicle_spatial_index_move(rct_sprite* sprite, size_t newIndex);
 
 std::string rct_sprite_checksum::ToString() const
 {
@@ -98,6 +105,17 @@ uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y)
     return gSpriteSpatialIndex[offset];
 }
 
+uint16_t sprite_get_first_vehicle_in_quadrant(int32_t x, int32_t y)
+{
+    int32_t offset = ((x & 0x1FE0) << 3) | (y >> 5);
+    return _vehicleSpatialIndex[offset];
+}
+
+uint16_t sprite_get_next_vehicle_in_quadrant(uint16_t spriteIndex)
+{
+    return _vehicleNextInQuadrant[spriteIndex];
+}
+
 static void invalidate_sprite_max_zoom(rct_sprite* sprite, int32_t maxZoom)
 {
     if (sprite->generic.sprite_left == LOCATION_NULL)
@@ -209,6 +227,66 @@ void reset_sprite_spatial_index()
             spr->generic.next_in_quadrant = nextSpriteId;
         }
     }
+    reset_vehicle_spatial_index();
+}
+
+/**
+ * Rebuilds the vehicle spatial index from gSpriteSpatialIndex, needed whenever that is written to directly.
+ */
+void reset_vehicle_spatial_index()
+{
+    std::fill_n(_vehicleSpatialIndex, std::size(_vehicleSpatialIndex), SPRITE_INDEX_NULL);
+    std::fill_n(_vehicleNextInQuadrant, std::size(_vehicleNextInQuadrant), SPRITE_INDEX_NULL);
+    std::fill_n(_vehicleQuadrant, std::size(_vehicleQuadrant), SPATIAL_INDEX_LOCATION_NULL);
+    for (uint32_t i = 0; i < SPATIAL_INDEX_LOCATION_NULL; i++)
+    {
+        uint16_t* vehicleIndex = &_vehicleSpatialIndex[i];
+        // Broken saves can have cycles in the quadrant lists, never walk further than there are sprites
+        uint16_t spriteIndex = gSpriteSpatialIndex[i];
+        for (size_t j = 0; j < MAX_SPRITES && spriteIndex < MAX_SPRITES; j++)
+        {
+            rct_sprite* spr = get_sprite(spriteIndex);
+            if (spr->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE
+                && _vehicleQuadrant[spriteIndex] == SPATIAL_INDEX_LOCATION_NULL)
+            {
+                *vehicleIndex = spriteIndex;
+                vehicleIndex = &_vehicleNextInQuadrant[spriteIndex];
+                _vehicleQuadrant[spriteIndex] = i;
+            }
+            spriteIndex = spr->generic.next_in_quadrant;
+        }
+    }
+}
+
+static void vehicle_spatial_index_move(rct_sprite* sprite, size_t newIndex)
+{
+    uint16_t spriteIndex = sprite->generic.sprite_index;
+    uint32_t currentIndex = _vehicleQuadrant[spriteIndex];
+    if (currentIndex == newIndex)
+    {
+        return;
+    }
+
+    if (currentIndex != SPATIAL_INDEX_LOCATION_NULL)
+    {
+        uint16_t* vehicleIndex = &_vehicleSpatialIndex[currentIndex];
+        while (*vehicleIndex != SPRITE_INDEX_NULL && *vehicleIndex != spriteIndex)
+        {
+            vehicleIndex = &_vehicleNextInQuadrant[*vehicleIndex];
+        }
+        if (*vehicleIndex == spriteIndex)
+        {
+            *vehicleIndex = _vehicleNextInQuadrant[spriteIndex];
+        }
+    }
+
+    _vehicleNextInQuadrant[spriteIndex] = SPRITE_INDEX_NULL;
+    _vehicleQuadrant[spriteIndex] = (uint32_t)newIndex;
+    if (newIndex != SPATIAL_INDEX_LOCATION_NULL)
+    {
+        _vehicleNextInQuadrant[spriteIndex] = _vehicleSpatialIndex[newIndex];
+        _vehicleSpatialIndex[newIndex] = spriteIndex;
+    }
 }
 
 static size_t GetSpatialIndexOffset(int32_t x, int32_t y)
@@ -658,6 +736,10 @@ void sprite_move(int16_t x, int16_t y, int16_t z, rct_sprite* sprite)
         gSpriteSpatialIndex[newIndex] = sprite->generic.sprite_index;
         sprite->generic.next_in_quadrant = tempSpriteIndex;
     }
+    if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+    {
+        vehicle_spatial_index_move(sprite, newIndex);
+    }
 
     if (x == LOCATION_NULL)
     {
@@ -699,6 +781,10 @@ void sprite_remove(rct_sprite* sprite)
     }
 
     move_sprite_to_list(sprite, SPRITE_LIST_FREE);
+    if (sprite->generic.sprite_identifier == SPRITE_IDENTIFIER_VEHICLE)
+    {
+        vehicle_spatial_index_move(sprite, SPATIAL_INDEX_LOCATION_NULL);
+    }
     sprite->generic.sprite_identifier = SPRITE_IDENTIFIER_NULL;
     _spriteFlashingList[sprite->generic.sprite_index] = false;
 
@@ -1113,6 +1199,7 @@ int32_t check_for_spatial_index_cycles(bool fix)
                     spr->generic.next_in_quadrant = SPRITE_INDEX_NULL;
                     cycle_start = spr;
                 }
+                reset_vehicle_spatial_index();
             }
             return i;
         }
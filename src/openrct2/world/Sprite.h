@@ -198,6 +198,7 @@ extern const rct_string_id litterNames[12];
 rct_sprite* create_sprite(SPRITE_IDENTIFIER spriteIdentifier);
 void reset_sprite_list();
 void reset_sprite_spatial_index();
+void reset_vehicle_spatial_index();
 void sprite_clear_all_unused();
 void move_sprite_to_list(rct_sprite* sprite, SPRITE_LIST newList);
 void sprite_misc_update_all();
@@ -212,6 +213,8 @@ void litter_remove_at(int32_t x, int32_t y, int32_t z);
 void sprite_misc_explosion_cloud_create(int32_t x, int32_t y, int32_t z);
 void sprite_misc_explosion_flare_create(int32_t x, int32_t y, int32_t z);
 uint16_t sprite_get_first_in_quadrant(int32_t x, int32_t y);
+uint16_t sprite_get_first_vehicle_in_quadrant(int32_t x, int32_t y);
+uint16_t sprite_get_next_vehicle_in_quadrant(uint16_t spriteIndex);
 void sprite_position_tween_store_a();
 void sprite_position_tween_store_b();
 void sprite_position_tween_all(float nudge);
@@ -192,8 +192,7 @@ static void CallOriginal(
 static void CallNew(
     uint8_t rideType, uint8_t trackType, uint8_t direction, uint8_t trackSequence, uint16_t height, TileElement* tileElement)
 {
-    TRACK_PAINT_FUNCTION_GETTER newPaintFunctionGetter = RideTypeTrackPaintFunctions[rideType];
-    TRACK_PAINT_FUNCTION newPaintFunction = newPaintFunctionGetter(trackType, direction);
+    TRACK_PAINT_FUNCTION newPaintFunction = track_paint_get_function(rideType, trackType);
 
     newPaintFunction(&gPaintSession, 0, trackSequence, direction, height, tileElement);
 }
@@ -219,6 +218,17 @@ uint8_t TestTrack::TestPaintTrackElement(uint8_t rideType, uint8_t trackType, st
         return TEST_FAILED;
     }
 
+    // The game paints through the table, which has to hold what the getter returns for every direction
+    TRACK_PAINT_FUNCTION_GETTER newPaintFunctionGetter = RideTypeTrackPaintFunctions[rideType];
+    for (int direction = 0; direction < 4; direction++)
+    {
+        if (track_paint_get_function(rideType, trackType) != newPaintFunctionGetter(trackType, direction))
+        {
+            *out += String::Format("Paint function table does not match the getter for direction %d\n", direction);
+            return TEST_FAILED;
+        }
+    }
+
     if (rideType == RIDE_TYPE_CHAIRLIFT)
     {
         if (trackType == TRACK_ELEM_BEGIN_STATION || trackType == TRACK_ELEM_MIDDLE_STATION
@@ -57,3 +57,31 @@ TEST_F(ImageImporterTests, Import_Logo)
     ASSERT_EQ(0xCEF27C7D, hash);
     free(result.Buffer);
 }
+
+TEST_F(ImageImporterTests, Import_Logo_Closest)
+{
+    auto logoPath = GetImagePath("logo.png");
+
+    ImageImporter importer;
+    auto image = Imaging::ReadFromFile(logoPath, IMAGE_FORMAT::PNG_32);
+    auto result = importer.Import(image, 0, 0, ImageImporter::IMPORT_FLAGS::RLE, ImageImporter::IMPORT_MODE::CLOSEST);
+
+    ASSERT_NE(nullptr, result.Buffer);
+    auto hash = GetHash(result.Buffer, result.BufferLength);
+    ASSERT_EQ(0x2ABFC1B7, hash);
+    free(result.Buffer);
+}
+
+TEST_F(ImageImporterTests, Import_Logo_Dithering)
+{
+    auto logoPath = GetImagePath("logo.png");
+
+    ImageImporter importer;
+    auto image = Imaging::ReadFromFile(logoPath, IMAGE_FORMAT::PNG_32);
+    auto result = importer.Import(image, 0, 0, ImageImporter::IMPORT_FLAGS::RLE, ImageImporter::IMPORT_MODE::DITHERING);
+
+    ASSERT_NE(nullptr, result.Buffer);
+    auto hash = GetHash(result.Buffer, result.BufferLength);
+    ASSERT_EQ(0xDF3DA4DC, hash);
+    free(result.Buffer);
+}
@@ -0,0 +1,166 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/core/Endianness.h>
+#include <openrct2/network/NetworkPacket.h>
+#include <openrct2/network/NetworkTickBundle.h>
+#include <openrct2/network/NetworkTypes.h>
+#include <cstring>
+#include <vector>
+
+class NetworkTickBundleTests : public testing::Test
+{
+protected:
+    static NetworkTickBundle CreateBundle(uint32_t flags, size_t numActions, size_t actionSize)
+    {
+        NetworkTickBundle bundle;
+        bundle.Tick = 1234;
+        bundle.Srand0 = 0xDEADBEEF;
+        bundle.Flags = flags;
+        if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
+        {
+            bundle.SpriteHash = "0123456789ABCDEF0123456789ABCDEF01234567";
+        }
+        for (size_t i = 0; i < numActions; i++)
+        {
+            // Small big endian values like serialised game actions
+            std::vector<uint8_t> data(actionSize);
+            for (size_t j = 0; j < actionSize; j++)
+            {
+                data[j] = (j % 4 == 3) ? (uint8_t)(i + j) : 0;
+            }
+            bundle.AddAction((uint32_t)i, data.data(), data.size());
+        }
+        return bundle;
+    }
+
+    // Reads the command like the connection does before the packet is handed to its handler
+    static void PrepareForRead(NetworkPacket& packet)
+    {
+        packet.Size = (uint16_t)packet.Data->size();
+        packet.BytesRead = 0;
+        uint32_t command = 0;
+        packet >> command;
+        ASSERT_EQ(command, (uint32_t)NETWORK_COMMAND_TICK_BUNDLE);
+    }
+
+    static void AssertBundlesEqual(const NetworkTickBundle& expected, const NetworkTickBundle& actual)
+    {
+        ASSERT_EQ(actual.Tick, expected.Tick);
+        ASSERT_EQ(actual.Srand0, expected.Srand0);
+        ASSERT_EQ(actual.Flags & NETWORK_TICK_FLAG_CHECKSUMS, expected.Flags & NETWORK_TICK_FLAG_CHECKSUMS);
+        ASSERT_EQ(actual.SpriteHash, expected.SpriteHash);
+        ASSERT_EQ(actual.RawSize, expected.RawSize);
+        ASSERT_EQ(actual.WireSize, expected.WireSize);
+        ASSERT_EQ(actual.Actions.size(), expected.Actions.size());
+        for (size_t i = 0; i < expected.Actions.size(); i++)
+        {
+            const auto& expectedAction = expected.Actions[i];
+            const auto& actualAction = actual.Actions[i];
+            ASSERT_EQ(actualAction.Type, expectedAction.Type);
+            ASSERT_EQ(actualAction.Data.GetLength(), expectedAction.Data.GetLength());
+            ASSERT_EQ(
+                std::memcmp(actualAction.Data.GetData(), expectedAction.Data.GetData(), expectedAction.Data.GetLength()), 0);
+        }
+    }
+};
+
+TEST_F(NetworkTickBundleTests, RoundTripUncompressed)
+{
+    // Too small to be worth compressing
+    auto bundle = CreateBundle(0, 1, 8);
+    NetworkPacket packet;
+    ASSERT_TRUE(bundle.Write(packet));
+    ASSERT_LT(bundle.RawSize, NETWORK_TICK_BUNDLE_COMPRESS_THRESHOLD);
+    ASSERT_EQ(bundle.WireSize, bundle.RawSize);
+
+    PrepareForRead(packet);
+    NetworkTickBundle received;
+    ASSERT_TRUE(received.Read(packet));
+    ASSERT_FALSE(received.Flags & NETWORK_TICK_FLAG_COMPRESSED);
+    AssertBundlesEqual(bundle, received);
+}
+
+TEST_F(NetworkTickBundleTests, RoundTripCompressed)
+{
+    auto bundle = CreateBundle(NETWORK_TICK_FLAG_CHECKSUMS, 200, 40);
+    NetworkPacket packet;
+    ASSERT_TRUE(bundle.Write(packet));
+    ASSERT_LT(bundle.WireSize, bundle.RawSize);
+
+    PrepareForRead(packet);
+    NetworkTickBundle received;
+    ASSERT_TRUE(received.Read(packet));
+    ASSERT_TRUE(received.Flags & NETWORK_TICK_FLAG_COMPRESSED);
+    AssertBundlesEqual(bundle, received);
+}
+
+TEST_F(NetworkTickBundleTests, RoundTripEmpty)
+{
+    auto bundle = CreateBundle(NETWORK_TICK_FLAG_CHECKSUMS, 0, 0);
+    NetworkPacket packet;
+    ASSERT_TRUE(bundle.Write(packet));
+
+    PrepareForRead(packet);
+    NetworkTickBundle received;
+    ASSERT_TRUE(received.Read(packet));
+    AssertBundlesEqual(bundle, received);
+}
+
+TEST_F(NetworkTickBundleTests, WriteRejectsOverLimit)
+{
+    auto bundle = CreateBundle(0, 100, NETWORK_TICK_BUNDLE_MAX_PAYLOAD / 99);
+    NetworkPacket packet;
+    ASSERT_FALSE(bundle.Write(packet));
+    ASSERT_GT(bundle.RawSize, NETWORK_TICK_BUNDLE_MAX_PAYLOAD);
+    ASSERT_TRUE(packet.Data->empty());
+}
+
+TEST_F(NetworkTickBundleTests, ReadRejectsOverLimit)
+{
+    // A compressed payload claiming to inflate to more than the limit must not be inflated
+    auto bundle = CreateBundle(0, 200, 40);
+    NetworkPacket packet;
+    ASSERT_TRUE(bundle.Write(packet));
+    ASSERT_LT(bundle.WireSize, bundle.RawSize);
+    uint32_t rawSize = ByteSwapBE((uint32_t)(NETWORK_TICK_BUNDLE_MAX_PAYLOAD + 1));
+    std::memcpy(packet.GetData() + 4 * sizeof(uint32_t), &rawSize, sizeof(rawSize));
+
+    PrepareForRead(packet);
+    NetworkTickBundle received;
+    ASSERT_FALSE(received.Read(packet));
+}
+
+TEST_F(NetworkTickBundleTests, ReadRejectsWrongSize)
+{
+    // An uncompressed payload must be exactly the claimed size
+    auto bundle = CreateBundle(0, 1, 8);
+    NetworkPacket packet;
+    ASSERT_TRUE(bundle.Write(packet));
+    packet.Data->push_back(0);
+
+    PrepareForRead(packet);
+    NetworkTickBundle received;
+    ASSERT_FALSE(received.Read(packet));
+}
+
+TEST_F(NetworkTickBundleTests, ReadRejectsCorruptData)
+{
+    auto bundle = CreateBundle(0, 200, 40);
+    NetworkPacket packet;
+    ASSERT_TRUE(bundle.Write(packet));
+    ASSERT_LT(bundle.WireSize, bundle.RawSize);
+    // Cut off the end of the compressed payload
+    packet.Data->resize(packet.Data->size() - bundle.WireSize / 2);
+
+    PrepareForRead(packet);
+    NetworkTickBundle received;
+    ASSERT_FALSE(received.Read(packet));
+}
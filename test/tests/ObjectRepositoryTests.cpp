@@ -0,0 +1,108 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/PlatformEnvironment.h>
+#include <openrct2/core/File.h>
+#include <openrct2/localisation/LocalisationService.h>
+#include <openrct2/object/ObjectList.h>
+#include <openrct2/object/ObjectRepository.h>
+#include <openrct2/platform/platform.h>
+#include <cstring>
+
+using namespace OpenRCT2;
+
+class ObjectRepositoryTests : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+    }
+
+    void TearDown() override
+    {
+        _context = nullptr;
+    }
+};
+
+static void AssertItemsEqual(const ObjectRepositoryItem& expected, const ObjectRepositoryItem& actual)
+{
+    ASSERT_EQ(actual.Id, expected.Id);
+    ASSERT_EQ(std::memcmp(&actual.ObjectEntry, &expected.ObjectEntry, sizeof(rct_object_entry)), 0);
+    ASSERT_EQ(actual.Path, expected.Path);
+    ASSERT_EQ(actual.Name, expected.Name);
+    ASSERT_EQ(actual.Sources, expected.Sources);
+    ASSERT_EQ(actual.SceneryGroupInfo.Entries.size(), expected.SceneryGroupInfo.Entries.size());
+    for (size_t i = 0; i < expected.SceneryGroupInfo.Entries.size(); i++)
+    {
+        ASSERT_EQ(
+            std::memcmp(&actual.SceneryGroupInfo.Entries[i], &expected.SceneryGroupInfo.Entries[i], sizeof(rct_object_entry)),
+            0);
+    }
+    if (object_entry_get_type(&expected.ObjectEntry) == OBJECT_TYPE_RIDE)
+    {
+        ASSERT_EQ(actual.RideInfo.RideFlags, expected.RideInfo.RideFlags);
+        for (int32_t i = 0; i < MAX_CATEGORIES_PER_RIDE; i++)
+        {
+            ASSERT_EQ(actual.RideInfo.RideCategory[i], expected.RideInfo.RideCategory[i]);
+        }
+        for (int32_t i = 0; i < MAX_RIDE_TYPES_PER_RIDE_ENTRY; i++)
+        {
+            ASSERT_EQ(actual.RideInfo.RideType[i], expected.RideInfo.RideType[i]);
+        }
+        ASSERT_EQ(actual.RideInfo.RideGroupIndex, expected.RideInfo.RideGroupIndex);
+    }
+}
+
+TEST_F(ObjectRepositoryTests, SnapshotRoundTrip)
+{
+    auto env = _context->GetPlatformEnvironment();
+    auto language = _context->GetLocalisationService().GetCurrentLanguage();
+
+    // Build the repository from the object files, this writes the index and the snapshot
+    auto built = CreateObjectRepository(env);
+    built->Construct(language);
+    ASSERT_GT(built->GetNumObjects(), 0u);
+    ASSERT_TRUE(File::Exists(env->GetFilePath(PATHID::CACHE_SNAPSHOT)));
+
+    // Without the index, the repository can only be loaded from the snapshot or rebuilt, which writes the index again
+    auto indexPath = env->GetFilePath(PATHID::CACHE_OBJECTS);
+    auto indexData = File::ReadAllBytes(indexPath);
+    File::Delete(indexPath);
+
+    auto loaded = CreateObjectRepository(env);
+    loaded->LoadOrConstruct(language);
+    bool indexRebuilt = File::Exists(indexPath);
+    File::WriteAllBytes(indexPath, indexData.data(), indexData.size());
+    ASSERT_FALSE(indexRebuilt);
+
+    ASSERT_EQ(loaded->GetNumObjects(), built->GetNumObjects());
+    auto builtItems = built->GetObjects();
+    auto loadedItems = loaded->GetObjects();
+    for (size_t i = 0; i < built->GetNumObjects(); i++)
+    {
+        AssertItemsEqual(builtItems[i], loadedItems[i]);
+
+        // The lookup table must find every object at the same index
+        auto found = loaded->FindObject(&builtItems[i].ObjectEntry);
+        ASSERT_NE(found, nullptr);
+        ASSERT_EQ(found->Id, built->FindObject(&builtItems[i].ObjectEntry)->Id);
+    }
+}
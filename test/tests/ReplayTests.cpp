@@ -14,6 +14,7 @@
 #include <openrct2/Game.h>
 #include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
+#include <openrct2/PlatformEnvironment.h>
 #include <openrct2/ReplayManager.h>
 #include <openrct2/audio/AudioContext.h>
 #include <openrct2/core/File.h>
@@ -22,6 +23,7 @@
 #include <openrct2/core/String.hpp>
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
+#include <openrct2/world/Sprite.h>
 #include <string>
 
 using namespace OpenRCT2;
@@ -98,6 +100,116 @@ TEST_P(ReplayTests, RunReplay)
     }
 }
 
+TEST_P(ReplayTests, SeekReplay)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    core_init();
+
+    auto testData = GetParam();
+    auto replayFile = testData.filePath;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    auto gs = context->GetGameState();
+    ASSERT_NE(gs, nullptr);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    ASSERT_TRUE(replayManager->StartPlayback(replayFile));
+
+    ReplayRecordInfo info;
+    ASSERT_TRUE(replayManager->GetCurrentReplayInfo(info));
+    uint32_t startTick = gCurrentTicks;
+    uint32_t seekTick = info.Ticks / 2;
+
+    while (replayManager->IsReplaying() && gCurrentTicks - startTick < seekTick)
+    {
+        gs->UpdateLogic();
+    }
+    ASSERT_TRUE(replayManager->IsReplaying());
+    auto expectedChecksum = sprite_checksum();
+
+    // Seeking backwards restores the closest keyframe and simulates up to the requested tick.
+    ASSERT_TRUE(replayManager->SeekToTick(seekTick / 2));
+    ASSERT_EQ(gCurrentTicks, startTick + seekTick / 2);
+
+    ASSERT_TRUE(replayManager->SeekToTick(seekTick));
+    ASSERT_EQ(gCurrentTicks, startTick + seekTick);
+    ASSERT_EQ(sprite_checksum().ToString(), expectedChecksum.ToString());
+
+    replayManager->StopPlayback();
+}
+
+TEST(ReplayKeyframeTests, SeekAcrossKeyframes)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+    core_init();
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    auto gs = context->GetGameState();
+    ASSERT_NE(gs, nullptr);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    std::string parkPath = TestData::GetParkPath("bpb.sv6");
+    load_from_sv6(parkPath.c_str());
+    game_load_init();
+
+    auto replayPath = context->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
+    platform_ensure_directory_exists(replayPath.c_str());
+    auto replayFile = Path::Combine(replayPath, "keyframe-seek-test.sv6r");
+
+    // Record with a keyframe every 100 ticks
+    constexpr uint32_t recordTicks = 500;
+    ASSERT_TRUE(replayManager->StartRecording("keyframe-seek-test", recordTicks, 100));
+    while (replayManager->IsRecording())
+    {
+        gs->UpdateLogic();
+    }
+
+    ASSERT_TRUE(replayManager->StartPlayback(replayFile));
+    ReplayRecordInfo info;
+    ASSERT_TRUE(replayManager->GetCurrentReplayInfo(info));
+    ASSERT_GE(info.NumKeyframes, 3u);
+
+    // Play straight through to a tick after the third keyframe
+    constexpr uint32_t targetTick = 350;
+    uint32_t startTick = gCurrentTicks;
+    while (replayManager->IsReplaying() && gCurrentTicks - startTick < targetTick)
+    {
+        gs->UpdateLogic();
+        ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+    }
+    ASSERT_TRUE(replayManager->IsReplaying());
+    auto expectedChecksum = sprite_checksum().ToString();
+
+    // Back to before the first keyframe, then forward past it, which restores the keyframe at tick 300
+    ASSERT_TRUE(replayManager->SeekToTick(50));
+    ASSERT_EQ(gCurrentTicks, startTick + 50);
+    ASSERT_TRUE(replayManager->SeekToTick(targetTick));
+    ASSERT_EQ(gCurrentTicks, startTick + targetTick);
+    ASSERT_EQ(sprite_checksum().ToString(), expectedChecksum);
+
+    // Back to between two keyframes, which restores the keyframe at tick 200
+    ASSERT_TRUE(replayManager->SeekToTick(250));
+    ASSERT_EQ(gCurrentTicks, startTick + 250);
+    ASSERT_TRUE(replayManager->SeekToTick(targetTick));
+    ASSERT_EQ(sprite_checksum().ToString(), expectedChecksum);
+    ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    replayManager->StopPlayback();
+    File::Delete(replayFile);
+}
+
 static void PrintTo(const ReplayTestData& testData, std::ostream* os)
 {
     *os << testData.filePath;
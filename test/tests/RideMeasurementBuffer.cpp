@@ -0,0 +1,100 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <openrct2/ride/RideMeasurementBuffer.h>
+#include <stdint.h>
+#include <vector>
+
+// Enough samples for several blocks, the last one partly filled.
+constexpr size_t TEST_SAMPLE_COUNT = RideMeasurementBuffer::SAMPLES_PER_BLOCK * 5 + 17;
+
+static RideMeasurementSample CreateSample(size_t index)
+{
+    RideMeasurementSample sample;
+    // Mostly small steps with the occasional jump that does not fit in a nibble.
+    sample.vertical = static_cast<int8_t>((index % 40) - 20);
+    sample.lateral = static_cast<int8_t>(index % 23 == 0 ? 100 : -(int32_t)(index % 5));
+    sample.velocity = static_cast<uint8_t>(index * 3);
+    sample.altitude = static_cast<uint8_t>(200 - (index / 4));
+    return sample;
+}
+
+static void AssertSamplesEqual(const RideMeasurementBuffer& buffer, const std::vector<RideMeasurementSample>& expected)
+{
+    ASSERT_EQ(buffer.GetCount(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        auto sample = buffer.Get(i);
+        ASSERT_EQ(sample.vertical, expected[i].vertical) << "sample " << i;
+        ASSERT_EQ(sample.lateral, expected[i].lateral) << "sample " << i;
+        ASSERT_EQ(sample.velocity, expected[i].velocity) << "sample " << i;
+        ASSERT_EQ(sample.altitude, expected[i].altitude) << "sample " << i;
+    }
+}
+
+TEST(RideMeasurementBufferTest, append)
+{
+    RideMeasurementBuffer buffer;
+    std::vector<RideMeasurementSample> expected;
+    for (size_t i = 0; i < TEST_SAMPLE_COUNT; i++)
+    {
+        buffer.Set(i, CreateSample(i));
+        expected.push_back(CreateSample(i));
+    }
+    AssertSamplesEqual(buffer, expected);
+    ASSERT_LT(buffer.GetEncodedSize(), TEST_SAMPLE_COUNT * sizeof(RideMeasurementSample));
+}
+
+TEST(RideMeasurementBufferTest, overwrite_previous_run)
+{
+    RideMeasurementBuffer buffer;
+    std::vector<RideMeasurementSample> expected;
+    for (size_t i = 0; i < TEST_SAMPLE_COUNT; i++)
+    {
+        buffer.Set(i, CreateSample(i));
+        expected.push_back(CreateSample(i));
+    }
+
+    // A new run overwrites the start of the previous one, written twice per sample like the ride measurement does.
+    for (size_t i = 0; i < TEST_SAMPLE_COUNT / 2; i++)
+    {
+        buffer.Set(i, CreateSample(i + 1000));
+        buffer.Set(i, CreateSample(i + 2000));
+        expected[i] = CreateSample(i + 2000);
+        ASSERT_EQ(buffer.Get(i).velocity, expected[i].velocity);
+    }
+    AssertSamplesEqual(buffer, expected);
+}
+
+TEST(RideMeasurementBufferTest, drop_first_block)
+{
+    RideMeasurementBuffer buffer;
+    std::vector<RideMeasurementSample> expected;
+    for (size_t i = 0; i < TEST_SAMPLE_COUNT; i++)
+    {
+        buffer.Set(i, CreateSample(i));
+        expected.push_back(CreateSample(i));
+    }
+
+    buffer.DropFirstBlock();
+    expected.erase(expected.begin(), expected.begin() + RideMeasurementBuffer::SAMPLES_PER_BLOCK);
+    AssertSamplesEqual(buffer, expected);
+
+    // Keep writing after the drop
+    for (size_t i = 0; i < RideMeasurementBuffer::SAMPLES_PER_BLOCK; i++)
+    {
+        buffer.Set(expected.size(), CreateSample(i));
+        expected.push_back(CreateSample(i));
+    }
+    AssertSamplesEqual(buffer, expected);
+
+    buffer.Clear();
+    ASSERT_EQ(buffer.GetCount(), 0u);
+    ASSERT_EQ(buffer.GetEncodedSize(), 0u);
+}
@@ -0,0 +1,144 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/peep/Peep.h>
+#include <openrct2/platform/platform.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/world/Sprite.h>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+constexpr int32_t TEST_GUEST_COUNT = 6;
+
+class RideQueue : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        std::string path = TestData::GetParkPath("bpb.sv6");
+        load_from_sv6(path.c_str());
+    }
+
+    void TearDown() override
+    {
+        _context = nullptr;
+    }
+
+    // Walks the queue from the back like the game did before queues were indexed
+    static std::vector<uint16_t> WalkQueue(const Ride& ride, int32_t stationIndex)
+    {
+        std::vector<uint16_t> result;
+        for (uint16_t spriteIndex = ride.stations[stationIndex].LastPeepInQueue; spriteIndex != SPRITE_INDEX_NULL;
+             spriteIndex = get_sprite(spriteIndex)->peep.next_in_queue)
+        {
+            result.push_back(spriteIndex);
+            if (result.size() > MAX_SPRITES)
+                break;
+        }
+        return result;
+    }
+
+    // Checks the queue, given from back to front, against the walk and the indexed front and length
+    static void CheckQueue(const Ride& ride, int32_t stationIndex, const std::vector<Peep*>& expected)
+    {
+        std::vector<uint16_t> expectedIndices;
+        for (auto peep : expected)
+        {
+            expectedIndices.push_back(peep->sprite_index);
+        }
+        auto walked = WalkQueue(ride, stationIndex);
+        ASSERT_EQ(walked, expectedIndices);
+
+        const auto& station = ride.stations[stationIndex];
+        ASSERT_EQ(station.QueueLength, walked.size());
+        ASSERT_EQ(station.QueueGuestCount, walked.size());
+        if (walked.empty())
+        {
+            ASSERT_EQ(ride.GetQueueHeadGuest(stationIndex), nullptr);
+        }
+        else
+        {
+            ASSERT_EQ(ride.GetQueueHeadGuest(stationIndex), &get_sprite(walked.back())->peep);
+        }
+    }
+};
+
+TEST_F(RideQueue, indexed_queue_matches_walk)
+{
+    Ride* firstRide = nullptr;
+    for (auto& ride : GetRideManager())
+    {
+        firstRide = &ride;
+        break;
+    }
+    ASSERT_NE(firstRide, nullptr);
+    auto& ride = *firstRide;
+    constexpr int32_t stationIndex = 0;
+
+    std::vector<Peep*> guests;
+    for (int32_t i = 0; i < TEST_GUEST_COUNT; i++)
+    {
+        auto peep = Peep::Generate({ 16, 16, 16 });
+        ASSERT_NE(peep, nullptr);
+        guests.push_back(peep);
+    }
+
+    ride.QueueClear(stationIndex);
+    CheckQueue(ride, stationIndex, {});
+
+    // Guests join at the back, so the first guest is at the front
+    for (int32_t i = 0; i < TEST_GUEST_COUNT; i++)
+    {
+        ride.QueueInsertGuestAtBack(stationIndex, guests[i]);
+    }
+    CheckQueue(ride, stationIndex, { guests[5], guests[4], guests[3], guests[2], guests[1], guests[0] });
+
+    // Leave from the middle, the front and the back
+    ride.QueueRemoveGuest(stationIndex, guests[2]);
+    CheckQueue(ride, stationIndex, { guests[5], guests[4], guests[3], guests[1], guests[0] });
+    ride.QueueRemoveGuest(stationIndex, guests[0]);
+    CheckQueue(ride, stationIndex, { guests[5], guests[4], guests[3], guests[1] });
+    ride.QueueRemoveGuest(stationIndex, guests[5]);
+    CheckQueue(ride, stationIndex, { guests[4], guests[3], guests[1] });
+
+    // Rejoin at the front, then leave next to it so the guest behind is looked up through the index
+    ride.QueueInsertGuestAtFront(stationIndex, guests[0]);
+    CheckQueue(ride, stationIndex, { guests[4], guests[3], guests[1], guests[0] });
+    ride.QueueRemoveGuest(stationIndex, guests[1]);
+    CheckQueue(ride, stationIndex, { guests[4], guests[3], guests[0] });
+    ride.QueueRemoveGuest(stationIndex, guests[0]);
+    CheckQueue(ride, stationIndex, { guests[4], guests[3] });
+
+    // A cleared queue starts again from nothing
+    ride.QueueClear(stationIndex);
+    CheckQueue(ride, stationIndex, {});
+    ride.QueueInsertGuestAtBack(stationIndex, guests[3]);
+    ride.QueueInsertGuestAtBack(stationIndex, guests[2]);
+    CheckQueue(ride, stationIndex, { guests[2], guests[3] });
+    ride.QueueRemoveGuest(stationIndex, guests[3]);
+    CheckQueue(ride, stationIndex, { guests[2] });
+}
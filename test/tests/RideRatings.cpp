@@ -20,12 +20,38 @@
 #include <openrct2/platform/platform.h>
 #include <openrct2/ride/Ride.h>
 #include <string>
+#include <vector>
 
 using namespace OpenRCT2;
 
 class RideRatings : public testing::Test
 {
 protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        std::string path = TestData::GetParkPath("bpb.sv6");
+
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+
+        load_from_sv6(path.c_str());
+
+        // Check ride count to check load was successful
+        ASSERT_EQ(ride_get_count(), 134);
+    }
+
+    void TearDown() override
+    {
+        _context = nullptr;
+    }
+
     void CalculateRatingsForAllRides()
     {
         for (const auto& ride : GetRideManager())
@@ -51,39 +77,61 @@ protected:
             (int)ratings.nausea);
         return line;
     }
-};
 
-TEST_F(RideRatings, all)
-{
-    std::string path = TestData::GetParkPath("bpb.sv6");
-
-    gOpenRCT2Headless = true;
-    gOpenRCT2NoGraphics = true;
-
-    core_init();
-    auto context = CreateContext();
-    bool initialised = context->Initialise();
-    ASSERT_TRUE(initialised);
+    void CheckRatings()
+    {
+        // Load expected ratings
+        auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
+        auto expectedRatings = File::ReadAllLines(expectedDataPath);
 
-    load_from_sv6(path.c_str());
+        // Check ride ratings
+        int expI = 0;
+        for (const auto& ride : GetRideManager())
+        {
+            auto actual = FormatRatings(ride);
+            auto expected = expectedRatings[expI];
+            ASSERT_STREQ(actual.c_str(), expected.c_str());
 
-    // Check ride count to check load was successful
-    ASSERT_EQ(ride_get_count(), 134);
+            expI++;
+        }
+    }
+};
 
+TEST_F(RideRatings, all)
+{
     CalculateRatingsForAllRides();
+    CheckRatings();
+}
 
-    // Load expected ratings
-    auto expectedDataPath = Path::Combine(TestData::GetBasePath(), "ratings", "bpb.sv6.txt");
-    auto expectedRatings = File::ReadAllLines(expectedDataPath);
-
-    // Check ride ratings
-    int expI = 0;
+TEST_F(RideRatings, all_parallel)
+{
+    std::vector<ride_id_t> rideIds;
     for (const auto& ride : GetRideManager())
     {
-        auto actual = FormatRatings(ride);
-        auto expected = expectedRatings[expI];
-        ASSERT_STREQ(actual.c_str(), expected.c_str());
+        rideIds.push_back(ride.id);
+    }
+    ride_ratings_update_rides(rideIds);
+    CheckRatings();
+}
 
-        expI++;
+TEST_F(RideRatings, unrated_rides_at_batch_tick)
+{
+    // Tested rides without ratings are the ones the game rates in a batch
+    CalculateRatingsForAllRides();
+    int32_t numUnrated = 0;
+    for (auto& ride : GetRideManager())
+    {
+        if (ride.status != RIDE_STATUS_CLOSED && (ride.lifecycle_flags & RIDE_LIFECYCLE_TESTED))
+        {
+            ride.excitement = RIDE_RATING_UNDEFINED;
+            ride.intensity = RIDE_RATING_UNDEFINED;
+            ride.nausea = RIDE_RATING_UNDEFINED;
+            numUnrated++;
+        }
     }
+    ASSERT_GT(numUnrated, 0);
+
+    gCurrentTicks = 128 * 100;
+    ride_ratings_update_all();
+    CheckRatings();
 }
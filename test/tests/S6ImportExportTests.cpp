@@ -25,15 +25,58 @@
 #include <openrct2/network/network.h>
 #include <openrct2/object/ObjectManager.h>
 #include <openrct2/platform/platform.h>
+#include <openrct2/rct2/RCT2.h>
 #include <openrct2/rct2/S6Exporter.h>
 #include <openrct2/ride/Ride.h>
 #include <openrct2/world/Park.h>
 #include <openrct2/world/Sprite.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
 #include <stdio.h>
 #include <string>
 
 using namespace OpenRCT2;
 
+// Live heap memory, counted by the replacement operator new and delete below so that the real peak memory of a park load
+// can be measured
+static std::atomic<size_t> _allocatedBytes;
+static std::atomic<size_t> _peakAllocatedBytes;
+constexpr size_t AllocationHeaderSize = alignof(std::max_align_t);
+
+void* operator new(size_t size)
+{
+    auto block = static_cast<uint8_t*>(std::malloc(size + AllocationHeaderSize));
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t*>(block) = size;
+
+    auto allocated = _allocatedBytes.fetch_add(size) + size;
+    auto peak = _peakAllocatedBytes.load();
+    while (allocated > peak && !_peakAllocatedBytes.compare_exchange_weak(peak, allocated))
+    {
+    }
+    return block + AllocationHeaderSize;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if (ptr != nullptr)
+    {
+        auto block = static_cast<uint8_t*>(ptr) - AllocationHeaderSize;
+        _allocatedBytes -= *reinterpret_cast<size_t*>(block);
+        std::free(block);
+    }
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    operator delete(ptr);
+}
+
 struct GameState_t
 {
     rct_sprite sprites[MAX_SPRITES];
@@ -567,3 +610,42 @@ TEST(S6ImportExportAdvanceTicks, all)
 
     SUCCEED();
 }
+
+TEST(S6ImportExportPeakMemory, all)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    core_init();
+
+    std::unique_ptr<IContext> context = CreateContext();
+    EXPECT_NE(context, nullptr);
+
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    // The importer holds one copy of the park. Chunks are decoded straight into it, so on top of that only the streaming
+    // buffers and a few small allocations should be needed, rather than a temporary copy of every decoded chunk.
+    constexpr size_t MaxLoadOverhead = 512 * 1024;
+    for (const char* parkName : { "bpb.sv6", "pathfinding-tests.sv6", "tile-element-tests.sv6", "BigMapTest.sv6" })
+    {
+        MemoryStream importBuffer;
+        ASSERT_TRUE(LoadFileToBuffer(importBuffer, TestData::GetParkPath(parkName)));
+        importBuffer.SetPosition(0);
+
+        size_t allocatedBefore = _allocatedBytes;
+        _peakAllocatedBytes = allocatedBefore;
+        auto importer = ParkImporter::CreateS6(context->GetObjectRepository());
+        importer->LoadFromStream(&importBuffer, false);
+        size_t peakLoadMemory = _peakAllocatedBytes - allocatedBefore;
+
+        EXPECT_GE(peakLoadMemory, sizeof(rct_s6_data)) << parkName;
+        EXPECT_LE(peakLoadMemory, sizeof(rct_s6_data) + MaxLoadOverhead) << parkName;
+
+        // The reader's own count only covers its buffers, which are part of the measured peak
+        EXPECT_GT(importer->GetPeakLoadMemory(), 0u) << parkName;
+        EXPECT_LE(importer->GetPeakLoadMemory(), peakLoadMemory - sizeof(rct_s6_data)) << parkName;
+    }
+
+    SUCCEED();
+}
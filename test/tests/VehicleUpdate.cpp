@@ -0,0 +1,96 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2019 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/core/String.hpp>
+#include <openrct2/platform/platform.h>
+#include <openrct2/ride/Ride.h>
+#include <openrct2/ride/Vehicle.h>
+#include <openrct2/scenario/Scenario.h>
+#include <openrct2/world/Sprite.h>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2;
+
+constexpr int32_t TEST_TICK_COUNT = 2000;
+
+class VehicleUpdate : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> _context;
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        core_init();
+        _context = CreateContext();
+        bool initialised = _context->Initialise();
+        ASSERT_TRUE(initialised);
+    }
+
+    void TearDown() override
+    {
+        _context = nullptr;
+    }
+
+    static void LoadPark()
+    {
+        std::string path = TestData::GetParkPath("bpb.sv6");
+        load_from_sv6(path.c_str());
+        scenario_rand_seed(0x12345678, 0x87654321);
+    }
+
+    static std::string GetStateChecksum()
+    {
+        auto checksum = sprite_checksum().ToString();
+        const auto& randState = scenario_rand_state();
+        return String::StdFormat("%s %08X %08X", checksum.c_str(), randState.s0, randState.s1);
+    }
+
+    // Walks the vehicle list like the game did before the ride lookup was shared between trains
+    static void UpdateTrainsSerially()
+    {
+        uint16_t spriteIndex = gSpriteListHead[SPRITE_LIST_VEHICLE_HEAD];
+        while (spriteIndex != SPRITE_INDEX_NULL)
+        {
+            rct_vehicle* vehicle = GET_VEHICLE(spriteIndex);
+            spriteIndex = vehicle->next;
+            vehicle_update(vehicle, get_ride(vehicle->ride));
+        }
+    }
+};
+
+TEST_F(VehicleUpdate, update_all_matches_serial_reference)
+{
+    LoadPark();
+    ASSERT_NE(gSpriteListHead[SPRITE_LIST_VEHICLE_HEAD], SPRITE_INDEX_NULL);
+    std::vector<std::string> expected;
+    for (int32_t i = 0; i < TEST_TICK_COUNT; i++)
+    {
+        UpdateTrainsSerially();
+        expected.push_back(GetStateChecksum());
+    }
+    // The trains have to move, otherwise the checksums below do not prove anything
+    ASSERT_NE(expected.front(), expected.back());
+
+    LoadPark();
+    for (int32_t i = 0; i < TEST_TICK_COUNT; i++)
+    {
+        vehicle_update_all();
+        ASSERT_EQ(GetStateChecksum(), expected[i]) << "tick " << i;
+    }
+}
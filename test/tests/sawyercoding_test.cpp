@@ -11,9 +11,16 @@
 #include <openrct2/core/MemoryStream.h>
 #include <openrct2/rct12/SawyerChunkReader.h>
 #include <openrct2/util/SawyerCoding.h>
+#include <openrct2/util/Util.h>
+#include <algorithm>
+#include <random>
+#include <vector>
 
 constexpr size_t BUFFER_SIZE = 0x600000;
 
+// Lengths either side of the 16 byte vector width used by the SSE 4.1 kernels
+static const size_t KernelTestLengths[] = { 0, 1, 2, 3, 15, 16, 17, 31, 32, 33, 63, 64, 65, 125, 126, 127, 128, 129, 1000 };
+
 class SawyerCodingTest : public testing::Test
 {
 protected:
@@ -59,6 +66,80 @@ protected:
         auto result = memcmp(chunk->GetData(), randomdata, sizeof(randomdata));
         ASSERT_EQ(result, 0);
     }
+
+    void test_read_partial(uint8_t encoding_type)
+    {
+        // Short random sequences, runs of one byte and copies of data up to 32 bytes back, so the chunk has repeat
+        // encoded data referring back across any offset
+        std::mt19937 rng(0x39);
+        std::vector<uint8_t> data;
+        while (data.size() < 2048)
+        {
+            size_t length = 1 + rng() % 8;
+            switch (rng() % 3)
+            {
+                case 0:
+                    for (size_t i = 0; i < length; i++)
+                        data.push_back((uint8_t)rng());
+                    break;
+                case 1:
+                    data.insert(data.end(), length * 4, (uint8_t)rng());
+                    break;
+                default:
+                {
+                    size_t distance = 1 + rng() % std::min<size_t>(32, std::max<size_t>(1, data.size()));
+                    for (size_t i = 0; i < length && distance <= data.size(); i++)
+                        data.push_back(data[data.size() - distance]);
+                    break;
+                }
+            }
+        }
+
+        // A second chunk after the first checks that partial reads leave the stream at the end of the chunk
+        std::vector<uint8_t> encoded(BUFFER_SIZE);
+        sawyercoding_chunk_header chdr_in;
+        chdr_in.encoding = encoding_type;
+        chdr_in.length = (uint32_t)data.size();
+        size_t encodedSize = sawyercoding_write_chunk_buffer(encoded.data(), data.data(), chdr_in);
+        chdr_in.length = sizeof(randomdata);
+        encodedSize += sawyercoding_write_chunk_buffer(encoded.data() + encodedSize, randomdata, chdr_in);
+
+        MemoryStream ms(encoded.data(), encodedSize);
+        SawyerChunkReader reader(&ms);
+        auto chunk = reader.ReadChunk();
+        ASSERT_EQ(chunk->GetLength(), data.size());
+        ASSERT_EQ(memcmp(chunk->GetData(), data.data(), data.size()), 0);
+
+        std::vector<size_t> offsets;
+        for (size_t offset = 0; offset < 100; offset++)
+        {
+            offsets.push_back(offset);
+        }
+        for (size_t offset : { data.size() / 2 + 1, data.size() - 5, data.size() - 1, data.size(), data.size() + 3 })
+        {
+            offsets.push_back(offset);
+        }
+        for (size_t offset : offsets)
+        {
+            for (size_t length : { (size_t)1, (size_t)3, (size_t)4, (size_t)7, (size_t)33, (size_t)100, data.size() })
+            {
+                ms.SetPosition(0);
+                std::vector<uint8_t> dst(length, 0xCC);
+                size_t decodedLength = reader.ReadChunkPartial(dst.data(), offset, length);
+
+                size_t expectedLength = offset < data.size() ? std::min(length, data.size() - offset) : 0;
+                ASSERT_EQ(decodedLength, expectedLength) << "offset " << offset << " length " << length;
+                ASSERT_TRUE(std::equal(dst.begin(), dst.begin() + expectedLength, data.begin() + offset))
+                    << "offset " << offset << " length " << length;
+                ASSERT_TRUE(std::all_of(dst.begin() + expectedLength, dst.end(), [](uint8_t b) { return b == 0; }))
+                    << "offset " << offset << " length " << length;
+
+                auto next = reader.ReadChunk();
+                ASSERT_EQ(next->GetLength(), sizeof(randomdata));
+                ASSERT_EQ(memcmp(next->GetData(), randomdata, sizeof(randomdata)), 0);
+            }
+        }
+    }
 };
 
 TEST_F(SawyerCodingTest, write_read_chunk_none)
@@ -81,6 +162,26 @@ TEST_F(SawyerCodingTest, write_read_chunk_rotate)
     test_encode_decode(CHUNK_ENCODING_ROTATE);
 }
 
+TEST_F(SawyerCodingTest, read_chunk_partial_none)
+{
+    test_read_partial(CHUNK_ENCODING_NONE);
+}
+
+TEST_F(SawyerCodingTest, read_chunk_partial_rle)
+{
+    test_read_partial(CHUNK_ENCODING_RLE);
+}
+
+TEST_F(SawyerCodingTest, read_chunk_partial_rle_compressed)
+{
+    test_read_partial(CHUNK_ENCODING_RLECOMPRESSED);
+}
+
+TEST_F(SawyerCodingTest, read_chunk_partial_rotate)
+{
+    test_read_partial(CHUNK_ENCODING_ROTATE);
+}
+
 // Note we only check if provided data decompresses to the same data, not if it compresses the same.
 // The reason for that is we may improve encoding at some point, but the test won't be affected,
 // as we already do a decode test and rountrip (encode + decode), which validates all uses.
@@ -106,6 +207,55 @@ TEST_F(SawyerCodingTest, decode_chunk_rotate)
     test_decode(rotatedata, sizeof(rotatedata));
 }
 
+TEST_F(SawyerCodingTest, sse4_1_kernels_match_scalar)
+{
+    if (!sse41_available())
+    {
+        return;
+    }
+
+    std::mt19937 rng(0x5A3E);
+    for (int32_t alphabet : { 256, 4, 2, 1 })
+    {
+        std::uniform_int_distribution<int32_t> dist(0, alphabet - 1);
+        for (size_t length : KernelTestLengths)
+        {
+            // The literal counter reads one byte past max
+            std::vector<uint8_t> src(length + 1);
+            for (auto& b : src)
+            {
+                b = (uint8_t)dist(rng);
+            }
+
+            for (size_t offset = 0; offset < length; offset++)
+            {
+                size_t max = length - offset;
+                ASSERT_EQ(
+                    sawyercoding_rle_count_literals_sse4_1(src.data() + offset, max),
+                    sawyercoding_rle_count_literals_scalar(src.data() + offset, max))
+                    << "alphabet " << alphabet << " length " << length << " offset " << offset;
+                ASSERT_EQ(
+                    sawyercoding_rle_count_run_sse4_1(src.data() + offset, max),
+                    sawyercoding_rle_count_run_scalar(src.data() + offset, max))
+                    << "alphabet " << alphabet << " length " << length << " offset " << offset;
+            }
+
+            ASSERT_EQ(
+                sawyercoding_calculate_checksum_sse4_1(src.data(), length),
+                sawyercoding_calculate_checksum_scalar(src.data(), length));
+
+            for (bool encode : { true, false })
+            {
+                std::vector<uint8_t> expected(length);
+                std::vector<uint8_t> actual(length);
+                sawyercoding_rotate_scalar(expected.data(), src.data(), length, encode);
+                sawyercoding_rotate_sse4_1(actual.data(), src.data(), length, encode);
+                ASSERT_EQ(actual, expected) << "length " << length;
+            }
+        }
+    }
+}
+
 // 1024 bytes of random data
 // use `dd if=/dev/urandom bs=1024 count=1 | xxd -i` to get your own
 const uint8_t SawyerCodingTest::randomdata[] = {